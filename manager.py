@@ -533,8 +533,8 @@ def createNode(request: Request):
         if createContainer(name, j["type"]):
             graph.add_node(name, editable=True, scalable=True, addresses=getContainerIPAddresses(name),
                            **copy.deepcopy(node_default_attrs), **copy.deepcopy(specific_node_default_attrs[j["type"]]))
-            if j["type"] == "NR":
-                resp = yield modules_socket.editConfig(name, {"manager_address": "172.19.0.1", "manager_port": 9999})
+            # where the modules send their reports, face congestion included
+            resp = yield modules_socket.editConfig(name, {"manager_address": "172.19.0.1", "manager_port": 9999})
             if j["type"] == "SV":
                 addKeysToSV(name)
                 return name + " test"
@@ -23,13 +23,16 @@ class BackwardRouter : public Module {
     char _command_buffer[65536];
     boost::asio::ip::udp::socket _command_socket;
     boost::asio::ip::udp::endpoint _remote_command_endpoint;
+    boost::asio::ip::udp::endpoint _manager_endpoint;
 
     std::vector<std::shared_ptr<Face>> _egress_faces;
     std::shared_ptr<MasterFace> _tcp_ingress_master_face;
     std::shared_ptr<MasterFace> _udp_ingress_master_face;
+    std::shared_ptr<MasterFace> _unix_ingress_master_face;
+    std::shared_ptr<MasterFace> _shm_ingress_master_face;
 
 public:
-    BackwardRouter(const std::string &name, size_t max_size, uint16_t local_port, uint16_t local_command_port);
+    BackwardRouter(const std::string &name, size_t max_size, uint16_t local_port, uint16_t local_command_port, size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION);
 
     ~BackwardRouter() override = default;
 
@@ -49,6 +52,8 @@ public:
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
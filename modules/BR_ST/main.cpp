@@ -14,6 +14,7 @@ int main(int argc, char *argv[]) {
     size_t size = 0;
     uint16_t local_port = 0;
     uint16_t local_command_port = 0;
+    size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION;
 
     char flags = 0;
     for (int i = 1; i < argc; i += 2) {
@@ -34,6 +35,10 @@ int main(int argc, char *argv[]) {
                 local_command_port = std::atoi(argv[i + 1]);
                 flags |= 0x8;
                 break;
+            case 'm':
+                // optional, faces accepted per master face
+                max_connection = std::atoi(argv[i + 1]);
+                break;
             case 'h':
             default:
                 exit(0);
@@ -50,7 +55,7 @@ int main(int argc, char *argv[]) {
     logger::isTee(true);
     logger::setMinimalLogLevel(logger::INFO);
 
-    BackwardRouter backward_router(name, size, local_port, local_command_port);
+    BackwardRouter backward_router(name, size, local_port, local_command_port, max_connection);
     backward_router.start();
 
     signal(SIGINT, signal_handler);
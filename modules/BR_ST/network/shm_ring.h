@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Single producer single consumer ring of packets in a memory region shared by two processes. A packet is stored as
+// its size on 4 bytes followed by its bytes, padded to 8 bytes. The consumer flags itself as waiting before sleeping
+// on its eventfd, so the producer only makes the wakeup syscall when the consumer actually sleeps.
+class ShmRing {
+public:
+    static const size_t CAPACITY = 1 << 22;
+
+    struct Header {
+        alignas(64) std::atomic<uint64_t> head;
+        alignas(64) std::atomic<uint64_t> tail;
+        alignas(64) std::atomic<uint32_t> waiting;
+    };
+
+    static const size_t REGION_SIZE = sizeof(Header) + CAPACITY;
+
+    using Callback = std::function<void(const uint8_t*, size_t)>;
+
+private:
+    static const uint32_t WRAP_MARKER = UINT32_MAX;
+
+    Header *_header;
+    uint8_t *_data;
+    bool _is_corrupted = false;
+
+public:
+    // the region must be REGION_SIZE bytes long and zeroed by its creator
+    explicit ShmRing(void *region);
+
+    ~ShmRing() = default;
+
+    bool empty() const;
+
+    // producer side, false if the ring is full
+    bool push(const uint8_t *packet, size_t size);
+
+    // producer side, true if the consumer sleeps and must be woken up after a push
+    bool needsWakeup();
+
+    // consumer side, pops up to max_packets packets and returns how many were popped. The peer writes the sizes and
+    // the tail, a record that doesn't fit the ring stops the ring for good, see isCorrupted()
+    size_t pop(const Callback &callback, size_t max_packets);
+
+    bool isCorrupted() const;
+
+    // consumer side, false if packets arrived in the meantime and the consumer must not sleep
+    bool prepareWait();
+};
\ No newline at end of file
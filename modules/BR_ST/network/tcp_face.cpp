@@ -12,6 +12,7 @@ TcpFace::TcpFace(boost::asio::io_service &ios, std::string host, uint16_t port)
         , _endpoint(boost::asio::ip::address::from_string(host), port)
         , _socket(ios)
         , _strand(ios)
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
         , _timer(ios) {
 }
 
@@ -21,6 +22,7 @@ TcpFace::TcpFace(boost::asio::io_service &ios, const boost::asio::ip::tcp::endpo
         , _endpoint(endpoint)
         , _socket(ios)
         , _strand(ios)
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
         , _timer(ios) {
 }
 
@@ -30,10 +32,19 @@ TcpFace::TcpFace(boost::asio::ip::tcp::socket &&socket)
         , _endpoint(socket.remote_endpoint())
         , _socket(std::move(socket))
         , _strand(socket.get_io_service())
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
         , _timer(socket.get_io_service()) {
 
 }
 
+void TcpFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats TcpFace::getTxQueueStats() const {
+    return _queue.getStats();
+}
+
 std::string TcpFace::getUnderlyingProtocol() const {
     return "TCP";
 }
@@ -129,90 +140,31 @@ void TcpFace::reconnectHandler(const boost::system::error_code &err, size_t rema
 }
 
 void TcpFace::read() {
-    boost::asio::async_read(_socket, boost::asio::buffer(_buffer + _buffer_size, BUFFER_SIZE - _buffer_size),
+    char *buffer = _framer.prepare();
+    boost::asio::async_read(_socket, boost::asio::buffer(buffer, _framer.getFreeSize()),
                             boost::asio::transfer_at_least(1),
                             boost::bind(&TcpFace::readHandler, shared_from_this(), _1, _2));
 }
 
 void TcpFace::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
     if(!err) {
-        _buffer_size += bytes_transferred;
-        char *current = _buffer;
-        char *end = _buffer + _buffer_size;
-        while (current < end) {
-            if ((uint8_t)current[0] == 0x5 || (uint8_t)current[0] == 0x6 /*|| (uint8_t)current[0] == 0x64*/) {
-                //check length
-                uint64_t size = 0;
-                switch ((uint8_t)current[1]) {
-                    default:
-                        size += (uint8_t)current[1];
-                        size += 2;
+        _framer.commit(bytes_transferred);
+        _framer.extract([this](const char *packet, size_t size) {
+            try {
+                switch (packet[0]) {
+                    case 0x05:
+                        _interest_callback(shared_from_this(), ndn::Interest(ndn::Block((uint8_t*)packet, size)));
                         break;
-                    case 0xFD:
-                        size += (uint8_t)current[2];
-                        size <<= 8;
-                        size += (uint8_t)current[3];
-                        size += 4;
+                    case 0x06:
+                        _data_callback(shared_from_this(), ndn::Data(ndn::Block((uint8_t*)packet, size)));
                         break;
-                    case 0xFE:
-                        size += (uint8_t)current[2];
-                        size <<= 8;
-                        size += (uint8_t)current[3];
-                        size <<= 8;
-                        size += (uint8_t)current[4];
-                        size <<= 8;
-                        size += (uint8_t)current[5];
-                        size += 6;
-                        break;
-                    case 0xFF:
-                        size += (uint8_t)current[2];
-                        size <<= 8;
-                        size += (uint8_t)current[3];
-                        size <<= 8;
-                        size += (uint8_t)current[4];
-                        size <<= 8;
-                        size += (uint8_t)current[5];
-                        size <<= 8;
-                        size += (uint8_t)current[6];
-                        size <<= 8;
-                        size += (uint8_t)current[7];
-                        size <<= 8;
-                        size += (uint8_t)current[8];
-                        size <<= 8;
-                        size += (uint8_t)current[9];
-                        size += 10;
+                    default:
                         break;
                 }
-                if (size > NDN_MAX_PACKET_SIZE) {
-                    ++current;
-                } else if (size <= end - current) {
-                    try {
-                        switch (current[0]) {
-                            case 0x05:
-                                _interest_callback(shared_from_this(), ndn::Interest(ndn::Block((uint8_t*)current, size)));
-                                break;
-                            case 0x06:
-                                _data_callback(shared_from_this(), ndn::Data(ndn::Block((uint8_t*)current, size)));
-                                break;
-                            //case 0x64:
-                                //Lp packets are not supported yet
-                                //break;
-                            default:
-                                break;
-                        }
-                    } catch (const std::exception &e) {
-                        std::cerr << e.what() << std::endl;
-                    }
-                    current += size;
-                } else {
-                    break;
-                }
-            } else {
-                ++current;
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
             }
-        }
-        _buffer_size = end - current;
-        std::copy(current, end, _buffer);
+        });
         read();
     } else {
         if(!_skip_connect && _is_connected) {
@@ -227,8 +179,11 @@ void TcpFace::readHandler(const boost::system::error_code &err, size_t bytes_tra
 }
 
 void TcpFace::sendImpl(std::shared_ptr<const ndn::Buffer> &buffer) {
-    _queue.push_back(std::move(buffer));
-    if (_queue_in_use) {
+    size_t size = buffer->size();
+    bool is_data = size > 0 && (*buffer)[0] == 0x06;
+    _queue.push(std::move(buffer), size, is_data);
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (_queue_in_use || _queue.empty()) {
         return;
     }
 
@@ -237,13 +192,15 @@ void TcpFace::sendImpl(std::shared_ptr<const ndn::Buffer> &buffer) {
 }
 
 void TcpFace::write() {
+    _queue.markInFlight(1);
     boost::asio::async_write(_socket, boost::asio::buffer(*_queue.front()),
                              _strand.wrap(boost::bind(&TcpFace::writeHandler, shared_from_this(), _1, _2)));
 }
 
 void TcpFace::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
     if(!err) {
-        _queue.pop_front();
+        _queue.pop();
+        updateCongestion(shared_from_this(), _queue.isCongested());
 
         if (!_queue.empty()) {
             write();
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "concurrency.h"
 #include "face.h"
+#include "lp_fragmenter.h"
+#include "lp_reassembler.h"
 
 #include <boost/asio.hpp>
 
@@ -13,17 +16,27 @@
 class UdpFace : public Face, public std::enable_shared_from_this<UdpFace> {
 public:
     static const size_t BUFFER_SIZE = 1 << 16;
+    static const size_t MAX_AGGREGATED_PACKETS = 64;
 
 private:
     boost::asio::ip::udp::endpoint _endpoint;
     boost::asio::ip::udp::endpoint _remote_endpoint;
     boost::asio::ip::udp::socket _socket;
-    boost::asio::strand _strand;
+    Strand _strand;
     char _buffer[BUFFER_SIZE];
-    std::deque<std::shared_ptr<const ndn::Buffer>> _queue;
+    TxQueue<std::shared_ptr<const ndn::Buffer>> _queue;
+    LpFragmenter _fragmenter;
+    LpReassembler _reassembler;
+    bool _is_writing = false;
+    std::vector<boost::asio::const_buffer> _write_buffers;
 
     boost::asio::deadline_timer _timer;
 
+    bool _aggregation = false;
+    boost::posix_time::time_duration _aggregation_delay;
+    bool _is_flush_pending = false;
+    boost::asio::deadline_timer _flush_timer;
+
 public:
     // use these when creating a face yourself
     UdpFace(boost::asio::io_service &ios, const std::string &host, uint16_t port);
@@ -32,10 +45,21 @@ public:
 
     ~UdpFace() override = default;
 
+    void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+    TxQueueStats getTxQueueStats() const override;
+
     std::string getUnderlyingProtocol() const override;
 
     std::string getUnderlyingEndpoint() const override;
 
+    // packets larger than the MTU are sent as NDNLPv2 fragments, 0 disables the fragmentation
+    void setMtu(size_t mtu);
+
+    // the queued packets leave several per datagram up to the MTU, a packet queued on an idle face waits up to delay
+    // for others to join it. Must be called before the face is opened
+    void setAggregation(bool enabled, const boost::posix_time::time_duration &delay = boost::posix_time::time_duration());
+
     void open(const InterestCallback &interest_callback, const DataCallback &data_callback, const ErrorCallback &error_callback) override;
 
     void close() override;
@@ -53,6 +77,10 @@ private:
 
     void sendImpl(std::shared_ptr<const ndn::Buffer> &buffer);
 
+    void flush();
+
+    void flushHandler(const boost::system::error_code &err);
+
     void write();
 
     void writeHandler(const boost::system::error_code &err, size_t bytesTransferred);
@@ -0,0 +1,111 @@
+#include "unix_master_face.h"
+
+#include <boost/bind.hpp>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../log/logger.h"
+
+const std::string UnixMasterFace::RUNTIME_DIRECTORY = "/run/ndn";
+
+UnixMasterFace::UnixMasterFace(boost::asio::io_service &ios, size_t max_connection, const std::string &path)
+        : MasterFace(ios, max_connection)
+        , _path(path)
+        , _socket(ios)
+        , _acceptor(ios) {
+
+}
+
+std::string UnixMasterFace::getSocketPath(const std::string &name) {
+    return RUNTIME_DIRECTORY + "/" + name + ".sock";
+}
+
+std::string UnixMasterFace::getUnderlyingProtocol() const {
+    return "UNIX";
+}
+
+void UnixMasterFace::listen(const NotificationCallback &notification_callback, const Face::InterestCallback &interest_callback,
+                            const Face::DataCallback &data_callback, const ErrorCallback &error_callback) {
+    _notification_callback = notification_callback;
+    _interest_callback = interest_callback;
+    _data_callback = data_callback;
+    _error_callback = error_callback;
+    // a socket left by a previous run of the module would make bind fail
+    ::mkdir(RUNTIME_DIRECTORY.c_str(), 0700);
+    ::unlink(_path.c_str());
+    boost::system::error_code err;
+    _acceptor.open(boost::asio::local::stream_protocol(), err);
+    if (!err) {
+        _acceptor.bind(boost::asio::local::stream_protocol::endpoint(_path), err);
+    }
+    if (!err) {
+        _acceptor.listen(16, err);
+    }
+    std::stringstream ss;
+    if (err) {
+        ss << "master face with ID = " << _master_face_id << " cannot listen on unix://" << _path << ": " << err.message();
+        logger::log(logger::WARNING, ss.str());
+        return;
+    }
+    ss << "master face with ID = " << _master_face_id << " listening on unix://" << _path;
+    logger::log(logger::INFO, ss.str());
+    accept();
+}
+
+void UnixMasterFace::close() {
+    if (_acceptor.is_open()) {
+        _acceptor.close();
+        ::unlink(_path.c_str());
+    }
+    for(const auto &face : _faces) {
+        face->close();
+    }
+}
+
+void UnixMasterFace::sendToAllFaces(const std::string &message) {
+    for(const auto &face : _faces) {
+        face->send(message);
+    }
+}
+
+void UnixMasterFace::sendToAllFaces(const ndn::Interest &interest) {
+    for(const auto &face : _faces) {
+        face->send(interest);
+    }
+}
+
+void UnixMasterFace::sendToAllFaces(const ndn::Data &data) {
+    for(const auto &face : _faces) {
+        face->send(data);
+    }
+}
+
+void UnixMasterFace::accept() {
+    _acceptor.async_accept(_socket, boost::bind(&UnixMasterFace::acceptHandler, shared_from_this(), _1));
+}
+
+void UnixMasterFace::acceptHandler(const boost::system::error_code &err) {
+    if(!err) {
+        if(_faces.size() < _max_connection) {
+            std::stringstream ss;
+            ss << "new connection on unix://" << _path;
+            logger::log(logger::INFO, ss.str());
+            auto face = std::make_shared<UnixFace>(std::move(_socket));
+            prepareFace(face);
+            _faces.emplace(face);
+            _notification_callback(shared_from_this(), face);
+            face->open(_interest_callback, _data_callback, boost::bind(&UnixMasterFace::onFaceError, shared_from_this(), _1));
+        } else {
+            _socket.close();
+        }
+        accept();
+    } else if (err != boost::asio::error::operation_aborted) {
+        std::cerr << err.message() << std::endl;
+    }
+}
+
+void UnixMasterFace::onFaceError(const std::shared_ptr<Face> &face) {
+    _faces.erase(face);
+    _error_callback(shared_from_this(), face);
+}
\ No newline at end of file
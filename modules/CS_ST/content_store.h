@@ -36,9 +36,11 @@ class ContentStore : public Module {
     std::vector<std::shared_ptr<Face>> _egress_faces;
     std::shared_ptr<MasterFace> _tcp_ingress_master_face;
     std::shared_ptr<MasterFace> _udp_ingress_master_face;
+    std::shared_ptr<MasterFace> _unix_ingress_master_face;
+    std::shared_ptr<MasterFace> _shm_ingress_master_face;
 
 public:
-    ContentStore(const std::string &name, size_t size, uint16_t local_port, uint16_t local_command_port);
+    ContentStore(const std::string &name, size_t size, uint16_t local_port, uint16_t local_command_port, size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION);
 
     ~ContentStore() override = default;
 
@@ -58,6 +60,8 @@ public:
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
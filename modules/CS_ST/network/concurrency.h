@@ -0,0 +1,108 @@
+#pragma once
+
+#include <boost/asio.hpp>
+
+#include <atomic>
+#include <utility>
+
+// Concurrency policy of the faces, chosen when the module is built. By default the io_service of a module may be run
+// by several threads: each face serializes its handlers on a strand and the values read from other threads are
+// atomics. A module built with NDN_SINGLE_THREADED runs its io_service on a single thread, the other threads it may
+// have only post to it. A strand is then the io_service itself, a send from the io thread calls the face directly and
+// the atomics are plain values.
+#ifdef NDN_SINGLE_THREADED
+
+class Strand {
+private:
+    boost::asio::io_service &_ios;
+
+public:
+    explicit Strand(boost::asio::io_service &ios) : _ios(ios) {
+
+    }
+
+    boost::asio::io_service& get_io_service() {
+        return _ios;
+    }
+
+    // runs handler right away on the io thread, posts it from any other thread
+    template<typename Handler>
+    void dispatch(Handler &&handler) {
+        _ios.dispatch(std::forward<Handler>(handler));
+    }
+
+    template<typename Handler>
+    void post(Handler &&handler) {
+        _ios.post(std::forward<Handler>(handler));
+    }
+
+    // nothing to serialize, the handlers all run on the io thread
+    template<typename Handler>
+    Handler wrap(Handler handler) {
+        return handler;
+    }
+};
+
+// the subset of std::atomic used by the faces, without any synchronization
+template<typename T>
+class Atomic {
+private:
+    T _value;
+
+public:
+    Atomic() = default;
+
+    constexpr Atomic(T value) : _value(value) {
+
+    }
+
+    Atomic(const Atomic&) = delete;
+
+    Atomic& operator=(const Atomic&) = delete;
+
+    T load(std::memory_order = std::memory_order_seq_cst) const {
+        return _value;
+    }
+
+    void store(T value, std::memory_order = std::memory_order_seq_cst) {
+        _value = value;
+    }
+
+    T exchange(T value, std::memory_order = std::memory_order_seq_cst) {
+        std::swap(_value, value);
+        return value;
+    }
+
+    operator T() const {
+        return _value;
+    }
+
+    T operator=(T value) {
+        return _value = value;
+    }
+
+    T operator++() {
+        return ++_value;
+    }
+
+    T operator--() {
+        return --_value;
+    }
+
+    T operator+=(T value) {
+        return _value += value;
+    }
+
+    T operator-=(T value) {
+        return _value -= value;
+    }
+};
+
+#else
+
+using Strand = boost::asio::strand;
+
+template<typename T>
+using Atomic = std::atomic<T>;
+
+#endif
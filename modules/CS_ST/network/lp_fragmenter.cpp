@@ -0,0 +1,76 @@
+#include "lp_fragmenter.h"
+
+#include <cstring>
+#include <random>
+
+LpFragmenter::LpFragmenter(size_t mtu)
+        : _mtu(0)
+        , _sequence(std::random_device()()) {
+    setMtu(mtu);
+}
+
+size_t LpFragmenter::getMtu() const {
+    return _mtu.load(std::memory_order_relaxed);
+}
+
+size_t LpFragmenter::getDatagramSize() const {
+    size_t mtu = _mtu.load(std::memory_order_relaxed);
+    return mtu == 0 ? MAX_MTU : mtu;
+}
+
+bool LpFragmenter::canAggregate(const char *packet, size_t size) {
+    return size > 0 && (packet[0] == 0x05 || packet[0] == 0x06 || packet[0] == 0x64);
+}
+
+void LpFragmenter::setMtu(size_t mtu) {
+    _mtu.store(mtu == 0 ? 0 : std::min(std::max(mtu, (size_t)MIN_MTU), (size_t)MAX_MTU), std::memory_order_relaxed);
+}
+
+size_t LpFragmenter::encode(const char *payload, size_t size, size_t index, size_t count) {
+    // FragIndex and FragCount fit in 2 bytes since a fragment carries at least MIN_MTU - MAX_HEADER_SIZE bytes
+    size_t length = 10 + (index <= UINT8_MAX ? 3 : 4) + (count <= UINT8_MAX ? 3 : 4) + 1 + varNumberSize(size) + size;
+    _fragment.resize(1 + varNumberSize(length) + length);
+    char *it = _fragment.data();
+    *it++ = 0x64;
+    it = writeVarNumber(it, length);
+    uint64_t sequence = _sequence + index;
+    *it++ = 0x51;
+    *it++ = 8;
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        *it++ = (char)(sequence >> shift);
+    }
+    it = writeNonNegativeInteger(it, 0x52, index);
+    it = writeNonNegativeInteger(it, 0x53, count);
+    *it++ = 0x50;
+    it = writeVarNumber(it, size);
+    std::memcpy(it, payload, size);
+    return _fragment.size();
+}
+
+size_t LpFragmenter::varNumberSize(uint64_t number) {
+    return number < 253 ? 1 : 3;
+}
+
+char* LpFragmenter::writeVarNumber(char *it, uint64_t number) {
+    if (number < 253) {
+        *it++ = (char)number;
+    } else {
+        *it++ = (char)0xFD;
+        *it++ = (char)(number >> 8);
+        *it++ = (char)number;
+    }
+    return it;
+}
+
+char* LpFragmenter::writeNonNegativeInteger(char *it, uint8_t type, uint64_t number) {
+    *it++ = (char)type;
+    if (number <= UINT8_MAX) {
+        *it++ = 1;
+        *it++ = (char)number;
+    } else {
+        *it++ = 2;
+        *it++ = (char)(number >> 8);
+        *it++ = (char)number;
+    }
+    return it;
+}
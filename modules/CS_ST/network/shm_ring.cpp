@@ -0,0 +1,88 @@
+#include "shm_ring.h"
+
+#include <cstring>
+
+ShmRing::ShmRing(void *region) : _header((Header*)region), _data((uint8_t*)region + sizeof(Header)) {
+
+}
+
+bool ShmRing::empty() const {
+    return _header->head.load(std::memory_order_acquire) == _header->tail.load(std::memory_order_acquire);
+}
+
+bool ShmRing::push(const uint8_t *packet, size_t size) {
+    size_t record = (sizeof(uint32_t) + size + 7) & ~(size_t)7;
+    uint64_t tail = _header->tail.load(std::memory_order_relaxed);
+    uint64_t head = _header->head.load(std::memory_order_acquire);
+    size_t offset = tail % CAPACITY;
+    size_t contiguous = CAPACITY - offset;
+    // a packet never spans the end of the ring, the rest of the lap is skipped instead
+    size_t needed = record <= contiguous ? record : contiguous + record;
+    if (record > CAPACITY / 2 || needed > CAPACITY - (tail - head)) {
+        return false;
+    }
+    if (record > contiguous) {
+        uint32_t marker = WRAP_MARKER;
+        std::memcpy(_data + offset, &marker, sizeof(marker));
+        tail += contiguous;
+        offset = 0;
+    }
+    uint32_t packet_size = size;
+    std::memcpy(_data + offset, &packet_size, sizeof(packet_size));
+    std::memcpy(_data + offset + sizeof(packet_size), packet, size);
+    // sequentially consistent with the load of waiting in needsWakeup, see prepareWait
+    _header->tail.store(tail + record);
+    return true;
+}
+
+bool ShmRing::needsWakeup() {
+    return _header->waiting.load() != 0 && _header->waiting.exchange(0) != 0;
+}
+
+size_t ShmRing::pop(const Callback &callback, size_t max_packets) {
+    uint64_t head = _header->head.load(std::memory_order_relaxed);
+    uint64_t tail = _header->tail.load(std::memory_order_acquire);
+    size_t count = 0;
+    if (_is_corrupted || tail - head > CAPACITY) {
+        _is_corrupted = true;
+        return 0;
+    }
+    while (head != tail && count < max_packets) {
+        size_t offset = head % CAPACITY;
+        uint32_t size;
+        std::memcpy(&size, _data + offset, sizeof(size));
+        if (size == WRAP_MARKER) {
+            if (CAPACITY - offset > tail - head) {
+                _is_corrupted = true;
+                break;
+            }
+            head += CAPACITY - offset;
+            continue;
+        }
+        size_t record = (sizeof(size) + (size_t)size + 7) & ~(size_t)7;
+        if (record > CAPACITY - offset || record > tail - head) {
+            _is_corrupted = true;
+            break;
+        }
+        callback(_data + offset + sizeof(size), size);
+        head += record;
+        ++count;
+    }
+    // the producer can only reuse the space once the packets are processed
+    _header->head.store(head, std::memory_order_release);
+    return count;
+}
+
+bool ShmRing::isCorrupted() const {
+    return _is_corrupted;
+}
+
+bool ShmRing::prepareWait() {
+    // either the producer sees the flag after its push and wakes us up, or we see its packet here
+    _header->waiting.store(1);
+    if (_header->head.load(std::memory_order_relaxed) != _header->tail.load()) {
+        _header->waiting.store(0);
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "tlv_framer.h"
+
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+TlvFramer::TlvFramer(size_t capacity, size_t max_packet_size)
+        : _buffer(new char[capacity])
+        , _capacity(capacity)
+        , _max_packet_size(max_packet_size) {
+
+}
+
+char* TlvFramer::getBuffer() {
+    return _buffer.get();
+}
+
+size_t TlvFramer::getCapacity() const {
+    return _capacity;
+}
+
+char* TlvFramer::prepare() {
+    if (_begin > 0 && getFreeSize() < _max_packet_size) {
+        // only the start of a packet is left, shorter than max_packet_size
+        std::memmove(_buffer.get(), _buffer.get() + _begin, _end - _begin);
+        _end -= _begin;
+        _begin = 0;
+    }
+    return _buffer.get() + _end;
+}
+
+size_t TlvFramer::getFreeSize() const {
+    return _capacity - _end;
+}
+
+void TlvFramer::commit(size_t size) {
+    _end += size;
+}
+
+const char* TlvFramer::findType(const char *it, const char *end) {
+#ifdef __SSE2__
+    // 16 bytes at a time, a resynchronization may have to skip a whole garbled packet
+    const __m128i interest = _mm_set1_epi8(0x05);
+    const __m128i data = _mm_set1_epi8(0x06);
+    for (; end - it >= 16; it += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i *)it);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, interest), _mm_cmpeq_epi8(bytes, data)));
+        if (mask != 0) {
+            return it + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (it < end && !isType(*it)) {
+        ++it;
+    }
+    return it;
+}
+
+bool TlvFramer::readLongSize(const char *it, const char *end, uint64_t &size) {
+    if (end - it < 2) {
+        return false;
+    }
+    uint8_t first = it[1];
+    size_t length_size = first < 0xFD ? 0 : first == 0xFD ? 2 : first == 0xFE ? 4 : 8;
+    if ((size_t)(end - it) < 2 + length_size) {
+        return false;
+    }
+    uint64_t length = length_size == 0 ? first : 0;
+    for (size_t i = 0; i < length_size; ++i) {
+        length = length << 8 | (uint8_t)it[2 + i];
+    }
+    // no wrap around, such a length is garbage anyway
+    size = length > UINT32_MAX ? UINT64_MAX : 2 + length_size + length;
+    return true;
+}
@@ -0,0 +1,205 @@
+#include "unix_face.h"
+
+#include <boost/bind.hpp>
+
+#include "../log/logger.h"
+
+UnixFace::UnixFace(boost::asio::io_service &ios, const std::string &path)
+        : Face(ios)
+        , _skip_connect(false)
+        , _endpoint(path)
+        , _socket(ios)
+        , _strand(ios)
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
+        , _timer(ios) {
+}
+
+UnixFace::UnixFace(boost::asio::local::stream_protocol::socket &&socket)
+        : Face(socket.get_io_service())
+        , _skip_connect(true)
+        , _endpoint(socket.local_endpoint())
+        , _socket(std::move(socket))
+        , _strand(socket.get_io_service())
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
+        , _timer(socket.get_io_service()) {
+
+}
+
+void UnixFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats UnixFace::getTxQueueStats() const {
+    return _queue.getStats();
+}
+
+std::string UnixFace::getUnderlyingProtocol() const {
+    return "UNIX";
+}
+
+std::string UnixFace::getUnderlyingEndpoint() const {
+    std::stringstream ss;
+    ss << _endpoint;
+    return ss.str();
+}
+
+void UnixFace::open(const InterestCallback &interest_callback,
+                   const DataCallback &data_callback,
+                   const ErrorCallback &error_callback) {
+    _interest_callback = interest_callback;
+    _data_callback = data_callback;
+    _error_callback = error_callback;
+    if(!_skip_connect && !_is_connected) {
+        connect();
+    } else {
+        _is_connected = true;
+        read();
+    }
+}
+
+void UnixFace::close() {
+    _is_connected = false;
+    _socket.close();
+}
+
+void UnixFace::send(const std::string &message) {
+    _strand.dispatch(boost::bind(&UnixFace::sendImpl, shared_from_this(), std::make_shared<const ndn::Buffer>(message.c_str(), message.length())));
+}
+
+void UnixFace::send(const ndn::Interest &interest) {
+    _strand.dispatch(boost::bind(&UnixFace::sendImpl, shared_from_this(), interest.wireEncode().getBuffer()));
+}
+
+void UnixFace::send(const ndn::Data &data) {
+    _strand.dispatch(boost::bind(&UnixFace::sendImpl, shared_from_this(), data.wireEncode().getBuffer()));
+}
+
+void UnixFace::connect() {
+    _timer.expires_from_now(boost::posix_time::seconds(2));
+    _timer.async_wait(_strand.wrap(boost::bind(&UnixFace::timerHandler, shared_from_this(), _1)));
+    _socket.async_connect(_endpoint, _strand.wrap(boost::bind(&UnixFace::connectHandler, shared_from_this(), _1)));
+}
+
+void UnixFace::connectHandler(const boost::system::error_code &err) {
+    _timer.cancel();
+    if (!err) {
+        std::stringstream ss;
+        ss << "Unix face with ID = " << _face_id << " successfully connected to unix://" << _endpoint;
+        logger::log(logger::INFO, ss.str());
+        _is_connected = true;
+        read();
+    } else {
+        std::stringstream ss;
+        ss << "failed to connect to " << _endpoint;
+        logger::log(logger::ERROR, ss.str());
+        _error_callback(shared_from_this());
+    }
+}
+
+void UnixFace::reconnect(size_t remaining_attempt) {
+    std::stringstream ss;
+    ss << "try to reconnect to " << _endpoint;
+    logger::log(logger::INFO, ss.str());
+    _socket.close();
+    _timer.expires_from_now(boost::posix_time::seconds(2));
+    _timer.async_wait(_strand.wrap(boost::bind(&UnixFace::timerHandler, shared_from_this(), _1)));
+    _socket.async_connect(_endpoint, boost::bind(&UnixFace::reconnectHandler, shared_from_this(), _1, remaining_attempt - 1));
+}
+
+void UnixFace::reconnectHandler(const boost::system::error_code &err, size_t remaining_attempt) {
+    _timer.cancel();
+    if(!err) {
+        read();
+        if(_queue_in_use) {
+            write();
+        }
+    } else if (remaining_attempt > 0 && _is_connected) {
+        std::stringstream ss;
+        ss << "wait 1s before next reconnection to " << _endpoint;
+        logger::log(logger::INFO, ss.str());
+        _timer.expires_from_now(boost::posix_time::seconds(1));
+        _timer.async_wait(boost::bind(&UnixFace::reconnect, shared_from_this(), remaining_attempt));
+    } else {
+        std::stringstream ss;
+        ss << "failed to reconnect to " << _endpoint;
+        logger::log(logger::ERROR, ss.str());
+        _error_callback(shared_from_this());
+    }
+}
+
+void UnixFace::read() {
+    char *buffer = _framer.prepare();
+    boost::asio::async_read(_socket, boost::asio::buffer(buffer, _framer.getFreeSize()),
+                            boost::asio::transfer_at_least(1),
+                            boost::bind(&UnixFace::readHandler, shared_from_this(), _1, _2));
+}
+
+void UnixFace::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
+    if(!err) {
+        _framer.commit(bytes_transferred);
+        _framer.extract([this](const char *packet, size_t size) {
+            try {
+                switch (packet[0]) {
+                    case 0x05:
+                        _interest_callback(shared_from_this(), ndn::Interest(ndn::Block((uint8_t*)packet, size)));
+                        break;
+                    case 0x06:
+                        _data_callback(shared_from_this(), ndn::Data(ndn::Block((uint8_t*)packet, size)));
+                        break;
+                    default:
+                        break;
+                }
+            } catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+            }
+        });
+        read();
+    } else {
+        if(!_skip_connect && _is_connected) {
+            std::stringstream ss;
+            ss << "lost connection to " << _endpoint;
+            logger::log(logger::WARNING, ss.str());
+            reconnect(3);
+        } else {
+            _error_callback(shared_from_this());
+        }
+    }
+}
+
+void UnixFace::sendImpl(std::shared_ptr<const ndn::Buffer> &buffer) {
+    size_t size = buffer->size();
+    bool is_data = size > 0 && (*buffer)[0] == 0x06;
+    _queue.push(std::move(buffer), size, is_data);
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (_queue_in_use || _queue.empty()) {
+        return;
+    }
+
+    _queue_in_use = true;
+    write();
+}
+
+void UnixFace::write() {
+    _queue.markInFlight(1);
+    boost::asio::async_write(_socket, boost::asio::buffer(*_queue.front()),
+                             _strand.wrap(boost::bind(&UnixFace::writeHandler, shared_from_this(), _1, _2)));
+}
+
+void UnixFace::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
+    if(!err) {
+        _queue.pop();
+        updateCongestion(shared_from_this(), _queue.isCongested());
+
+        if (!_queue.empty()) {
+            write();
+        } else {
+            _queue_in_use = false;
+        }
+    }
+}
+
+void UnixFace::timerHandler(const boost::system::error_code &err) {
+    if (!err) {
+        _error_callback(shared_from_this());
+    }
+}
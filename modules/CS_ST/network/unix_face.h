@@ -0,0 +1,81 @@
+#pragma once
+
+#include "concurrency.h"
+#include "face.h"
+#include "tlv_framer.h"
+
+#include <boost/asio.hpp>
+
+#include <iostream>
+#include <string>
+#include <deque>
+#include <vector>
+
+// Stream face over a Unix domain socket for modules running on the same host, framed like TCP but without
+// the checksums and the loopback interface on the path.
+class UnixFace : public Face, public std::enable_shared_from_this<UnixFace> {
+public:
+    static const size_t NDN_MAX_PACKET_SIZE = 8800;
+    static const size_t BUFFER_SIZE = 1 << 15;
+
+private:
+    bool _skip_connect;
+
+    boost::asio::local::stream_protocol::endpoint _endpoint;
+    boost::asio::local::stream_protocol::socket _socket;
+    Strand _strand;
+    TlvFramer _framer;
+    std::string _stream;
+    bool _queue_in_use = false;
+    TxQueue<std::shared_ptr<const ndn::Buffer>> _queue;
+
+    boost::asio::deadline_timer _timer;
+
+public:
+    // use this when creating a face yourself, path is the socket of a UnixMasterFace
+    UnixFace(boost::asio::io_service &ios, const std::string &path);
+
+    // specific constructor for MasterFace, not recommended to use it yourself
+    explicit UnixFace(boost::asio::local::stream_protocol::socket &&socket);
+
+    ~UnixFace() override = default;
+
+    void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+    TxQueueStats getTxQueueStats() const override;
+
+    std::string getUnderlyingProtocol() const override;
+
+    std::string getUnderlyingEndpoint() const override;
+
+    void open(const InterestCallback &interest_callback, const DataCallback &data_callback, const ErrorCallback &error_callback) override;
+
+    void close() override;
+
+    void send(const std::string &message) override;
+
+    void send(const ndn::Interest &interest) override;
+
+    void send(const ndn::Data &data) override;
+
+private:
+    void connect();
+
+    void connectHandler(const boost::system::error_code &err);
+
+    void reconnect(size_t remaining_attempt);
+
+    void reconnectHandler(const boost::system::error_code &err, size_t remaining_attempt);
+
+    void read();
+
+    void readHandler(const boost::system::error_code &err, size_t bytes_transferred);
+
+    void sendImpl(std::shared_ptr<const ndn::Buffer> &buffer);
+
+    void write();
+
+    void writeHandler(const boost::system::error_code &err, size_t bytesTransferred);
+
+    void timerHandler(const boost::system::error_code &err);
+};
@@ -0,0 +1,79 @@
+#include <ndn-cxx/name.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../filter.h"
+
+// Measures the compile time of the filter automaton and its per-lookup cost for growing rule sets,
+// lookup time should stay flat whatever the number of rules.
+static const size_t LOOKUPS = 1000000;
+
+static std::vector<ndn::Name> makeNames(size_t nb_rules, std::mt19937 &generator) {
+    std::uniform_int_distribution<size_t> rule_distribution(0, nb_rules * 2);
+    std::uniform_int_distribution<size_t> segment_distribution(0, 1000);
+    std::vector<ndn::Name> names;
+    names.reserve(4096);
+    for (size_t i = 0; i < 4096; ++i) {
+        std::stringstream ss;
+        ss << "/bench/site" << rule_distribution(generator) % 1000 << "/prefix" << rule_distribution(generator)
+           << "/object/seg=" << segment_distribution(generator);
+        names.emplace_back(ss.str());
+    }
+    return names;
+}
+
+static void run(size_t nb_rules) {
+    std::mt19937 generator(42);
+    Filter filter;
+    for (size_t i = 0; i < nb_rules; ++i) {
+        std::stringstream ss;
+        switch (i % 100) {
+            case 0:
+                ss << "/bench/*/prefix" << i << "/object";
+                break;
+            case 1:
+                ss << "/bench/<site" << i % 1000 << ">/*/<seg=1[0-9]*>";
+                break;
+            default:
+                ss << "/bench/site" << i % 1000 << "/prefix" << i;
+                break;
+        }
+        filter.insert(ss.str(), i % 2 == 0, i % 4);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto rules = std::make_shared<const std::vector<FilterAutomaton::Rule>>(filter.getRules());
+    auto automaton = FilterAutomaton::compile(*rules);
+    auto compiled = std::chrono::steady_clock::now();
+    if (!automaton) {
+        std::cout << nb_rules << " rules: too many states" << std::endl;
+        return;
+    }
+    filter.setAutomaton(automaton, rules);
+
+    auto names = makeNames(nb_rules, generator);
+    size_t dropped = 0;
+    auto lookup_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < LOOKUPS; ++i) {
+        dropped += filter.get(names[i & 4095]);
+    }
+    auto lookup_end = std::chrono::steady_clock::now();
+
+    std::cout << nb_rules << " rules: "
+              << automaton->getStateCount() << " states, compiled in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(compiled - start).count() << " ms, "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(lookup_end - lookup_start).count() / LOOKUPS << " ns/lookup ("
+              << dropped << " drops)" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    for (size_t nb_rules : {1000, 10000, 100000}) {
+        run(nb_rules);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include "deny_set.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static inline uint64_t mix(uint64_t value) {
+    // splitmix64 finalizer
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}
+
+DenySet::DenySet(size_t capacity, size_t bits_per_name, bool exact)
+        : _capacity(std::max<size_t>(capacity, 1))
+        , _bits_per_name(std::max<size_t>(bits_per_name, 1))
+        , _exact(exact)
+        , _hashes_per_name(std::min<size_t>(std::max<long>(std::lround(_bits_per_name * std::log(2)), 1), 16)) {
+    allocate(_capacity);
+}
+
+DenySet::DenySet(const DenySet &other)
+        : _capacity(other._capacity)
+        , _bits_per_name(other._bits_per_name)
+        , _exact(other._exact)
+        , _size(other._size)
+        , _hashes_per_name(other._hashes_per_name)
+        , _fingerprints(other._fingerprints)
+        , _sorted_fingerprints(other._sorted_fingerprints) {
+    allocate(_capacity);
+    std::copy(other._blocks, other._blocks + _block_count * BLOCK_WORDS, _blocks);
+}
+
+// seeds of the two hashes of a name, any two distinct values make them independent
+static const uint64_t HASH_SEED = 0x8445D61A4E774912ULL;
+static const uint64_t CHECK_SEED = 0x2545F4914F6CDD1DULL;
+
+bool DenySet::Fingerprint::operator<(const Fingerprint &other) const {
+    return hash < other.hash || (hash == other.hash && check < other.check);
+}
+
+bool DenySet::Fingerprint::operator==(const Fingerprint &other) const {
+    return hash == other.hash && check == other.check;
+}
+
+DenySet::Fingerprint DenySet::getFingerprint(const ndn::Name &name) {
+    const auto &wire = name.wireEncode();
+    return getFingerprint(wire.wire(), wire.size());
+}
+
+DenySet::Fingerprint DenySet::getFingerprint(const uint8_t *data, size_t size) {
+    return {hash(data, size, HASH_SEED), hash(data, size, CHECK_SEED)};
+}
+
+uint64_t DenySet::hash(const uint8_t *data, size_t size, uint64_t seed) {
+    // MurmurHash64A
+    const uint64_t m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+    uint64_t h = seed ^ (size * m);
+    const uint8_t *end = data + (size & ~(size_t)7);
+    while (data != end) {
+        uint64_t k;
+        std::memcpy(&k, data, sizeof(k));
+        data += sizeof(k);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    switch (size & 7) {
+        case 7: h ^= (uint64_t)data[6] << 48;
+        case 6: h ^= (uint64_t)data[5] << 40;
+        case 5: h ^= (uint64_t)data[4] << 32;
+        case 4: h ^= (uint64_t)data[3] << 24;
+        case 3: h ^= (uint64_t)data[2] << 16;
+        case 2: h ^= (uint64_t)data[1] << 8;
+        case 1: h ^= (uint64_t)data[0];
+            h *= m;
+        default:
+            break;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+size_t DenySet::size() const {
+    return _size;
+}
+
+size_t DenySet::getCapacity() const {
+    return _capacity;
+}
+
+size_t DenySet::getBitsPerName() const {
+    return _bits_per_name;
+}
+
+bool DenySet::isExact() const {
+    return _exact;
+}
+
+size_t DenySet::getMemoryUsage() const {
+    return _storage.capacity() * sizeof(uint64_t) + _fingerprints.capacity() * sizeof(Fingerprint);
+}
+
+bool DenySet::insert(const Fingerprint &fingerprint) {
+    if (_size >= _capacity) {
+        if (!_exact) {
+            // without the fingerprints the filter can't be rebuilt, filling it further would raise the false positives
+            return false;
+        }
+        seal();
+        allocate(_capacity * 2);
+        for (const Fingerprint &kept : _fingerprints) {
+            setBits(kept.hash);
+        }
+    }
+    setBits(fingerprint.hash);
+    if (_exact) {
+        _fingerprints.emplace_back(fingerprint);
+    }
+    ++_size;
+    return true;
+}
+
+void DenySet::seal() {
+    if (_exact && _sorted_fingerprints < _fingerprints.size()) {
+        auto middle = _fingerprints.begin() + _sorted_fingerprints;
+        std::sort(middle, _fingerprints.end());
+        std::inplace_merge(_fingerprints.begin(), middle, _fingerprints.end());
+        _fingerprints.erase(std::unique(_fingerprints.begin(), _fingerprints.end()), _fingerprints.end());
+        _sorted_fingerprints = _fingerprints.size();
+        _size = _fingerprints.size();
+    }
+}
+
+bool DenySet::contains(const ndn::Name &name) const {
+    const auto &wire = name.wireEncode();
+    return contains(wire.wire(), wire.size());
+}
+
+bool DenySet::contains(const uint8_t *data, size_t size) const {
+    uint64_t bloom_hash = hash(data, size, HASH_SEED);
+    if (!testBits(bloom_hash)) {
+        return false;
+    }
+    // the second hash is only computed for the positives of the filter
+    return !_exact || std::binary_search(_fingerprints.begin(), _fingerprints.begin() + _sorted_fingerprints,
+                                         Fingerprint{bloom_hash, hash(data, size, CHECK_SEED)});
+}
+
+void DenySet::allocate(size_t capacity) {
+    _capacity = capacity;
+    _block_count = std::max<size_t>((capacity * _bits_per_name + BLOCK_BITS - 1) / BLOCK_BITS, 1);
+    _storage.assign(_block_count * BLOCK_WORDS + BLOCK_WORDS, 0);
+    // vector only guarantees the alignment of uint64_t, shift the blocks onto cache line boundaries
+    auto misalignment = reinterpret_cast<uintptr_t>(_storage.data()) % (BLOCK_WORDS * sizeof(uint64_t));
+    _blocks = _storage.data() + (misalignment ? (BLOCK_WORDS * sizeof(uint64_t) - misalignment) / sizeof(uint64_t) : 0);
+}
+
+void DenySet::setBits(uint64_t hash) {
+    uint64_t *block = _blocks + (((hash >> 32) * _block_count) >> 32) * BLOCK_WORDS;
+    uint64_t bits = mix(hash);
+    for (size_t i = 0; i < _hashes_per_name; ++i) {
+        // 9 bits per position, so 7 positions per mixed word
+        if (i && i % 7 == 0) {
+            bits = mix(bits);
+        }
+        uint32_t bit = bits & (BLOCK_BITS - 1);
+        bits >>= 9;
+        block[bit >> 6] |= 1ULL << (bit & 63);
+    }
+}
+
+bool DenySet::testBits(uint64_t hash) const {
+    const uint64_t *block = _blocks + (((hash >> 32) * _block_count) >> 32) * BLOCK_WORDS;
+    uint64_t bits = mix(hash);
+    for (size_t i = 0; i < _hashes_per_name; ++i) {
+        if (i && i % 7 == 0) {
+            bits = mix(bits);
+        }
+        uint32_t bit = bits & (BLOCK_BITS - 1);
+        bits >>= 9;
+        if (!(block[bit >> 6] & (1ULL << (bit & 63)))) {
+            return false;
+        }
+    }
+    return true;
+}
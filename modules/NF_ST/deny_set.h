@@ -0,0 +1,88 @@
+#pragma once
+
+#include <ndn-cxx/name.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Set of denied names backed by a blocked Bloom filter: each name sets and tests bits in a single
+// 512 bits block (one cache line), so a lookup is one hash of the name wire encoding and one memory access.
+// In exact mode, the default, every name also keeps a fingerprint: the hash selecting its Bloom bits and a second hash
+// of the name computed with an independent seed, kept sorted. Each positive of the filter is confirmed by the second
+// hash, so a name is wrongly denied only if it collides with a denied name on both 64 bits hashes, and the filter is
+// rebuilt larger from the fingerprints when the capacity is reached. This costs 128 more bits for each name.
+// Otherwise only the filter is kept (about bits_per_name bits for each name, ~1% false positives with 10 bits) and
+// the names past the capacity are refused, so that the false positive rate stays bounded.
+class DenySet {
+public:
+    static const size_t BLOCK_WORDS = 8;
+    static const size_t BLOCK_BITS = BLOCK_WORDS * 64;
+
+    struct Fingerprint {
+        // selects the bits of the name in the Bloom filter
+        uint64_t hash;
+        // independent of hash, confirms the positives in exact mode
+        uint64_t check;
+
+        bool operator<(const Fingerprint &other) const;
+
+        bool operator==(const Fingerprint &other) const;
+    };
+
+private:
+    size_t _capacity;
+    size_t _bits_per_name;
+    bool _exact;
+    size_t _size = 0;
+    size_t _hashes_per_name;
+
+    size_t _block_count;
+    std::vector<uint64_t> _storage;
+    uint64_t *_blocks;
+
+    std::vector<Fingerprint> _fingerprints;
+    size_t _sorted_fingerprints = 0;
+
+public:
+    DenySet(size_t capacity, size_t bits_per_name, bool exact);
+
+    DenySet(const DenySet &other);
+
+    DenySet& operator=(const DenySet &other) = delete;
+
+    ~DenySet() = default;
+
+    static Fingerprint getFingerprint(const ndn::Name &name);
+
+    static Fingerprint getFingerprint(const uint8_t *data, size_t size);
+
+    size_t size() const;
+
+    size_t getCapacity() const;
+
+    size_t getBitsPerName() const;
+
+    bool isExact() const;
+
+    size_t getMemoryUsage() const;
+
+    // false if the set is full, which only happens when it is not exact
+    bool insert(const Fingerprint &fingerprint);
+
+    // must be called after insertions and before using contains() when the set is exact
+    void seal();
+
+    bool contains(const ndn::Name &name) const;
+
+    bool contains(const uint8_t *data, size_t size) const;
+
+private:
+    static uint64_t hash(const uint8_t *data, size_t size, uint64_t seed);
+
+    void allocate(size_t capacity);
+
+    void setBits(uint64_t hash);
+
+    bool testBits(uint64_t hash) const;
+};
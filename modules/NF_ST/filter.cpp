@@ -1,21 +1,111 @@
 #include "filter.h"
 
+#include <sstream>
+
 Filter::Filter() {
-    _tree.insert("/", std::make_shared<FilterEntry>(false));
+    insert("/", false);
+    auto rules = std::make_shared<const std::vector<FilterAutomaton::Rule>>(getRules());
+    setAutomaton(FilterAutomaton::compile(*rules), rules);
+}
+
+bool Filter::insert(const std::string &pattern, bool drop, uint32_t priority) {
+    return insert(pattern, std::make_shared<FilterEntry>(drop, priority));
+}
+
+bool Filter::insert(const std::string &pattern, const std::shared_ptr<const FilterEntry> &entry) {
+    FilterAutomaton::Rule rule;
+    if (!FilterAutomaton::parse(pattern, rule.components, rule.pattern)) {
+        return false;
+    }
+    rule.entry = entry;
+    rule.order = _rule_counter++;
+    _rules[rule.pattern] = std::move(rule);
+    return true;
+}
+
+void Filter::remove(const std::string &pattern) {
+    std::vector<FilterAutomaton::PatternComponent> components;
+    std::string canonical;
+    // the root rule is the default policy, it can only be replaced
+    if (FilterAutomaton::parse(pattern, components, canonical) && canonical != "/") {
+        _rules.erase(canonical);
+    }
+}
+
+bool Filter::get(const ndn::Name &name) const {
+    const FilterEntry *entry = _automaton->match(name);
+    return entry != nullptr && entry->getDrop();
 }
 
-void Filter::insert(const ndn::Name &name, bool drop) {
-    _tree.insert(name, std::make_shared<FilterEntry>(drop), true);
+const FilterEntry* Filter::find(const ndn::Name &name) const {
+    return _automaton->match(name);
 }
 
-void Filter::remove(const ndn::Name &name) {
-    _tree.remove(name);
+void Filter::removeFace(size_t face_id) {
+    for (const auto &rule : _rules) {
+        if (rule.second.entry->isRateLimited()) {
+            rule.second.entry->removeFace(face_id);
+        }
+    }
 }
 
-bool Filter::get(const ndn::Name &name) {
-    return _tree.findLastUntil(name).second->getDrop();
+std::string Filter::rateLimitsToJSON() const {
+    std::stringstream ss;
+    ss << "[";
+    bool first = true;
+    for (const auto &rule : _rules) {
+        if (rule.second.entry->isRateLimited()) {
+            if (first) {
+                first = false;
+            } else {
+                ss << ", ";
+            }
+            ss << R"({"pattern":")" << rule.first << R"(", "allowed":)" << rule.second.entry->getAllowedCounter()
+               << R"(, "shaped":)" << rule.second.entry->getShapedCounter() << "}";
+        }
+    }
+    ss << "]";
+    return ss.str();
+}
+
+size_t Filter::size() const {
+    return _rules.size();
+}
+
+std::vector<FilterAutomaton::Rule> Filter::getRules() const {
+    std::vector<FilterAutomaton::Rule> rules;
+    rules.reserve(_rules.size());
+    for (const auto &rule : _rules) {
+        rules.emplace_back(rule.second);
+    }
+    return rules;
+}
+
+void Filter::setAutomaton(const std::shared_ptr<const FilterAutomaton> &automaton,
+                          const std::shared_ptr<const std::vector<FilterAutomaton::Rule>> &rules) {
+    _automaton = automaton;
+    _compiled_rules = rules;
+}
+
+void Filter::rollback() {
+    _rules.clear();
+    for (const auto &rule : *_compiled_rules) {
+        _rules.emplace(rule.pattern, rule);
+    }
 }
 
 std::string Filter::toJSON() const {
-    return _tree.toJSON();
-}
\ No newline at end of file
+    std::stringstream ss;
+    ss << R"({"states":)" << _automaton->getStateCount() << R"(, "rules":[)";
+    bool first = true;
+    for (const auto &rule : _rules) {
+        if (first) {
+            first = false;
+        } else {
+            ss << ", ";
+        }
+        ss << R"({"pattern":")" << rule.first << R"(", "info":)" << rule.second.entry->toJSON() << "}";
+    }
+    ss << "]}";
+    return ss.str();
+}
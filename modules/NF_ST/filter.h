@@ -4,26 +4,51 @@
 #include <ndn-cxx/data.hpp>
 
 #include <memory>
-#include <list>
-#include <unordered_map>
+#include <map>
+#include <string>
+#include <vector>
 
-#include "tree/named_tree.h"
 #include "filter_entry.h"
+#include "filter_automaton.h"
 
 class Filter {
 private:
-    NamedTree<FilterEntry> _tree;
+    // rules are kept by canonical pattern, the automaton is rebuilt from them and swapped in one go
+    std::map<std::string, FilterAutomaton::Rule> _rules;
+    // the rules the current automaton was compiled from, shared with the filter thread that built it
+    std::shared_ptr<const std::vector<FilterAutomaton::Rule>> _compiled_rules;
+    size_t _rule_counter = 0;
+    std::shared_ptr<const FilterAutomaton> _automaton;
 
 public:
     Filter();
 
     ~Filter() = default;
 
-    void insert(const ndn::Name &name, bool drop);
+    bool insert(const std::string &pattern, bool drop, uint32_t priority = 0);
 
-    void remove(const ndn::Name &name);
+    bool insert(const std::string &pattern, const std::shared_ptr<const FilterEntry> &entry);
 
-    bool get(const ndn::Name &name);
+    void remove(const std::string &pattern);
+
+    bool get(const ndn::Name &name) const;
+
+    const FilterEntry* find(const ndn::Name &name) const;
+
+    void removeFace(size_t face_id);
+
+    std::string rateLimitsToJSON() const;
+
+    size_t size() const;
+
+    std::vector<FilterAutomaton::Rule> getRules() const;
+
+    // the automaton compiled from rules, the current ones unless they changed meanwhile
+    void setAutomaton(const std::shared_ptr<const FilterAutomaton> &automaton,
+                      const std::shared_ptr<const std::vector<FilterAutomaton::Rule>> &rules);
+
+    // back to the rules of the current automaton, the changes still wanted are then applied again
+    void rollback();
 
     std::string toJSON() const;
-};
\ No newline at end of file
+};
@@ -0,0 +1,261 @@
+#include "filter_automaton.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#include "log/logger.h"
+
+size_t FilterAutomaton::ComponentHash::operator()(const ndn::Name::Component &component) const {
+    // FNV-1a over the TLV encoding, so that components of different types do not collide
+    size_t hash = 14695981039346656037ULL;
+    const uint8_t *it = component.wire();
+    const uint8_t *end = it + component.size();
+    while (it < end) {
+        hash ^= *it++;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static std::string trim(const std::string &text) {
+    size_t begin = text.find_first_not_of(" \t\n\r");
+    return begin == std::string::npos ? "" : text.substr(begin, text.find_last_not_of(" \t\n\r") + 1 - begin);
+}
+
+// the path of an URI the way ndn::Name skips its surrounding spaces, its scheme and its authority
+static std::string getUriPath(const std::string &uri) {
+    std::string path = trim(uri);
+    size_t colon = path.find(':');
+    if (colon != std::string::npos && colon < path.find('/')) {
+        path = trim(path.substr(colon + 1));
+    }
+    if (path.compare(0, 2, "//") == 0) {
+        size_t after_authority = path.find('/', 2);
+        path = after_authority == std::string::npos ? "" : path.substr(after_authority);
+    }
+    return path;
+}
+
+bool FilterAutomaton::parse(const std::string &pattern, std::vector<PatternComponent> &components, std::string &canonical) {
+    components.clear();
+    std::stringstream ss;
+    try {
+        std::string path = getUriPath(pattern);
+        size_t begin = 0;
+        while (begin < path.size()) {
+            size_t end = std::min(path.find('/', begin), path.size());
+            if (end > begin) {
+                std::string token = path.substr(begin, end - begin);
+                PatternComponent component;
+                if (token == "*") {
+                    component.type = PatternComponent::WILDCARD;
+                    ss << "/*";
+                } else if (token.size() > 2 && token.front() == '<' && token.back() == '>') {
+                    component.type = PatternComponent::REGEX;
+                    component.expression = token.substr(1, token.size() - 2);
+                    // only there to throw on a malformed expression
+                    std::regex check(component.expression);
+                    ss << "/<" << component.expression << ">";
+                } else {
+                    component.type = PatternComponent::LITERAL;
+                    component.literal = ndn::Name::Component::fromEscapedString(token);
+                    ss << "/" << component.literal.toUri();
+                }
+                components.emplace_back(std::move(component));
+            }
+            begin = end + 1;
+        }
+    } catch (const std::exception &e) {
+        std::stringstream ss1;
+        ss1 << "invalid filter pattern " << pattern << " (" << e.what() << ")";
+        logger::log(logger::WARNING, ss1.str());
+        return false;
+    }
+    canonical = components.empty() ? "/" : ss.str();
+    return true;
+}
+
+static bool isBetterRule(const FilterAutomaton::Rule &rule, const FilterAutomaton::Rule &other) {
+    if (rule.entry->getPriority() != other.entry->getPriority()) {
+        return rule.entry->getPriority() > other.entry->getPriority();
+    }
+    auto is_literal = [](const FilterAutomaton::PatternComponent &component) {
+        return component.type == FilterAutomaton::PatternComponent::LITERAL;
+    };
+    auto literals = std::count_if(rule.components.begin(), rule.components.end(), is_literal);
+    auto other_literals = std::count_if(other.components.begin(), other.components.end(), is_literal);
+    if (literals != other_literals) {
+        return literals > other_literals;
+    }
+    return rule.order > other.order;
+}
+
+std::shared_ptr<const FilterAutomaton> FilterAutomaton::compile(const std::vector<Rule> &rules) {
+    // NFA states are (rule index, number of matched components) pairs packed in 64 bits,
+    // a DFA state is the sorted set of NFA states reachable after the same components
+    using NfaSet = std::vector<uint64_t>;
+
+    auto automaton = std::make_shared<FilterAutomaton>();
+    for (const auto &rule : rules) {
+        automaton->_entries.emplace_back(rule.entry);
+    }
+
+    std::map<NfaSet, uint32_t> ids;
+    std::vector<const NfaSet*> worklist;
+    std::unordered_map<std::string, uint32_t> regex_ids;
+    size_t nfa_states = 0;
+
+    auto getState = [&](NfaSet &set) -> uint32_t {
+        if (set.empty()) {
+            return DEAD_STATE;
+        }
+        std::sort(set.begin(), set.end());
+        set.erase(std::unique(set.begin(), set.end()), set.end());
+        auto result = ids.emplace(std::move(set), automaton->_states.size());
+        if (result.second) {
+            nfa_states += result.first->first.size();
+            automaton->_states.emplace_back();
+            worklist.emplace_back(&result.first->first);
+        }
+        return result.first->second;
+    };
+
+    auto getRegex = [&](const std::string &expression) -> uint32_t {
+        auto result = regex_ids.emplace(expression, automaton->_regexes.size());
+        if (result.second) {
+            automaton->_regexes.emplace_back(expression, std::regex::ECMAScript | std::regex::optimize);
+        }
+        return result.first->second;
+    };
+
+    NfaSet initial;
+    initial.reserve(rules.size());
+    for (size_t i = 0; i < rules.size(); ++i) {
+        initial.emplace_back((uint64_t)i << 32);
+    }
+    getState(initial);
+
+    for (size_t id = 0; id < worklist.size(); ++id) {
+        if (automaton->_states.size() > MAX_STATES || nfa_states > MAX_NFA_STATES) {
+            return nullptr;
+        }
+        const NfaSet &set = *worklist[id];
+
+        std::unordered_map<ndn::Name::Component, NfaSet, ComponentHash> literal_moves;
+        NfaSet wildcard_moves;
+        std::vector<std::pair<uint32_t, NfaSet>> regex_moves;
+        int32_t accept = -1;
+
+        for (uint64_t item : set) {
+            size_t index = item >> 32;
+            size_t depth = item & 0xFFFFFFFF;
+            const Rule &rule = rules[index];
+            if (depth == rule.components.size()) {
+                if (accept < 0 || isBetterRule(rule, rules[accept])) {
+                    accept = index;
+                }
+                continue;
+            }
+            const PatternComponent &component = rule.components[depth];
+            switch (component.type) {
+                case PatternComponent::LITERAL:
+                    literal_moves[component.literal].emplace_back(item + 1);
+                    break;
+                case PatternComponent::WILDCARD:
+                    wildcard_moves.emplace_back(item + 1);
+                    break;
+                case PatternComponent::REGEX: {
+                    uint32_t regex_id = getRegex(component.expression);
+                    auto it = std::find_if(regex_moves.begin(), regex_moves.end(),
+                                           [regex_id](const std::pair<uint32_t, NfaSet> &move) { return move.first == regex_id; });
+                    if (it != regex_moves.end()) {
+                        it->second.emplace_back(item + 1);
+                    } else if (regex_moves.size() < MAX_REGEX_PER_STATE) {
+                        regex_moves.emplace_back(regex_id, NfaSet{item + 1});
+                    } else {
+                        std::stringstream ss;
+                        ss << "too many regexes after the same components, pattern " << rule.pattern << " is partially ignored";
+                        logger::log(logger::WARNING, ss.str());
+                    }
+                    break;
+                }
+            }
+        }
+
+        std::vector<std::pair<ndn::Name::Component, uint32_t>> literals;
+        literals.reserve(literal_moves.size());
+        for (auto &move : literal_moves) {
+            NfaSet &target = move.second;
+            target.insert(target.end(), wildcard_moves.begin(), wildcard_moves.end());
+            if (!regex_moves.empty()) {
+                std::string uri = move.first.toUri();
+                for (const auto &regex_move : regex_moves) {
+                    if (std::regex_match(uri, automaton->_regexes[regex_move.first])) {
+                        target.insert(target.end(), regex_move.second.begin(), regex_move.second.end());
+                    }
+                }
+            }
+            literals.emplace_back(move.first, getState(target));
+        }
+
+        std::vector<uint32_t> fallbacks(1u << regex_moves.size());
+        for (size_t mask = 0; mask < fallbacks.size(); ++mask) {
+            NfaSet target = wildcard_moves;
+            for (size_t i = 0; i < regex_moves.size(); ++i) {
+                if (mask & (1u << i)) {
+                    target.insert(target.end(), regex_moves[i].second.begin(), regex_moves[i].second.end());
+                }
+            }
+            fallbacks[mask] = getState(target);
+        }
+
+        State &state = automaton->_states[id];
+        state.literals.reserve(literals.size());
+        state.literals.insert(literals.begin(), literals.end());
+        for (const auto &regex_move : regex_moves) {
+            state.regexes.emplace_back(regex_move.first);
+        }
+        state.fallbacks = std::move(fallbacks);
+        state.accept = accept;
+    }
+
+    return automaton;
+}
+
+size_t FilterAutomaton::getStateCount() const {
+    return _states.size();
+}
+
+const FilterEntry* FilterAutomaton::match(const ndn::Name &name) const {
+    if (_states.empty()) {
+        return nullptr;
+    }
+    uint32_t current = 0;
+    int32_t accept = _states[0].accept;
+    for (const auto &component : name) {
+        const State &state = _states[current];
+        auto it = state.literals.find(component);
+        if (it != state.literals.end()) {
+            current = it->second;
+        } else if (state.regexes.empty()) {
+            current = state.fallbacks[0];
+        } else {
+            std::string uri = component.toUri();
+            size_t mask = 0;
+            for (size_t i = 0; i < state.regexes.size(); ++i) {
+                if (std::regex_match(uri, _regexes[state.regexes[i]])) {
+                    mask |= 1u << i;
+                }
+            }
+            current = state.fallbacks[mask];
+        }
+        if (current == DEAD_STATE) {
+            break;
+        }
+        if (_states[current].accept >= 0) {
+            accept = _states[current].accept;
+        }
+    }
+    return accept >= 0 ? _entries[accept].get() : nullptr;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <ndn-cxx/name.hpp>
+
+#include <memory>
+#include <regex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "filter_entry.h"
+
+// Deterministic automaton over name components, compiled once from the whole rule set.
+// A rule pattern is a name prefix where each component is either a literal, '*' (any single component)
+// or '<regex>' (ECMAScript regex fully matching the URI form of the component, '/' not allowed).
+// The longest matching pattern wins, ties are broken by priority, then by the number of literal components,
+// then by insertion order. Matching costs one hash lookup per name component whatever the number of rules.
+class FilterAutomaton {
+public:
+    static const uint32_t DEAD_STATE = UINT32_MAX;
+    // bounds the per-state regex fan-out since every combination of regex matches gets its own transition
+    static const size_t MAX_REGEX_PER_STATE = 8;
+    // wildcards and regexes can make the number of states grow exponentially with the number of rules, a rule set
+    // needing more states or more rule positions in total is rejected
+    static const size_t MAX_STATES = 1 << 20;
+    static const size_t MAX_NFA_STATES = 1 << 23;
+
+    struct PatternComponent {
+        enum Type {
+            LITERAL,
+            WILDCARD,
+            REGEX,
+        };
+
+        Type type;
+        ndn::Name::Component literal;
+        std::string expression;
+    };
+
+    struct Rule {
+        std::string pattern;
+        std::vector<PatternComponent> components;
+        std::shared_ptr<const FilterEntry> entry;
+        size_t order;
+    };
+
+private:
+    struct ComponentHash {
+        size_t operator()(const ndn::Name::Component &component) const;
+    };
+
+    struct State {
+        std::unordered_map<ndn::Name::Component, uint32_t, ComponentHash> literals;
+        std::vector<uint32_t> regexes;
+        // indexed by the bitmask of matching regexes, [0] being the wildcard-only transition
+        std::vector<uint32_t> fallbacks;
+        int32_t accept = -1;
+    };
+
+    std::vector<State> _states;
+    std::vector<std::regex> _regexes;
+    std::vector<std::shared_ptr<const FilterEntry>> _entries;
+
+public:
+    FilterAutomaton() = default;
+
+    ~FilterAutomaton() = default;
+
+    // the pattern is an URI as ndn::Name reads it, a scheme such as ndn: and an authority after // are ignored
+    static bool parse(const std::string &pattern, std::vector<PatternComponent> &components, std::string &canonical);
+
+    // nullptr if the rules exceed MAX_STATES or MAX_NFA_STATES
+    static std::shared_ptr<const FilterAutomaton> compile(const std::vector<Rule> &rules);
+
+    size_t getStateCount() const;
+
+    const FilterEntry* match(const ndn::Name &name) const;
+};
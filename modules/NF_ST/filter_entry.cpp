@@ -1,6 +1,12 @@
 #include "filter_entry.h"
 
-FilterEntry::FilterEntry(bool drop) : _drop(drop) {
+FilterEntry::FilterEntry(bool drop, uint32_t priority, double rate, double burst, bool per_face)
+        : _drop(drop)
+        , _priority(priority)
+        , _rate(rate)
+        , _burst(burst > 0 ? burst : rate)
+        , _per_face(per_face)
+        , _bucket(_rate, _burst) {
 
 }
 
@@ -8,8 +14,52 @@ bool FilterEntry::getDrop() const {
     return _drop;
 }
 
+uint32_t FilterEntry::getPriority() const {
+    return _priority;
+}
+
+bool FilterEntry::isRateLimited() const {
+    return _rate > 0;
+}
+
+size_t FilterEntry::getAllowedCounter() const {
+    return _allowed_counter;
+}
+
+size_t FilterEntry::getShapedCounter() const {
+    return _shaped_counter;
+}
+
+bool FilterEntry::admit(size_t face_id, const std::chrono::steady_clock::time_point &now) const {
+    bool allowed;
+    if (_per_face) {
+        auto it = _face_buckets.find(face_id);
+        if (it == _face_buckets.end()) {
+            it = _face_buckets.emplace(face_id, TokenBucket(_rate, _burst)).first;
+        }
+        allowed = it->second.consume(now);
+    } else {
+        allowed = _bucket.consume(now);
+    }
+    if (allowed) {
+        ++_allowed_counter;
+    } else {
+        ++_shaped_counter;
+    }
+    return allowed;
+}
+
+void FilterEntry::removeFace(size_t face_id) const {
+    _face_buckets.erase(face_id);
+}
+
 std::string FilterEntry::toJSON() const {
     std::stringstream ss;
-    ss << R"({"drop": )" << (_drop ? "true" : "false") << R"(})";
+    ss << R"({"drop": )" << (_drop ? "true" : "false") << R"(, "priority": )" << _priority;
+    if (isRateLimited()) {
+        ss << R"(, "rate": )" << _rate << R"(, "burst": )" << _burst << R"(, "per_face": )" << (_per_face ? "true" : "false")
+           << R"(, "allowed": )" << _allowed_counter << R"(, "shaped": )" << _shaped_counter;
+    }
+    ss << R"(})";
     return ss.str();
-}
\ No newline at end of file
+}
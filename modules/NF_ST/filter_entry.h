@@ -2,18 +2,44 @@
 
 #include <ndn-cxx/data.hpp>
 
+#include <chrono>
 #include <memory>
+#include <unordered_map>
+
+#include "token_bucket.h"
 
 class FilterEntry {
 private:
     bool _drop;
+    uint32_t _priority;
+
+    // rate limiting, disabled when rate is 0, the bucket is shared by all faces unless per_face is set
+    double _rate;
+    double _burst;
+    bool _per_face;
+    mutable TokenBucket _bucket;
+    mutable std::unordered_map<size_t, TokenBucket> _face_buckets;
+    mutable size_t _allowed_counter = 0;
+    mutable size_t _shaped_counter = 0;
 
 public:
-    explicit FilterEntry(bool drop);
+    explicit FilterEntry(bool drop, uint32_t priority = 0, double rate = 0, double burst = 0, bool per_face = false);
 
     ~FilterEntry() = default;
 
     bool getDrop() const;
 
+    uint32_t getPriority() const;
+
+    bool isRateLimited() const;
+
+    size_t getAllowedCounter() const;
+
+    size_t getShapedCounter() const;
+
+    bool admit(size_t face_id, const std::chrono::steady_clock::time_point &now) const;
+
+    void removeFace(size_t face_id) const;
+
     std::string toJSON() const;
-};
\ No newline at end of file
+};
@@ -2,46 +2,86 @@
 
 #include <boost/bind.hpp>
 
+#include <algorithm>
+#include <fstream>
+
 #include "network/tcp_master_face.h"
 #include "network/tcp_face.h"
 #include "network/udp_master_face.h"
 #include "network/udp_face.h"
+#include "network/unix_master_face.h"
+#include "network/unix_face.h"
+#include "network/shm_master_face.h"
+#include "network/shm_face.h"
 #include "log/logger.h"
 
-Firewall::Firewall(const std::string &name, uint16_t local_port, uint16_t local_command_port)
+Firewall::Firewall(const std::string &name, uint16_t local_port, uint16_t local_command_port, size_t max_connection)
         : Module(1)
         , _name(name)
+        , _filter_ios_work(_filter_ios)
+        , _filter_thread(boost::bind(&boost::asio::io_service::run, &_filter_ios))
         , _command_socket(_ios, {{}, local_command_port})
         , _report_timer(_ios)
         , _delay_between_report(0) {
-    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, 16, local_port);
-    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, 16, local_port);
+    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, max_connection, local_port);
+    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, max_connection, local_port);
+    _unix_ingress_master_face = std::make_shared<UnixMasterFace>(_ios, max_connection, UnixMasterFace::getSocketPath(name));
+    _shm_ingress_master_face = std::make_shared<ShmMasterFace>(_ios, max_connection, ShmMasterFace::getSocketPath(name));
+}
+
+Firewall::~Firewall() {
+    _filter_ios.stop();
+    _filter_thread.join();
 }
 
 void Firewall::run() {
     commandRead();
+    _tcp_ingress_master_face->setCongestionCallback(boost::bind(&Firewall::onFaceCongestion, this, _1, _2));
     _tcp_ingress_master_face->listen(boost::bind(&Firewall::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&Firewall::onIngressInterest, this, _1, _2),
                                      boost::bind(&Firewall::onIngressData, this, _1, _2),
                                      boost::bind(&Firewall::onMasterFaceError, this, _1, _2));
+    _udp_ingress_master_face->setCongestionCallback(boost::bind(&Firewall::onFaceCongestion, this, _1, _2));
     _udp_ingress_master_face->listen(boost::bind(&Firewall::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&Firewall::onIngressInterest, this, _1, _2),
                                      boost::bind(&Firewall::onIngressData, this, _1, _2),
                                      boost::bind(&Firewall::onMasterFaceError, this, _1, _2));
+    _unix_ingress_master_face->setCongestionCallback(boost::bind(&Firewall::onFaceCongestion, this, _1, _2));
+    _unix_ingress_master_face->listen(boost::bind(&Firewall::onMasterFaceNotification, this, _1, _2),
+                                      boost::bind(&Firewall::onIngressInterest, this, _1, _2),
+                                      boost::bind(&Firewall::onIngressData, this, _1, _2),
+                                      boost::bind(&Firewall::onMasterFaceError, this, _1, _2));
+    _shm_ingress_master_face->setCongestionCallback(boost::bind(&Firewall::onFaceCongestion, this, _1, _2));
+    _shm_ingress_master_face->listen(boost::bind(&Firewall::onMasterFaceNotification, this, _1, _2),
+                                     boost::bind(&Firewall::onIngressInterest, this, _1, _2),
+                                     boost::bind(&Firewall::onIngressData, this, _1, _2),
+                                     boost::bind(&Firewall::onMasterFaceError, this, _1, _2));
 }
 
 void Firewall::onIngressInterest(const std::shared_ptr<Face> &ingress_face, const ndn::Interest &interest) {
-    if (_drop_interest && _filter.get(interest.getName())) {
+    const FilterEntry *entry = nullptr;
+    if (_drop_interest && isDropped(interest.getName(), entry)) {
         ++_interest_drop_counter;
-    } else {
-        for (auto& egress_face : _egress_faces) {
-            egress_face->send(interest);
+        return;
+    }
+    if (!_drop_interest) {
+        entry = _filter.find(interest.getName());
+    }
+    if (entry && entry->isRateLimited()) {
+        // shaping protects the PIT of the downstream modules against Interest flooding
+        if (!entry->admit(ingress_face->getFaceId(), std::chrono::steady_clock::now())) {
+            ++_interest_shaped_counter;
+            return;
         }
+        ++_interest_allowed_counter;
+    }
+    for (auto& egress_face : _egress_faces) {
+        egress_face->send(interest);
     }
 }
 
 void Firewall::onIngressData(const std::shared_ptr<Face> &ingress_face, const ndn::Data &data) {
-    if (_drop_data && _filter.get(data.getName())) {
+    if (_drop_data && isDropped(data.getName())) {
         ++_data_drop_counter;
     } else {
         for (auto& egress_face : _egress_faces) {
@@ -51,20 +91,24 @@ void Firewall::onIngressData(const std::shared_ptr<Face> &ingress_face, const nd
 }
 
 void Firewall::onEgressInterest(const std::shared_ptr<Face> &egress_face, const ndn::Interest &interest) {
-    if (_drop_interest && _filter.get(interest.getName())) {
+    if (_drop_interest && isDropped(interest.getName())) {
         ++_interest_drop_counter;
     } else {
         _tcp_ingress_master_face->sendToAllFaces(interest);
         _udp_ingress_master_face->sendToAllFaces(interest);
+        _unix_ingress_master_face->sendToAllFaces(interest);
+        _shm_ingress_master_face->sendToAllFaces(interest);
     }
 }
 
 void Firewall::onEgressData(const std::shared_ptr<Face> &egress_face, const ndn::Data &data) {
-    if (_drop_data && _filter.get(data.getName())) {
+    if (_drop_data && isDropped(data.getName())) {
         ++_data_drop_counter;
     } else {
         _tcp_ingress_master_face->sendToAllFaces(data);
         _udp_ingress_master_face->sendToAllFaces(data);
+        _unix_ingress_master_face->sendToAllFaces(data);
+        _shm_ingress_master_face->sendToAllFaces(data);
     }
 }
 
@@ -78,6 +122,7 @@ void Firewall::onMasterFaceError(const std::shared_ptr<MasterFace> &master_face,
     std::stringstream ss;
     ss << " face with ID = " << face->getFaceId() << " from master face with ID = " << master_face->getMasterFaceId() << " can't process normally";
     logger::log(logger::ERROR, ss.str());
+    _filter.removeFace(face->getFaceId());
 }
 
 void Firewall::onFaceError(const std::shared_ptr<Face> &face) {
@@ -93,6 +138,177 @@ void Firewall::onFaceError(const std::shared_ptr<Face> &face) {
     }
 }
 
+void Firewall::onFaceCongestion(const std::shared_ptr<Face> &face, bool congested) {
+    // only reported to a manager, the sender of the last command may be long gone
+    if (_manager_endpoint.address() == boost::asio::ip::address_v4::any() || _manager_endpoint.port() == 0) {
+        return;
+    }
+    TxQueueStats stats = face->getTxQueueStats();
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"report", "action":"face_congestion", "face_id":)" << face->getFaceId()
+       << R"(, "congested":)" << (congested ? "true" : "false") << R"(, "queued_packets":)" << stats.packets
+       << R"(, "queued_bytes":)" << stats.bytes << R"(, "dropped_packets":)" << stats.dropped_packets
+       << R"(, "dropped_bytes":)" << stats.dropped_bytes << "}";
+    // from the packet path, a failed report must not throw out of the handler
+    boost::system::error_code err;
+    _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint, 0, err);
+}
+
+bool Firewall::isDropped(const ndn::Name &name) {
+    const FilterEntry *entry;
+    return isDropped(name, entry);
+}
+
+bool Firewall::isDropped(const ndn::Name &name, const FilterEntry *&entry) {
+    if (_deny_set && _deny_set->contains(name)) {
+        ++_deny_set_drop_counter;
+        entry = nullptr;
+        return true;
+    }
+    entry = _filter.find(name);
+    return entry != nullptr && entry->getDrop();
+}
+
+void Firewall::updateFilter(RulesUpdate &&update) {
+    _pending_rules_updates.emplace_back(std::move(update));
+    updateFilter();
+}
+
+void Firewall::updateFilter() {
+    auto rules = std::make_shared<const std::vector<FilterAutomaton::Rule>>(_filter.getRules());
+    _filter_ios.post(boost::bind(&Firewall::compileFilter, this, rules, ++_filter_generation));
+}
+
+void Firewall::compileFilter(const std::shared_ptr<const std::vector<FilterAutomaton::Rule>> &rules, size_t generation) {
+    // skip this build if the rules have changed again meanwhile, the next one will cover it
+    if (generation == _filter_generation) {
+        auto automaton = FilterAutomaton::compile(*rules);
+        _ios.post(boost::bind(&Firewall::onFilterCompiled, this, automaton, rules, generation));
+    }
+}
+
+void Firewall::onFilterCompiled(const std::shared_ptr<const FilterAutomaton> &automaton,
+                                const std::shared_ptr<const std::vector<FilterAutomaton::Rule>> &rules, size_t generation) {
+    if (generation != _filter_generation) {
+        return;
+    }
+    if (automaton) {
+        _filter.setAutomaton(automaton, rules);
+        std::stringstream ss;
+        ss << "filter updated with " << _filter.size() << " rules compiled into " << automaton->getStateCount() << " states";
+        logger::log(logger::INFO, ss.str());
+        for (const auto &update : _pending_rules_updates) {
+            reportRulesUpdate(update, true);
+        }
+        _pending_rules_updates.clear();
+        return;
+    }
+    // removing rules never adds states, so the last update adding some is the one that can't be compiled
+    auto failed = std::find_if(_pending_rules_updates.rbegin(), _pending_rules_updates.rend(),
+                               [](const RulesUpdate &update) { return update.action == "add_rules"; });
+    auto it = failed == _pending_rules_updates.rend() ? _pending_rules_updates.end() - 1 : std::next(failed).base();
+    RulesUpdate rejected = std::move(*it);
+    _pending_rules_updates.erase(it);
+    _filter.rollback();
+    for (const auto &update : _pending_rules_updates) {
+        for (const auto &change : update.changes) {
+            if (change.second) {
+                _filter.insert(change.first, change.second);
+            } else {
+                _filter.remove(change.first);
+            }
+        }
+    }
+    std::stringstream ss;
+    ss << "filter update " << rejected.id << " rejected, its rules compile into too many states";
+    logger::log(logger::ERROR, ss.str());
+    reportRulesUpdate(rejected, false);
+    if (!_pending_rules_updates.empty()) {
+        updateFilter();
+    }
+}
+
+void Firewall::reportRulesUpdate(const RulesUpdate &update, bool success) {
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"report", "id":)" << update.id << R"(, "action":")" << update.action << R"(", )";
+    if (success) {
+        ss << R"("status":"success"})";
+    } else {
+        ss << R"("status":"fail", "reason":"too many states"})";
+    }
+    boost::system::error_code err;
+    _command_socket.send_to(boost::asio::buffer(ss.str()), update.endpoint, 0, err);
+}
+
+// runs on the filter thread like the other deny set operations, a bulk load doesn't hold up the packets
+void Firewall::addToDenySet(const std::vector<std::string> &names, const std::string &filename) {
+    if (!_pending_deny_set) {
+        _pending_deny_set.reset(new DenySet(1 << 20, 10, true));
+    }
+    size_t added = 0;
+    size_t refused = 0;
+    auto add = [this, &added, &refused](const std::string &name) {
+        try {
+            if (_pending_deny_set->insert(DenySet::getFingerprint(ndn::Name(name)))) {
+                ++added;
+            } else {
+                ++refused;
+            }
+        } catch (const std::exception &e) {
+            logger::log(logger::ERROR, "invalid name " + name + " for the deny set (" + e.what() + ")");
+        }
+    };
+    for (const auto &name : names) {
+        add(name);
+    }
+    if (!filename.empty()) {
+        std::ifstream file(filename);
+        if (!file) {
+            logger::log(logger::ERROR, "can't open deny set file " + filename);
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty()) {
+                add(line);
+            }
+        }
+    }
+    std::stringstream ss;
+    ss << added << " names added to the pending deny set";
+    logger::log(logger::INFO, ss.str());
+    if (refused > 0) {
+        std::stringstream ss1;
+        ss1 << refused << " names refused, the pending deny set is full at " << _pending_deny_set->getCapacity()
+            << " names, clear it with a larger capacity or in exact mode";
+        logger::log(logger::ERROR, ss1.str());
+    }
+}
+
+void Firewall::commitDenySet() {
+    std::shared_ptr<const DenySet> deny_set;
+    if (_pending_deny_set) {
+        _pending_deny_set->seal();
+        deny_set = std::make_shared<const DenySet>(*_pending_deny_set);
+    }
+    _ios.post(boost::bind(&Firewall::onDenySetCommitted, this, deny_set));
+}
+
+void Firewall::resetDenySet(size_t capacity, size_t bits_per_name, bool exact) {
+    _pending_deny_set.reset(new DenySet(capacity, bits_per_name, exact));
+    _ios.post(boost::bind(&Firewall::onDenySetCommitted, this, std::shared_ptr<const DenySet>()));
+}
+
+void Firewall::onDenySetCommitted(const std::shared_ptr<const DenySet> &deny_set) {
+    _deny_set = deny_set && deny_set->size() > 0 ? deny_set : nullptr;
+    std::stringstream ss;
+    if (_deny_set) {
+        ss << "deny set updated with " << _deny_set->size() << " names using " << _deny_set->getMemoryUsage() << " bytes";
+    } else {
+        ss << "deny set cleared";
+    }
+    logger::log(logger::INFO, ss.str());
+}
+
 void Firewall::commandRead() {
     _command_socket.async_receive_from(boost::asio::buffer(_command_buffer, 65536), _remote_command_endpoint,
                                        boost::bind(&Firewall::commandReadHandler, this, _1, _2));
@@ -105,6 +321,9 @@ void Firewall::commandReadHandler(const boost::system::error_code &err, size_t b
         DEL_FACE,
         ADD_RULES,
         DEL_RULES,
+        ADD_DENY_SET,
+        COMMIT_DENY_SET,
+        CLEAR_DENY_SET,
     };
 
     static const std::map<std::string, action_type> ACTIONS = {
@@ -113,6 +332,9 @@ void Firewall::commandReadHandler(const boost::system::error_code &err, size_t b
             {"del_face", DEL_FACE},
             {"add_rules", ADD_RULES},
             {"del_rules", DEL_RULES},
+            {"add_deny_set", ADD_DENY_SET},
+            {"commit_deny_set", COMMIT_DENY_SET},
+            {"clear_deny_set", CLEAR_DENY_SET},
     };
 
     if(!err) {
@@ -139,6 +361,15 @@ void Firewall::commandReadHandler(const boost::system::error_code &err, size_t b
                             case DEL_RULES:
                                 commandDelRules(document);
                                 break;
+                            case ADD_DENY_SET:
+                                commandAddDenySet(document);
+                                break;
+                            case COMMIT_DENY_SET:
+                                commandCommitDenySet(document);
+                                break;
+                            case CLEAR_DENY_SET:
+                                commandClearDenySet(document);
+                                break;
                         }
                     }
                 } else{
@@ -237,27 +468,71 @@ void Firewall::commandAddFace(const rapidjson::Document &document) {
     enum layer_type {
         TCP,
         UDP,
+        UNIX,
+        SHM,
     };
 
     static const std::unordered_map<std::string, layer_type> LAYERS = {
             {"tcp", TCP},
             {"udp", UDP},
+            {"unix", UNIX},
+            {"shm", SHM},
     };
 
-    if (document.HasMember("layer") && document.HasMember("address") && document.HasMember("port")
-        && document["layer"].IsString() && document["address"].IsString() && document["port"].IsUint()) {
+    static const std::unordered_map<std::string, DropPolicy> DROP_POLICIES = {
+            {"tail_drop", DropPolicy::TAIL_DROP},
+            {"head_drop", DropPolicy::HEAD_DROP},
+            {"priority_drop", DropPolicy::PRIORITY_DROP},
+    };
+
+    if (document.HasMember("layer") && document.HasMember("address") && document["layer"].IsString() && document["address"].IsString()) {
+        // the address of a unix or shm face is the socket path of the module, only tcp and udp need a port
+        bool has_port = document.HasMember("port") && document["port"].IsUint();
         auto it = LAYERS.find(document["layer"].GetString());
-        if (it != LAYERS.end()) {
+        if (it != LAYERS.end() && (has_port || it->second == UNIX || it->second == SHM)) {
             std::shared_ptr<Face> face;
             switch (it->second) {
                 case TCP:
                     face = std::make_shared<TcpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
                     break;
-                case UDP:
-                    face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                case UDP: {
+                    auto udp_face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                    if (document.HasMember("mtu") && document["mtu"].IsUint()) {
+                        udp_face->setMtu(document["mtu"].GetUint());
+                    }
+                    if (document.HasMember("aggregation") && document["aggregation"].IsBool()) {
+                        // the delay is given in microseconds
+                        uint32_t delay = document.HasMember("aggregation_delay") && document["aggregation_delay"].IsUint()
+                                         ? document["aggregation_delay"].GetUint() : 0;
+                        udp_face->setAggregation(document["aggregation"].GetBool(), boost::posix_time::microseconds(delay));
+                    }
+                    face = udp_face;
+                    break;
+                }
+                case UNIX:
+                    face = std::make_shared<UnixFace>(_ios, document["address"].GetString());
+                    break;
+                case SHM:
+                    face = std::make_shared<ShmFace>(_ios, document["address"].GetString());
                     break;
             }
             _egress_faces.push_back(face);
+            // optional bounds of the transmit queue of the face
+            TxQueueLimits limits;
+            if (document.HasMember("queue_packets") && document["queue_packets"].IsUint()) {
+                limits.packets = document["queue_packets"].GetUint();
+            }
+            if (document.HasMember("queue_bytes") && document["queue_bytes"].IsUint()) {
+                limits.bytes = document["queue_bytes"].GetUint();
+            }
+            if (document.HasMember("drop_policy") && document["drop_policy"].IsString()) {
+                auto policy = DROP_POLICIES.find(document["drop_policy"].GetString());
+                if (policy != DROP_POLICIES.end()) {
+                    limits.policy = policy->second;
+                }
+            }
+            face->setTxQueueLimits(limits);
+            face->setCongestionCallback(boost::bind(&Firewall::onFaceCongestion, this, _1, _2));
             face->open(boost::bind(&Firewall::onEgressInterest, this, _1, _2),
                        boost::bind(&Firewall::onEgressData, this, _1, _2),
                        boost::bind(&Firewall::onFaceError, this, _1));
@@ -295,19 +570,33 @@ void Firewall::commandAddRules(const rapidjson::Document &document) {
         if (rules.Empty()) {
             ss << R"("status":"fail", "reason":"empty rule list"})";
         } else {
+            RulesUpdate update {"add_rules", document["id"].GetUint(), _remote_command_endpoint, {}};
             for (auto &rule : rules) {
                 if (rule.IsArray()) {
                     auto rule_info = rule.GetArray();
-                    if (rule_info.Size() == 3 && rule_info[0].IsString() && rule_info[1].IsBool() && rule_info[2].IsUint()) {
-                        ndn::Name name_prefix(rule_info[0].GetString());
-                        _filter.insert(name_prefix, rule_info[1].GetBool());
-                        std::stringstream ss1;
-                        ss1 << name_prefix << " with " << (rule_info[1].GetBool() ? "drop" : "accept") << " policy added by manager";
-                        logger::log(logger::INFO, ss1.str());
+                    // [pattern, drop, priority] optionally followed by [rate (packets/s), burst, per_face] for Interest shaping
+                    if (rule_info.Size() >= 3 && rule_info[0].IsString() && rule_info[1].IsBool() && rule_info[2].IsUint()) {
+                        std::string pattern = rule_info[0].GetString();
+                        double rate = rule_info.Size() > 3 && rule_info[3].IsNumber() ? rule_info[3].GetDouble() : 0;
+                        double burst = rule_info.Size() > 4 && rule_info[4].IsNumber() ? rule_info[4].GetDouble() : 0;
+                        bool per_face = rule_info.Size() > 5 && rule_info[5].IsBool() && rule_info[5].GetBool();
+                        auto entry = std::make_shared<FilterEntry>(rule_info[1].GetBool(), rule_info[2].GetUint(), rate, burst, per_face);
+                        if (_filter.insert(pattern, entry)) {
+                            update.changes.emplace_back(pattern, entry);
+                            std::stringstream ss1;
+                            ss1 << pattern << " with " << (rule_info[1].GetBool() ? "drop" : "accept") << " policy";
+                            if (entry->isRateLimited()) {
+                                ss1 << " limited to " << rate << " Interests/s" << (per_face ? " per face" : "");
+                            }
+                            ss1 << " added by manager";
+                            logger::log(logger::INFO, ss1.str());
+                        }
                     }
                 }
             }
-            ss << R"("status":"success"})";
+            // the outcome is reported once the rules are compiled
+            updateFilter(std::move(update));
+            ss << R"("status":"pending"})";
         }
         _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
     }
@@ -321,22 +610,76 @@ void Firewall::commandDelRules(const rapidjson::Document &document) {
         if (rules.Empty()) {
             ss << R"("status":"fail", "reason":"empty prefix list"})";
         } else {
+            RulesUpdate update {"del_rules", document["id"].GetUint(), _remote_command_endpoint, {}};
             for (auto &rule : rules) {
                 if (rule.IsString()) {
-                    ndn::Name name_prefix(rule.GetString());
-                    _filter.remove(name_prefix);
+                    std::string pattern = rule.GetString();
+                    _filter.remove(pattern);
+                    update.changes.emplace_back(pattern, nullptr);
                     std::stringstream ss1;
-                    ss1 << name_prefix << " removed by manager";
+                    ss1 << pattern << " removed by manager";
                     logger::log(logger::INFO, ss1.str());
                 }
             }
-            ss << R"("status":"success"})";
+            updateFilter(std::move(update));
+            ss << R"("status":"pending"})";
         }
         _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
         std::cout << _filter.toJSON() << std::endl;
     }
 }
 
+void Firewall::commandAddDenySet(const rapidjson::Document &document) {
+    std::vector<std::string> names;
+    std::string filename;
+    if (document.HasMember("names") && document["names"].IsArray()) {
+        for (auto &name : document["names"].GetArray()) {
+            if (name.IsString()) {
+                names.emplace_back(name.GetString());
+            }
+        }
+    }
+    if (document.HasMember("file") && document["file"].IsString()) {
+        filename = document["file"].GetString();
+    }
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"add_deny_set", )";
+    if (names.empty() && filename.empty()) {
+        ss << R"("status":"fail", "reason":"no names nor file provided"})";
+    } else {
+        // names are hashed on the filter thread, they become effective once committed
+        _filter_ios.post(boost::bind(&Firewall::addToDenySet, this, names, filename));
+        ss << R"("status":"success", "names":)" << names.size() << "}";
+    }
+    _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+}
+
+void Firewall::commandCommitDenySet(const rapidjson::Document &document) {
+    _filter_ios.post(boost::bind(&Firewall::commitDenySet, this));
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"commit_deny_set", "status":"success"})";
+    _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+}
+
+void Firewall::commandClearDenySet(const rapidjson::Document &document) {
+    size_t capacity = 1 << 20;
+    size_t bits_per_name = 10;
+    bool exact = true;
+    if (document.HasMember("capacity") && document["capacity"].IsUint()) {
+        capacity = document["capacity"].GetUint();
+    }
+    if (document.HasMember("bits_per_name") && document["bits_per_name"].IsUint()) {
+        bits_per_name = document["bits_per_name"].GetUint();
+    }
+    if (document.HasMember("exact") && document["exact"].IsBool()) {
+        exact = document["exact"].GetBool();
+    }
+    _filter_ios.post(boost::bind(&Firewall::resetDenySet, this, capacity, bits_per_name, exact));
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"clear_deny_set", "status":"success"})";
+    _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+}
+
 void Firewall::commandList(const rapidjson::Document &document) {
     std::stringstream ss;
     ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"list")" << "}";
@@ -346,7 +689,10 @@ void Firewall::commandList(const rapidjson::Document &document) {
 void Firewall::commandReport(const boost::system::error_code &err) {
     if (!err && _manager_endpoint.address() != boost::asio::ip::address_v4::any() && _manager_endpoint.port() != 0) {
         std::stringstream ss;
-        ss << R"({"name":")" << _name << R"(", "type":"report", "action":"cache_status", "interest_drop":)" << _interest_drop_counter << R"(, "data_drop":)" << _data_drop_counter << "}";
+        ss << R"({"name":")" << _name << R"(", "type":"report", "action":"cache_status", "interest_drop":)" << _interest_drop_counter << R"(, "data_drop":)" << _data_drop_counter
+           << R"(, "deny_set_drop":)" << _deny_set_drop_counter << R"(, "deny_set_size":)" << (_deny_set ? _deny_set->size() : 0)
+           << R"(, "interest_allowed":)" << _interest_allowed_counter << R"(, "interest_shaped":)" << _interest_shaped_counter
+           << R"(, "rate_limits":)" << _filter.rateLimitsToJSON() << "}";
         _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint);
     }
     if(_report_enable) {
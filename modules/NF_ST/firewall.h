@@ -5,6 +5,7 @@
 
 #include <boost/asio.hpp>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -14,13 +15,33 @@
 
 #include "module.h"
 #include "filter.h"
+#include "deny_set.h"
 #include "network/master_face.h"
 #include "network/face.h"
 
 class Firewall : public Module {
+    // the changes of the rules made by one command, kept until an automaton including them is compiled so that the
+    // sender learns the outcome, and applied again if a later command had to be rolled back
+    struct RulesUpdate {
+        std::string action;
+        uint32_t id;
+        boost::asio::ip::udp::endpoint endpoint;
+        // the new entry of each pattern, nullptr when it is removed
+        std::vector<std::pair<std::string, std::shared_ptr<const FilterEntry>>> changes;
+    };
+
     const std::string _name;
 
     Filter _filter;
+    // the filter automaton is compiled on its own thread then swapped in by the packet processing thread
+    boost::asio::io_service _filter_ios;
+    boost::asio::io_service::work _filter_ios_work;
+    boost::thread _filter_thread;
+    std::atomic<size_t> _filter_generation {0};
+    std::vector<RulesUpdate> _pending_rules_updates;
+    // deny set under construction is only touched by the filter thread, the published one by the packet processing thread
+    std::unique_ptr<DenySet> _pending_deny_set;
+    std::shared_ptr<const DenySet> _deny_set;
 
     char _command_buffer[65536];
     boost::asio::ip::udp::socket _command_socket;
@@ -34,15 +55,20 @@ class Firewall : public Module {
     boost::posix_time::milliseconds _delay_between_report;
     size_t _interest_drop_counter = 0;
     size_t _data_drop_counter = 0;
+    size_t _deny_set_drop_counter = 0;
+    size_t _interest_allowed_counter = 0;
+    size_t _interest_shaped_counter = 0;
 
     std::vector<std::shared_ptr<Face>> _egress_faces;
     std::shared_ptr<MasterFace> _tcp_ingress_master_face;
     std::shared_ptr<MasterFace> _udp_ingress_master_face;
+    std::shared_ptr<MasterFace> _unix_ingress_master_face;
+    std::shared_ptr<MasterFace> _shm_ingress_master_face;
 
 public:
-    Firewall(const std::string &name, uint16_t local_port, uint16_t local_command_port);
+    Firewall(const std::string &name, uint16_t local_port, uint16_t local_command_port, size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION);
 
-    ~Firewall() override = default;
+    ~Firewall() override;
 
     void run() override;
 
@@ -60,6 +86,31 @@ public:
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
+    bool isDropped(const ndn::Name &name);
+
+    bool isDropped(const ndn::Name &name, const FilterEntry *&entry);
+
+    void updateFilter(RulesUpdate &&update);
+
+    void updateFilter();
+
+    void compileFilter(const std::shared_ptr<const std::vector<FilterAutomaton::Rule>> &rules, size_t generation);
+
+    void onFilterCompiled(const std::shared_ptr<const FilterAutomaton> &automaton,
+                          const std::shared_ptr<const std::vector<FilterAutomaton::Rule>> &rules, size_t generation);
+
+    void reportRulesUpdate(const RulesUpdate &update, bool success);
+
+    void addToDenySet(const std::vector<std::string> &names, const std::string &filename);
+
+    void commitDenySet();
+
+    void resetDenySet(size_t capacity, size_t bits_per_name, bool exact);
+
+    void onDenySetCommitted(const std::shared_ptr<const DenySet> &deny_set);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
@@ -74,6 +125,12 @@ public:
 
     void commandDelRules(const rapidjson::Document &document);
 
+    void commandAddDenySet(const rapidjson::Document &document);
+
+    void commandCommitDenySet(const rapidjson::Document &document);
+
+    void commandClearDenySet(const rapidjson::Document &document);
+
     void commandList(const rapidjson::Document &document);
 
     void commandReport(const boost::system::error_code &err);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "lp_fragmenter.h"
+
+// Rebuilds the network packets a remote endpoint fragmented with NDNLPv2 (see LpFragmenter). The fragments of a
+// packet are identified by the sequence number of its first fragment. At most MAX_PARTIAL_PACKETS packets are
+// reassembled at once, the oldest one is given up to make room, and a packet whose fragments didn't all arrive in
+// time is given up as well. Used from the read handler of a single face.
+class LpReassembler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const size_t MAX_PARTIAL_PACKETS = 64;
+    static const size_t MAX_PACKET_SIZE = 1 << 16;
+    // fragments of the largest NDN packet cut to the smallest MTU of LpFragmenter
+    static const size_t MAX_FRAGMENTS = (MAX_PACKET_SIZE + LpFragmenter::MIN_MTU - LpFragmenter::MAX_HEADER_SIZE - 1)
+                                        / (LpFragmenter::MIN_MTU - LpFragmenter::MAX_HEADER_SIZE);
+
+private:
+    struct PartialPacket {
+        std::vector<std::string> fragments;
+        size_t received;
+        size_t size;
+        Clock::time_point expiry;
+    };
+
+    Clock::duration _timeout;
+    std::map<uint64_t, PartialPacket> _partial_packets;
+    std::string _packet;
+
+public:
+    explicit LpReassembler(Clock::duration timeout = std::chrono::milliseconds(500));
+
+    // returns true when the datagram completes a network packet, given by packet and size until the next call.
+    // A datagram that isn't a LpPacket is a network packet of its own.
+    bool receive(const char *datagram, size_t datagram_size, const char *&packet, size_t &size);
+
+    // same for a datagram carrying several packets back to back (see aggregation in the UDP faces), it is moved past
+    // the packets read and false is returned once the datagram is consumed
+    bool unpack(const char *&it, const char *end, const char *&packet, size_t &size);
+
+    size_t getPartialPacketCount() const;
+
+private:
+    void expire(Clock::time_point now);
+
+    static bool readVarNumber(const char *&it, const char *end, uint64_t &number);
+
+    static bool readNonNegativeInteger(const char *it, uint64_t length, uint64_t &number);
+};
@@ -0,0 +1,344 @@
+#include "shm_face.h"
+
+#include <boost/bind.hpp>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "../log/logger.h"
+
+ShmFace::ShmFace(boost::asio::io_service &ios, const std::string &path)
+        : Face(ios)
+        , _skip_connect(false)
+        , _endpoint(path)
+        , _socket(ios)
+        , _strand(ios)
+        , _fds{-1, -1, -1}
+        , _rx_event(ios)
+        , _timer(ios) {
+
+}
+
+ShmFace::ShmFace(boost::asio::local::stream_protocol::socket &&socket, const int fds[DESCRIPTORS])
+        : Face(socket.get_io_service())
+        , _skip_connect(true)
+        , _endpoint(socket.local_endpoint())
+        , _socket(std::move(socket))
+        , _strand(socket.get_io_service())
+        , _fds{fds[MEMORY], fds[CLIENT_TO_MASTER_EVENT], fds[MASTER_TO_CLIENT_EVENT]}
+        , _rx_event(socket.get_io_service())
+        , _timer(socket.get_io_service()) {
+
+}
+
+ShmFace::~ShmFace() {
+    if (_memory) {
+        ::munmap(_memory, 2 * ShmRing::REGION_SIZE);
+    }
+    for (int fd : _fds) {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+    if (_tx_event_fd >= 0) {
+        ::close(_tx_event_fd);
+    }
+}
+
+void ShmFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats ShmFace::getTxQueueStats() const {
+    return _queue.getStats();
+}
+
+std::string ShmFace::getUnderlyingProtocol() const {
+    return "SHM";
+}
+
+std::string ShmFace::getUnderlyingEndpoint() const {
+    std::stringstream ss;
+    ss << _endpoint;
+    return ss.str();
+}
+
+void ShmFace::open(const InterestCallback &interest_callback,
+                   const DataCallback &data_callback,
+                   const ErrorCallback &error_callback) {
+    _interest_callback = interest_callback;
+    _data_callback = data_callback;
+    _error_callback = error_callback;
+    if (!_skip_connect) {
+        if (!createMemory() || !mapMemory(false)) {
+            std::stringstream ss;
+            ss << "failed to create the shared memory of face with ID = " << _face_id << ": " << std::strerror(errno);
+            logger::log(logger::ERROR, ss.str());
+            _error_callback(shared_from_this());
+            return;
+        }
+        _socket.async_connect(_endpoint, _strand.wrap(boost::bind(&ShmFace::connectHandler, shared_from_this(), _1)));
+    } else if (mapMemory(true)) {
+        start();
+    } else {
+        std::stringstream ss;
+        ss << "failed to map the shared memory of face with ID = " << _face_id << ": " << std::strerror(errno);
+        logger::log(logger::ERROR, ss.str());
+        _error_callback(shared_from_this());
+    }
+}
+
+void ShmFace::close() {
+    _is_connected = false;
+    _socket.close();
+    _rx_event.close();
+    _timer.cancel();
+}
+
+void ShmFace::send(const std::string &message) {
+    _strand.dispatch(boost::bind(&ShmFace::sendImpl, shared_from_this(), std::make_shared<const ndn::Buffer>(message.c_str(), message.length())));
+}
+
+void ShmFace::send(const ndn::Interest &interest) {
+    _strand.dispatch(boost::bind(&ShmFace::sendImpl, shared_from_this(), interest.wireEncode().getBuffer()));
+}
+
+void ShmFace::send(const ndn::Data &data) {
+    _strand.dispatch(boost::bind(&ShmFace::sendImpl, shared_from_this(), data.wireEncode().getBuffer()));
+}
+
+bool ShmFace::receiveDescriptors(boost::asio::local::stream_protocol::socket &socket, int fds[DESCRIPTORS]) {
+    char byte;
+    iovec iov = {&byte, sizeof(byte)};
+    char control[CMSG_SPACE(sizeof(int) * DESCRIPTORS)];
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (::recvmsg(socket.native_handle(), &msg, MSG_CMSG_CLOEXEC) <= 0) {
+        return false;
+    }
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+        return false;
+    }
+    if (cmsg->cmsg_len != CMSG_LEN(sizeof(int) * DESCRIPTORS)) {
+        // close whatever was received so the descriptors do not leak
+        size_t received = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        for (size_t i = 0; i < received; ++i) {
+            ::close(((int*)CMSG_DATA(cmsg))[i]);
+        }
+        return false;
+    }
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * DESCRIPTORS);
+    return true;
+}
+
+bool ShmFace::createMemory() {
+    _fds[MEMORY] = ::memfd_create("ndn-shm-face", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (_fds[MEMORY] < 0 || ::ftruncate(_fds[MEMORY], 2 * ShmRing::REGION_SIZE) != 0
+        || ::fcntl(_fds[MEMORY], F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) != 0) {
+        return false;
+    }
+    _fds[CLIENT_TO_MASTER_EVENT] = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    _fds[MASTER_TO_CLIENT_EVENT] = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    return _fds[CLIENT_TO_MASTER_EVENT] >= 0 && _fds[MASTER_TO_CLIENT_EVENT] >= 0;
+}
+
+bool ShmFace::mapMemory(bool master) {
+    if (master) {
+        // the memory comes from the peer, an access past its end would raise SIGBUS so it must be long enough and
+        // sealed against shrinking
+        struct stat info;
+        int seals = ::fcntl(_fds[MEMORY], F_GET_SEALS);
+        if (::fstat(_fds[MEMORY], &info) != 0 || (size_t)info.st_size < 2 * ShmRing::REGION_SIZE
+            || seals < 0 || (seals & F_SEAL_SHRINK) == 0) {
+            errno = EINVAL;
+            return false;
+        }
+    }
+    _memory = ::mmap(nullptr, 2 * ShmRing::REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, _fds[MEMORY], 0);
+    if (_memory == MAP_FAILED) {
+        _memory = nullptr;
+        return false;
+    }
+    // the first ring carries the packets from the connecting face to the master, the second one the other way
+    void *client_to_master = _memory;
+    void *master_to_client = (char*)_memory + ShmRing::REGION_SIZE;
+    _rx_ring.reset(new ShmRing(master ? client_to_master : master_to_client));
+    _tx_ring.reset(new ShmRing(master ? master_to_client : client_to_master));
+    Descriptor rx = master ? CLIENT_TO_MASTER_EVENT : MASTER_TO_CLIENT_EVENT;
+    Descriptor tx = master ? MASTER_TO_CLIENT_EVENT : CLIENT_TO_MASTER_EVENT;
+    _rx_event.assign(_fds[rx]);
+    _tx_event_fd = _fds[tx];
+    _fds[rx] = -1;
+    _fds[tx] = -1;
+    return true;
+}
+
+void ShmFace::connectHandler(const boost::system::error_code &err) {
+    if (err) {
+        std::stringstream ss;
+        ss << "failed to connect to " << _endpoint;
+        logger::log(logger::ERROR, ss.str());
+        _error_callback(shared_from_this());
+        return;
+    }
+    int fds[DESCRIPTORS];
+    fds[MEMORY] = _fds[MEMORY];
+    fds[CLIENT_TO_MASTER_EVENT] = _tx_event_fd;
+    fds[MASTER_TO_CLIENT_EVENT] = _rx_event.native_handle();
+    char byte = 0;
+    iovec iov = {&byte, sizeof(byte)};
+    char control[CMSG_SPACE(sizeof(fds))] = {};
+    msghdr msg = {};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+    if (::sendmsg(_socket.native_handle(), &msg, MSG_NOSIGNAL) != sizeof(byte)) {
+        std::stringstream ss;
+        ss << "failed to send the shared memory to " << _endpoint << ": " << std::strerror(errno);
+        logger::log(logger::ERROR, ss.str());
+        _error_callback(shared_from_this());
+        return;
+    }
+    // the mapping stays valid without its descriptor
+    ::close(_fds[MEMORY]);
+    _fds[MEMORY] = -1;
+    std::stringstream ss;
+    ss << "SHM face with ID = " << _face_id << " successfully connected to shm://" << _endpoint;
+    logger::log(logger::INFO, ss.str());
+    start();
+}
+
+void ShmFace::start() {
+    if (_fds[MEMORY] >= 0) {
+        ::close(_fds[MEMORY]);
+        _fds[MEMORY] = -1;
+    }
+    _is_connected = true;
+    _socket.async_read_some(boost::asio::buffer(_control_buffer, sizeof(_control_buffer)),
+                            _strand.wrap(boost::bind(&ShmFace::controlHandler, shared_from_this(), _1, _2)));
+    wait();
+    // packets sent before the connection was made
+    flush();
+}
+
+void ShmFace::controlHandler(const boost::system::error_code &err, size_t bytes_transferred) {
+    if (!err) {
+        _socket.async_read_some(boost::asio::buffer(_control_buffer, sizeof(_control_buffer)),
+                                _strand.wrap(boost::bind(&ShmFace::controlHandler, shared_from_this(), _1, _2)));
+    } else if (_is_connected) {
+        std::stringstream ss;
+        ss << "lost connection to shm://" << _endpoint;
+        logger::log(logger::WARNING, ss.str());
+        _error_callback(shared_from_this());
+    }
+}
+
+void ShmFace::wait() {
+    if (_rx_ring->prepareWait()) {
+        _rx_event.async_read_some(boost::asio::buffer(&_event_buffer, sizeof(_event_buffer)),
+                                  _strand.wrap(boost::bind(&ShmFace::waitHandler, shared_from_this(), _1, _2)));
+    } else {
+        _strand.post(boost::bind(&ShmFace::drain, shared_from_this()));
+    }
+}
+
+void ShmFace::waitHandler(const boost::system::error_code &err, size_t bytes_transferred) {
+    if (!err) {
+        drain();
+    }
+}
+
+void ShmFace::drain() {
+    if (!_is_connected) {
+        return;
+    }
+    size_t popped = _rx_ring->pop([this](const uint8_t *packet, size_t size) {
+        onPacket(packet, size);
+    }, BATCH_SIZE);
+    if (_rx_ring->isCorrupted()) {
+        std::stringstream ss;
+        ss << "corrupted ring on face with ID = " << _face_id << ", closing it";
+        logger::log(logger::ERROR, ss.str());
+        close();
+        _error_callback(shared_from_this());
+    } else if (popped == BATCH_SIZE) {
+        _strand.post(boost::bind(&ShmFace::drain, shared_from_this()));
+    } else {
+        wait();
+    }
+}
+
+void ShmFace::onPacket(const uint8_t *packet, size_t size) {
+    try {
+        switch (packet[0]) {
+            case 0x05:
+                _interest_callback(shared_from_this(), ndn::Interest(ndn::Block(packet, size)));
+                break;
+            case 0x06:
+                _data_callback(shared_from_this(), ndn::Data(ndn::Block(packet, size)));
+                break;
+            default:
+                break;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+    }
+}
+
+void ShmFace::sendImpl(std::shared_ptr<const ndn::Buffer> &buffer) {
+    if (buffer->size() > NDN_MAX_PACKET_SIZE) {
+        return;
+    }
+    size_t size = buffer->size();
+    bool is_data = size > 0 && (*buffer)[0] == 0x06;
+    bool queued = _queue.push(std::move(buffer), size, is_data);
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (queued && _queue.size() == 1) {
+        flush();
+    }
+}
+
+void ShmFace::flush() {
+    if (!_is_connected) {
+        return;
+    }
+    bool pushed = false;
+    while (!_queue.empty() && _tx_ring->push(_queue.front()->data(), _queue.front()->size())) {
+        _queue.pop();
+        pushed = true;
+    }
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (pushed && _tx_ring->needsWakeup()) {
+        uint64_t one = 1;
+        if (::write(_tx_event_fd, &one, sizeof(one)) < 0) {
+            std::cerr << std::strerror(errno) << std::endl;
+        }
+    }
+    if (!_queue.empty()) {
+        // the ring is full, the peer is behind
+        _timer.expires_from_now(boost::posix_time::milliseconds(1));
+        _timer.async_wait(_strand.wrap(boost::bind(&ShmFace::timerHandler, shared_from_this(), _1)));
+    }
+}
+
+void ShmFace::timerHandler(const boost::system::error_code &err) {
+    if (!err) {
+        flush();
+    }
+}
\ No newline at end of file
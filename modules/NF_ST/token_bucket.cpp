@@ -0,0 +1,32 @@
+#include "token_bucket.h"
+
+#include <algorithm>
+
+TokenBucket::TokenBucket(double rate, double burst)
+        : _rate(rate)
+        , _burst(std::max(burst, 1.0))
+        , _tokens(_burst)
+        , _last_refill(std::chrono::steady_clock::now()) {
+
+}
+
+double TokenBucket::getRate() const {
+    return _rate;
+}
+
+double TokenBucket::getBurst() const {
+    return _burst;
+}
+
+bool TokenBucket::consume(const std::chrono::steady_clock::time_point &now) {
+    if (now > _last_refill) {
+        std::chrono::duration<double> elapsed = now - _last_refill;
+        _tokens = std::min(_burst, _tokens + elapsed.count() * _rate);
+        _last_refill = now;
+    }
+    if (_tokens >= 1.0) {
+        _tokens -= 1.0;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <chrono>
+
+// Token bucket refilled lazily from the elapsed time at each packet, no timer involved.
+class TokenBucket {
+private:
+    double _rate;
+    double _burst;
+    double _tokens;
+    std::chrono::steady_clock::time_point _last_refill;
+
+public:
+    TokenBucket(double rate, double burst);
+
+    ~TokenBucket() = default;
+
+    double getRate() const;
+
+    double getBurst() const;
+
+    bool consume(const std::chrono::steady_clock::time_point &now);
+};
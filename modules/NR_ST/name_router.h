@@ -38,10 +38,14 @@ class NameRouter : public Module {
     std::shared_ptr<MasterFace> _tcp_consumer_master_face;
     std::shared_ptr<MasterFace> _tcp_producer_master_face;
     std::shared_ptr<MasterFace> _udp_consumer_master_face;
+    std::shared_ptr<MasterFace> _unix_consumer_master_face;
+    std::shared_ptr<MasterFace> _shm_consumer_master_face;
     std::shared_ptr<MasterFace> _udp_producer_master_face;
+    std::shared_ptr<MasterFace> _unix_producer_master_face;
+    std::shared_ptr<MasterFace> _shm_producer_master_face;
 
 public:
-    NameRouter(const std::string &name, uint16_t local_consumer_port, uint16_t local_producer_port, uint16_t local_command_port);
+    NameRouter(const std::string &name, uint16_t local_consumer_port, uint16_t local_producer_port, uint16_t local_command_port, size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION);
 
     ~NameRouter() override = default;
 
@@ -65,6 +69,8 @@ public:
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
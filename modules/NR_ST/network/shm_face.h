@@ -0,0 +1,107 @@
+#pragma once
+
+#include "concurrency.h"
+#include "face.h"
+
+#include <boost/asio.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include "shm_ring.h"
+
+// Face over two rings in a memfd shared with a module on the same host, one ring per direction, each with an
+// eventfd to wake its consumer up. The face that connects creates the memory and the eventfds and hands them to
+// the ShmMasterFace over its Unix socket, which then stays open only to notice when the peer goes away. Packets
+// are copied once into the ring and handed to the callbacks straight from the shared memory on the other side.
+class ShmFace : public Face, public std::enable_shared_from_this<ShmFace> {
+public:
+    static const size_t NDN_MAX_PACKET_SIZE = 8800;
+    // packets handled per wakeup before yielding to the other handlers of the io_service
+    static const size_t BATCH_SIZE = 64;
+
+    // file descriptors sent by the connecting face, in this order
+    enum Descriptor {
+        MEMORY = 0,
+        CLIENT_TO_MASTER_EVENT,
+        MASTER_TO_CLIENT_EVENT,
+        DESCRIPTORS,
+    };
+
+private:
+    bool _skip_connect;
+
+    boost::asio::local::stream_protocol::endpoint _endpoint;
+    boost::asio::local::stream_protocol::socket _socket;
+    Strand _strand;
+    char _control_buffer[1];
+
+    int _fds[DESCRIPTORS];
+    void *_memory = nullptr;
+    std::unique_ptr<ShmRing> _rx_ring;
+    std::unique_ptr<ShmRing> _tx_ring;
+    boost::asio::posix::stream_descriptor _rx_event;
+    int _tx_event_fd = -1;
+    uint64_t _event_buffer;
+
+    // packets waiting for room in a full ring
+    TxQueue<std::shared_ptr<const ndn::Buffer>> _queue;
+
+    boost::asio::deadline_timer _timer;
+
+public:
+    // use this when creating a face yourself, path is the socket of a ShmMasterFace
+    ShmFace(boost::asio::io_service &ios, const std::string &path);
+
+    // specific constructor for ShmMasterFace, takes the ownership of the descriptors
+    ShmFace(boost::asio::local::stream_protocol::socket &&socket, const int fds[DESCRIPTORS]);
+
+    ~ShmFace() override;
+
+    void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+    TxQueueStats getTxQueueStats() const override;
+
+    std::string getUnderlyingProtocol() const override;
+
+    std::string getUnderlyingEndpoint() const override;
+
+    void open(const InterestCallback &interest_callback, const DataCallback &data_callback, const ErrorCallback &error_callback) override;
+
+    void close() override;
+
+    void send(const std::string &message) override;
+
+    void send(const ndn::Interest &interest) override;
+
+    void send(const ndn::Data &data) override;
+
+    // receives the descriptors sent by the connecting face, returns false if the message does not carry them
+    static bool receiveDescriptors(boost::asio::local::stream_protocol::socket &socket, int fds[DESCRIPTORS]);
+
+private:
+    bool createMemory();
+
+    bool mapMemory(bool master);
+
+    void connectHandler(const boost::system::error_code &err);
+
+    void start();
+
+    void controlHandler(const boost::system::error_code &err, size_t bytes_transferred);
+
+    void wait();
+
+    void waitHandler(const boost::system::error_code &err, size_t bytes_transferred);
+
+    void drain();
+
+    void onPacket(const uint8_t *packet, size_t size);
+
+    void sendImpl(std::shared_ptr<const ndn::Buffer> &buffer);
+
+    void flush();
+
+    void timerHandler(const boost::system::error_code &err);
+};
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "master_face.h"
+
+#include <boost/asio.hpp>
+
+#include <unordered_set>
+
+#include "shm_face.h"
+
+// Accepts ShmFace connections on a socket path, a connection becomes a face once it has received the shared memory
+// and the eventfds of the connecting face.
+class ShmMasterFace : public MasterFace, public std::enable_shared_from_this<ShmMasterFace> {
+private:
+    std::string _path;
+    boost::asio::local::stream_protocol::socket _socket;
+    boost::asio::local::stream_protocol::acceptor _acceptor;
+    std::unordered_set<std::shared_ptr<Face>> _faces;
+
+public:
+    ShmMasterFace(boost::asio::io_service &ios, size_t max_connection, const std::string &path);
+
+    ~ShmMasterFace() override = default;
+
+    // path of the socket a module listens on, UnixMasterFace::RUNTIME_DIRECTORY/<name>.shm
+    static std::string getSocketPath(const std::string &name);
+
+    std::string getUnderlyingProtocol() const override;
+
+    void listen(const NotificationCallback &notification_callback, const Face::InterestCallback &interest_callback,
+                const Face::DataCallback &data_callback, const ErrorCallback &error_callback) override;
+
+    void close() override;
+
+    void sendToAllFaces(const std::string &message) override;
+
+    void sendToAllFaces(const ndn::Interest &interest) override;
+
+    void sendToAllFaces(const ndn::Data &data) override;
+
+private:
+    void accept();
+
+    void acceptHandler(const boost::system::error_code &err);
+
+    void handshakeHandler(const std::shared_ptr<boost::asio::local::stream_protocol::socket> &socket,
+                          const boost::system::error_code &err);
+
+    void onFaceError(const std::shared_ptr<Face> &face);
+};
\ No newline at end of file
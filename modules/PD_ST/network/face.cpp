@@ -1,3 +1,21 @@
 #include "face.h"
 
-size_t Face::counter = 0;
\ No newline at end of file
+#include <sstream>
+
+#include "../log/logger.h"
+
+size_t Face::counter = 0;
+
+void Face::updateCongestion(const std::shared_ptr<Face> &face, bool congested) {
+    if (_is_congested.exchange(congested, std::memory_order_relaxed) == congested) {
+        return;
+    }
+    TxQueueStats stats = getTxQueueStats();
+    std::stringstream ss;
+    ss << "face with ID = " << _face_id << (congested ? " started" : " stopped") << " dropping packets, "
+       << stats.packets << " packets and " << stats.bytes << " bytes queued, " << stats.dropped_packets << " packets dropped";
+    logger::log(congested ? logger::WARNING : logger::INFO, ss.str());
+    if (_congestion_callback) {
+        _congestion_callback(face, congested);
+    }
+}
@@ -0,0 +1,174 @@
+#include "lp_reassembler.h"
+
+LpReassembler::LpReassembler(Clock::duration timeout)
+        : _timeout(timeout) {
+
+}
+
+bool LpReassembler::receive(const char *datagram, size_t datagram_size, const char *&packet, size_t &size) {
+    if (datagram_size == 0 || (uint8_t)datagram[0] != 0x64) {
+        packet = datagram;
+        size = datagram_size;
+        return true;
+    }
+    const char *it = datagram;
+    const char *end = datagram + datagram_size;
+    uint64_t type, length;
+    if (!readVarNumber(it, end, type) || !readVarNumber(it, end, length) || length > (uint64_t)(end - it)) {
+        return false;
+    }
+    end = it + length;
+    uint64_t sequence = 0;
+    uint64_t index = 0;
+    uint64_t count = 1;
+    bool has_sequence = false;
+    const char *fragment = nullptr;
+    uint64_t fragment_size = 0;
+    while (it < end) {
+        if (!readVarNumber(it, end, type) || !readVarNumber(it, end, length) || length > (uint64_t)(end - it)) {
+            return false;
+        }
+        switch (type) {
+            case 0x50:
+                fragment = it;
+                fragment_size = length;
+                break;
+            case 0x51:
+                if (length != 8 || !readNonNegativeInteger(it, length, sequence)) {
+                    return false;
+                }
+                has_sequence = true;
+                break;
+            case 0x52:
+                if (!readNonNegativeInteger(it, length, index)) {
+                    return false;
+                }
+                break;
+            case 0x53:
+                if (!readNonNegativeInteger(it, length, count)) {
+                    return false;
+                }
+                break;
+            case 0x0320:
+                // nacks aren't supported, the Interest they carry must not be taken for a new one
+                return false;
+            default:
+                // the other header fields are only used hop by hop, those that can't be ignored drop the packet
+                if (type < 800 || type > 959 || (type & 0x03) != 0) {
+                    return false;
+                }
+                break;
+        }
+        it += length;
+    }
+    if (!fragment || fragment_size == 0) {
+        return false;
+    }
+    if (count <= 1) {
+        packet = fragment;
+        size = fragment_size;
+        return true;
+    }
+    if (!has_sequence || index >= count || count > MAX_FRAGMENTS) {
+        return false;
+    }
+
+    Clock::time_point now = Clock::now();
+    expire(now);
+    uint64_t first_sequence = sequence - index;
+    auto partial_packet = _partial_packets.find(first_sequence);
+    if (partial_packet == _partial_packets.end()) {
+        if (_partial_packets.size() >= MAX_PARTIAL_PACKETS) {
+            auto oldest = _partial_packets.begin();
+            for (auto candidate = _partial_packets.begin(); candidate != _partial_packets.end(); ++candidate) {
+                if (candidate->second.expiry < oldest->second.expiry) {
+                    oldest = candidate;
+                }
+            }
+            _partial_packets.erase(oldest);
+        }
+        partial_packet = _partial_packets.emplace(first_sequence, PartialPacket{std::vector<std::string>(count), 0, 0, now + _timeout}).first;
+    }
+    PartialPacket &entry = partial_packet->second;
+    if (entry.fragments.size() != count || entry.size + fragment_size > MAX_PACKET_SIZE) {
+        _partial_packets.erase(partial_packet);
+        return false;
+    }
+    if (!entry.fragments[index].empty()) {
+        // duplicate
+        return false;
+    }
+    entry.fragments[index].assign(fragment, fragment_size);
+    entry.size += fragment_size;
+    if (++entry.received < count) {
+        return false;
+    }
+    _packet.clear();
+    _packet.reserve(entry.size);
+    for (const auto &piece : entry.fragments) {
+        _packet += piece;
+    }
+    _partial_packets.erase(partial_packet);
+    packet = _packet.data();
+    size = _packet.size();
+    return true;
+}
+
+bool LpReassembler::unpack(const char *&it, const char *end, const char *&packet, size_t &size) {
+    while (it < end) {
+        const char *element = it;
+        const char *value = it;
+        uint64_t type, length;
+        if (!readVarNumber(value, end, type) || !readVarNumber(value, end, length) || length > (uint64_t)(end - value)) {
+            // not a TLV element, the rest of the datagram is taken as a single packet
+            it = end;
+            return receive(element, end - element, packet, size);
+        }
+        it = value + length;
+        if (receive(element, it - element, packet, size)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t LpReassembler::getPartialPacketCount() const {
+    return _partial_packets.size();
+}
+
+void LpReassembler::expire(Clock::time_point now) {
+    for (auto it = _partial_packets.begin(); it != _partial_packets.end();) {
+        if (it->second.expiry <= now) {
+            it = _partial_packets.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool LpReassembler::readVarNumber(const char *&it, const char *end, uint64_t &number) {
+    if (it >= end) {
+        return false;
+    }
+    uint8_t first = (uint8_t)*it++;
+    size_t size = first < 253 ? 0 : first == 253 ? 2 : first == 254 ? 4 : 8;
+    if ((size_t)(end - it) < size) {
+        return false;
+    }
+    number = size ? 0 : first;
+    for (size_t i = 0; i < size; ++i) {
+        number = (number << 8) | (uint8_t)*it++;
+    }
+    return true;
+}
+
+bool LpReassembler::readNonNegativeInteger(const char *it, uint64_t length, uint64_t &number) {
+    if (length != 1 && length != 2 && length != 4 && length != 8) {
+        return false;
+    }
+    number = 0;
+    for (uint64_t i = 0; i < length; ++i) {
+        number = (number << 8) | (uint8_t)it[i];
+    }
+    return true;
+}
@@ -7,6 +7,9 @@
 
 class MasterFace {
 public:
+    // faces a master face accepts unless told otherwise
+    static const size_t DEFAULT_MAX_CONNECTION = 4096;
+
     using NotificationCallback = std::function<void(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face>&)>;
     using ErrorCallback = std::function<void(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face>&)>;
 
@@ -24,6 +27,8 @@ protected:
     Face::InterestCallback _interest_callback;
     Face::DataCallback _data_callback;
     ErrorCallback _error_callback;
+    Face::CongestionCallback _congestion_callback;
+    TxQueueLimits _tx_queue_limits;
 
 public:
     MasterFace(boost::asio::io_service &ios, size_t max_connection) : _master_face_id(++counter), _ios(ios), _max_connection(max_connection) {
@@ -40,6 +45,15 @@ public:
         return _master_face_id;
     }
 
+    // both apply to the faces accepted from then on
+    void setCongestionCallback(const Face::CongestionCallback &congestion_callback) {
+        _congestion_callback = congestion_callback;
+    }
+
+    void setTxQueueLimits(const TxQueueLimits &limits) {
+        _tx_queue_limits = limits;
+    }
+
     virtual std::string getUnderlyingProtocol() const = 0;
 
     virtual void listen(const NotificationCallback &notification_callback, const Face::InterestCallback &interest_callback,
@@ -52,4 +66,10 @@ public:
     virtual void sendToAllFaces(const ndn::Interest &interest) = 0;
 
     virtual void sendToAllFaces(const ndn::Data &data) = 0;
+
+protected:
+    void prepareFace(const std::shared_ptr<Face> &face) {
+        face->setTxQueueLimits(_tx_queue_limits);
+        face->setCongestionCallback(_congestion_callback);
+    }
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "concurrency.h"
 #include "face.h"
+#include "tlv_framer.h"
 
 #include <boost/asio.hpp>
 
@@ -13,19 +15,18 @@
 class TcpFace : public Face, public std::enable_shared_from_this<TcpFace> {
 public:
     static const size_t NDN_MAX_PACKET_SIZE = 8800;
-    static const size_t BUFFER_SIZE = 1 << 15; // 16k
+    static const size_t BUFFER_SIZE = 1 << 15;
 
 private:
     bool _skip_connect;
 
     boost::asio::ip::tcp::endpoint _endpoint;
     boost::asio::ip::tcp::socket _socket;
-    boost::asio::strand _strand;
-    char _buffer[BUFFER_SIZE];
-    size_t _buffer_size = 0;
+    Strand _strand;
+    TlvFramer _framer;
     std::string _stream;
     bool _queue_in_use = false;
-    std::deque<std::shared_ptr<const ndn::Buffer>> _queue;
+    TxQueue<std::shared_ptr<const ndn::Buffer>> _queue;
 
     boost::asio::deadline_timer _timer;
 
@@ -40,6 +41,10 @@ public:
 
     ~TcpFace() override = default;
 
+    void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+    TxQueueStats getTxQueueStats() const override;
+
     std::string getUnderlyingProtocol() const override;
 
     std::string getUnderlyingEndpoint() const override;
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "master_face.h"
+
+#include <boost/asio.hpp>
+
+#include <unordered_set>
+
+#include "unix_face.h"
+
+// Accepts UnixFace connections on a socket path. The path is bound when listening and a failure is only logged,
+// so a module keeps running over TCP and UDP when its runtime directory is not writable.
+class UnixMasterFace : public MasterFace, public std::enable_shared_from_this<UnixMasterFace> {
+public:
+    // created 0700, only the user running the modules may connect to their sockets
+    static const std::string RUNTIME_DIRECTORY;
+
+private:
+    std::string _path;
+    boost::asio::local::stream_protocol::socket _socket;
+    boost::asio::local::stream_protocol::acceptor _acceptor;
+    std::unordered_set<std::shared_ptr<Face>> _faces;
+
+public:
+    UnixMasterFace(boost::asio::io_service &ios, size_t max_connection, const std::string &path);
+
+    ~UnixMasterFace() override = default;
+
+    // path of the socket a module listens on, RUNTIME_DIRECTORY/<name>.sock
+    static std::string getSocketPath(const std::string &name);
+
+    std::string getUnderlyingProtocol() const override;
+
+    void listen(const NotificationCallback &notification_callback, const Face::InterestCallback &interest_callback,
+                const Face::DataCallback &data_callback, const ErrorCallback &error_callback) override;
+
+    void close() override;
+
+    void sendToAllFaces(const std::string &message) override;
+
+    void sendToAllFaces(const ndn::Interest &interest) override;
+
+    void sendToAllFaces(const ndn::Data &data) override;
+
+private:
+    void accept();
+
+    void acceptHandler(const boost::system::error_code &err);
+
+    void onFaceError(const std::shared_ptr<Face> &face);
+};
\ No newline at end of file
@@ -8,6 +8,8 @@
 #include "network/tcp_face.h"
 #include "network/udp_master_face.h"
 #include "network/udp_face.h"
+#include "network/unix_face.h"
+#include "network/shm_face.h"
 #include "log/logger.h"
 
 size_t PacketDispatcher::Session::session_count = 0;
@@ -18,11 +20,19 @@ PacketDispatcher::Session::Session(PacketDispatcher &packet_dispatcher, boost::a
     _bidirectionnal_face = std::make_shared<TcpFace>(std::move(socket));
     if(packet_dispatcher._consumer_layer == "udp") {
         _consumer_face = std::make_shared<UdpFace>(_packet_dispatcher._ios, _packet_dispatcher._consumer_remote_ip, _packet_dispatcher._consumer_remote_port);
+    } else if(packet_dispatcher._consumer_layer == "unix") {
+        _consumer_face = std::make_shared<UnixFace>(_packet_dispatcher._ios, _packet_dispatcher._consumer_remote_ip);
+    } else if(packet_dispatcher._consumer_layer == "shm") {
+        _consumer_face = std::make_shared<ShmFace>(_packet_dispatcher._ios, _packet_dispatcher._consumer_remote_ip);
     } else {
         _consumer_face = std::make_shared<TcpFace>(_packet_dispatcher._ios, _packet_dispatcher._consumer_remote_ip, _packet_dispatcher._consumer_remote_port);
     }
     if(packet_dispatcher._producer_layer == "udp") {
         _producer_face = std::make_shared<UdpFace>(_packet_dispatcher._ios, _packet_dispatcher._producer_remote_ip, _packet_dispatcher._producer_remote_port);
+    } else if(packet_dispatcher._producer_layer == "unix") {
+        _producer_face = std::make_shared<UnixFace>(_packet_dispatcher._ios, _packet_dispatcher._producer_remote_ip);
+    } else if(packet_dispatcher._producer_layer == "shm") {
+        _producer_face = std::make_shared<ShmFace>(_packet_dispatcher._ios, _packet_dispatcher._producer_remote_ip);
     } else {
         _producer_face = std::make_shared<TcpFace>(_packet_dispatcher._ios, _packet_dispatcher._producer_remote_ip, _packet_dispatcher._producer_remote_port);
     }
@@ -189,6 +199,17 @@ void PacketDispatcher::commandEditConfig(const rapidjson::Document &document) {
             changes.emplace_back(R"("producer_path")");
         }
     }
+    // tcp by default, the address of a unix or shm path is the socket path of the next module
+    if (document.HasMember("consumer_path_layer") && document["consumer_path_layer"].IsString()
+        && _consumer_layer != document["consumer_path_layer"].GetString()) {
+        _consumer_layer = document["consumer_path_layer"].GetString();
+        changes.emplace_back(R"("consumer_path_layer")");
+    }
+    if (document.HasMember("producer_path_layer") && document["producer_path_layer"].IsString()
+        && _producer_layer != document["producer_path_layer"].GetString()) {
+        _producer_layer = document["producer_path_layer"].GetString();
+        changes.emplace_back(R"("producer_path_layer")");
+    }
     if (document.HasMember("id") && document["id"].IsUint()) {
         _module_id = document["id"].GetUint();
         id_set = true;
@@ -0,0 +1,86 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "../epoch_manager.h"
+
+// Stress test of the epoch based reclamation the router uses for its forwarding snapshot: reader threads load the
+// published snapshot inside a Guard and check its content while a writer swaps it and retires the old one. A retired
+// snapshot is poisoned before being deleted, a reader seeing the poison means it was reclaimed too early. Building it
+// with -fsanitize=address also reports the reads of a freed snapshot.
+//   usage: epoch_bench [swaps]
+static const size_t READERS = 4;
+static const size_t SNAPSHOT_SIZE = 16;
+static const uint64_t ALIVE = 0x5ca1ab1e;
+
+struct Snapshot {
+    uint64_t magic = ALIVE;
+    uint64_t version;
+    std::vector<uint64_t> values;
+
+    explicit Snapshot(uint64_t version) : version(version), values(SNAPSHOT_SIZE, version) {
+
+    }
+};
+
+int main(int argc, char *argv[]) {
+    size_t swaps = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    EpochManager epoch_manager;
+    std::atomic<Snapshot*> snapshot {new Snapshot(0)};
+    std::atomic<bool> is_running {true};
+    std::atomic<size_t> started {0};
+    std::atomic<size_t> reads {0};
+    std::atomic<size_t> errors {0};
+
+    std::vector<std::thread> readers;
+    for (size_t i = 0; i < READERS; ++i) {
+        readers.emplace_back([&]() {
+            size_t count = 0;
+            uint64_t last_version = 0;
+            started.fetch_add(1);
+            while (is_running.load(std::memory_order_relaxed)) {
+                EpochManager::Guard guard(epoch_manager);
+                const Snapshot *current = snapshot.load(std::memory_order_acquire);
+                bool is_valid = current->magic == ALIVE && current->version >= last_version;
+                for (uint64_t value : current->values) {
+                    is_valid = is_valid && value == current->version;
+                }
+                if (!is_valid) {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                }
+                last_version = current->version;
+                ++count;
+            }
+            reads.fetch_add(count, std::memory_order_relaxed);
+        });
+    }
+
+    // the swaps only stress the reclamation while every reader is running
+    while (started.load() < READERS) {
+        std::this_thread::yield();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t version = 1; version <= swaps; ++version) {
+        Snapshot *old_snapshot = snapshot.exchange(new Snapshot(version), std::memory_order_acq_rel);
+        epoch_manager.retire([old_snapshot]() {
+            old_snapshot->magic = 0;
+            old_snapshot->values.assign(SNAPSHOT_SIZE, 0);
+            delete old_snapshot;
+        });
+    }
+    auto end = std::chrono::steady_clock::now();
+    is_running.store(false);
+    for (auto &reader : readers) {
+        reader.join();
+    }
+    delete snapshot.load();
+
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    std::cout << READERS << " readers, " << swaps << " swaps: " << (uint64_t)(swaps / elapsed) << " swaps/s, "
+              << (uint64_t)(reads.load() / elapsed) << " reads/s, " << errors.load() << " reclaimed too early"
+              << std::endl;
+    return errors.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../network/tlv_framer.h"
+
+// Measures how fast a stream face cuts its input into packets, TlvFramer against the former parser of the TCP and
+// Unix faces (byte by byte, leftover copied to the front after every read). The stream is a capture given on the
+// command line or a synthetic one mixing Interests, Data and garbage, replayed until the requested size is reached
+// and fed in reads of random sizes.
+//   usage: framer_bench [gigabytes] [capture]
+static const size_t NDN_MAX_PACKET_SIZE = 8800;
+static const size_t BUFFER_SIZE = 1 << 15;
+static const size_t SYNTHETIC_SIZE = 64 << 20;
+
+static void appendPacket(std::string &stream, char type, size_t length) {
+    stream.push_back(type);
+    if (length < 253) {
+        stream.push_back((char)length);
+    } else {
+        stream.push_back((char)0xFD);
+        stream.push_back((char)(length >> 8));
+        stream.push_back((char)length);
+    }
+    stream.append(length, 'x');
+}
+
+static std::string makeStream(std::mt19937 &generator) {
+    std::uniform_int_distribution<size_t> kind_distribution(0, 999);
+    std::uniform_int_distribution<size_t> interest_distribution(40, 200);
+    std::uniform_int_distribution<size_t> data_distribution(200, 8000);
+    std::uniform_int_distribution<size_t> garbage_distribution(1, 4096);
+    std::string stream;
+    stream.reserve(SYNTHETIC_SIZE + NDN_MAX_PACKET_SIZE);
+    while (stream.size() < SYNTHETIC_SIZE) {
+        size_t kind = kind_distribution(generator);
+        if (kind == 0) {
+            // a burst of bytes to resynchronize on
+            stream.append(garbage_distribution(generator), (char)0xAA);
+        } else if (kind < 600) {
+            appendPacket(stream, 0x05, interest_distribution(generator));
+        } else {
+            appendPacket(stream, 0x06, data_distribution(generator));
+        }
+    }
+    return stream;
+}
+
+struct Result {
+    size_t packets = 0;
+    size_t checksum = 0;
+};
+
+static Result runFramer(const std::string &stream, const std::vector<size_t> &reads, size_t total) {
+    TlvFramer framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE);
+    Result result;
+    size_t offset = 0;
+    for (size_t fed = 0, i = 0; fed < total; ++i) {
+        char *buffer = framer.prepare();
+        size_t size = std::min(std::min(reads[i % reads.size()], framer.getFreeSize()), stream.size() - offset);
+        std::memcpy(buffer, stream.data() + offset, size);
+        offset = (offset + size) % stream.size();
+        fed += size;
+        framer.commit(size);
+        result.packets += framer.extract([&result](const char *packet, size_t packet_size) {
+            result.checksum += packet_size + (uint8_t)packet[0];
+        });
+    }
+    return result;
+}
+
+static Result runLegacy(const std::string &stream, const std::vector<size_t> &reads, size_t total) {
+    std::unique_ptr<char[]> buffer(new char[BUFFER_SIZE]);
+    size_t buffer_size = 0;
+    Result result;
+    size_t offset = 0;
+    for (size_t fed = 0, i = 0; fed < total; ++i) {
+        size_t size = std::min(std::min(reads[i % reads.size()], BUFFER_SIZE - buffer_size), stream.size() - offset);
+        std::memcpy(buffer.get() + buffer_size, stream.data() + offset, size);
+        offset = (offset + size) % stream.size();
+        fed += size;
+        buffer_size += size;
+        char *current = buffer.get();
+        char *end = buffer.get() + buffer_size;
+        while (current < end) {
+            if ((uint8_t)current[0] == 0x5 || (uint8_t)current[0] == 0x6) {
+                uint64_t packet_size = 0;
+                switch ((uint8_t)current[1]) {
+                    default:
+                        packet_size = (uint8_t)current[1] + 2;
+                        break;
+                    case 0xFD:
+                        packet_size = ((uint8_t)current[2] << 8 | (uint8_t)current[3]) + 4;
+                        break;
+                    case 0xFE:
+                    case 0xFF:
+                        // never in the synthetic stream
+                        packet_size = UINT64_MAX;
+                        break;
+                }
+                if (packet_size > NDN_MAX_PACKET_SIZE) {
+                    ++current;
+                } else if (packet_size <= (uint64_t)(end - current)) {
+                    result.checksum += packet_size + (uint8_t)current[0];
+                    ++result.packets;
+                    current += packet_size;
+                } else {
+                    break;
+                }
+            } else {
+                ++current;
+            }
+        }
+        buffer_size = end - current;
+        std::copy(current, end, buffer.get());
+    }
+    return result;
+}
+
+template<typename Run>
+static void measure(const std::string &label, Run &&run, size_t total) {
+    auto start = std::chrono::steady_clock::now();
+    Result result = run();
+    auto end = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    std::cout << label << ": " << total / elapsed / (1 << 30) << " GiB/s, " << (uint64_t)(result.packets / elapsed)
+              << " packets/s (" << result.packets << " packets, checksum " << result.checksum << ")" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t total = (size_t)((argc > 1 ? std::atof(argv[1]) : 4) * (1 << 30));
+    std::mt19937 generator(42);
+    std::string stream;
+    if (argc > 2) {
+        std::ifstream file(argv[2], std::ios::binary);
+        stream.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (stream.empty()) {
+            std::cerr << "empty capture " << argv[2] << std::endl;
+            return 1;
+        }
+    } else {
+        stream = makeStream(generator);
+    }
+    // what a socket read returns varies with the load, from a few bytes to the whole buffer
+    std::uniform_int_distribution<size_t> read_distribution(1, BUFFER_SIZE);
+    std::vector<size_t> reads(4096);
+    for (size_t &size : reads) {
+        size = read_distribution(generator);
+    }
+    std::cout << "replaying " << stream.size() << " bytes up to " << total << " bytes" << std::endl;
+    measure("legacy parser", [&]() { return runLegacy(stream, reads, total); }, total);
+    measure("TlvFramer", [&]() { return runFramer(stream, reads, total); }, total);
+    return 0;
+}
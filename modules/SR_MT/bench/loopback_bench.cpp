@@ -0,0 +1,95 @@
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../network/tcp_master_face.h"
+#include "../network/udp_master_face.h"
+
+// Measures echoed packets/s on loopback through the UDP and TCP master faces with each I/O backend,
+// a client keeps a window of Interest-sized packets in flight and the router side sends every packet back.
+static const size_t PACKETS = 200000;
+static const size_t WINDOW = 64;
+static const size_t PACKET_SIZE = 100;
+static const uint16_t PORT = 6400;
+
+static std::string makePacket() {
+    std::string packet(PACKET_SIZE, 'x');
+    packet[0] = 0x05;
+    packet[1] = PACKET_SIZE - 2;
+    return packet;
+}
+
+static void run(const std::string &label, int type, IoBackend backend, uint16_t port) {
+    boost::asio::io_service ios;
+    std::shared_ptr<MasterFace> master_face;
+    if (type == SOCK_DGRAM) {
+        master_face = std::make_shared<UdpMasterFace>(ios, port, 1, backend);
+    } else {
+        master_face = std::make_shared<TcpMasterFace>(ios, port, backend);
+    }
+    master_face->listen([](const std::shared_ptr<MasterFace>&, const std::shared_ptr<Face>&) {},
+                        [&master_face](const NdnPacket &packet) { master_face->sendToAllFaces(packet); },
+                        [](const std::shared_ptr<MasterFace>&, const std::shared_ptr<Face>&) {});
+    boost::thread thread([&ios]() { ios.run(); });
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int fd = ::socket(AF_INET, type, 0);
+    timeval timeout = {1, 0};
+    ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    ::connect(fd, (sockaddr*)&address, sizeof(address));
+
+    std::string packet = makePacket();
+    std::unique_ptr<char[]> buffer(new char[1 << 16]);
+    size_t sent = 0;
+    size_t received = 0;
+    size_t stream_size = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (received < PACKETS) {
+        while (sent < PACKETS && sent - received < WINDOW) {
+            ::send(fd, packet.data(), packet.size(), 0);
+            ++sent;
+        }
+        ssize_t size = ::recv(fd, buffer.get(), 1 << 16, 0);
+        if (size <= 0) {
+            // a datagram was lost, refill the window
+            sent = received;
+        } else if (type == SOCK_DGRAM) {
+            ++received;
+        } else {
+            // packets may be split across reads
+            stream_size += size;
+            received = stream_size / PACKET_SIZE;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    std::cout << label << (backend == IoBackend::IO_URING ? ", io_uring: " : ", asio: ")
+              << (uint64_t)(PACKETS * 1e6 / elapsed) << " packets/s" << std::endl;
+
+    ::close(fd);
+    master_face->close();
+    ios.stop();
+    thread.join();
+}
+
+int main() {
+    // a fresh port per run, the previous TCP one may still be in TIME_WAIT
+    uint16_t port = PORT;
+    for (IoBackend backend : {IoBackend::ASIO, IoBackend::IO_URING}) {
+        run("UDP", SOCK_DGRAM, backend, port++);
+        run("TCP", SOCK_STREAM, backend, port++);
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <boost/asio.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../network/ndn_packet.h"
+#include "../network/send_ring.h"
+
+// Measures packets/s handed over from producer threads to a strand, as the faces get them from the threads running
+// the strategy: one handler posted per packet against the SendRing of a face, drained by a handler posted only when
+// none is pending. The consumer checks that the packets of each producer arrive once and in order, the packets that
+// didn't fit the ring included. The faces use the rings when built with NDN_SEND_RINGS, run this on the cores of
+// the target before turning it on.
+//   usage: ring_bench [packets per producer]
+static const size_t IO_THREADS = 4;
+static const size_t PACKET_SIZE = 100;
+static const size_t RING_SIZE = 256;
+
+class Consumer : public std::enable_shared_from_this<Consumer> {
+private:
+    boost::asio::strand _strand;
+    SendRing<NdnPacket> _ring {RING_SIZE};
+    std::vector<uint64_t> _next;
+    std::atomic<size_t> _received {0};
+    bool _is_ordered = true;
+
+public:
+    Consumer(boost::asio::io_service &ios, size_t producers) : _strand(ios), _next(producers, 0) {
+
+    }
+
+    size_t getReceived() const {
+        return _received.load(std::memory_order_acquire);
+    }
+
+    size_t getSpillCount() const {
+        return _ring.getSpillCount();
+    }
+
+    bool isOrdered() const {
+        return _is_ordered;
+    }
+
+    void post(const NdnPacket &packet) {
+        _strand.post(boost::bind(&Consumer::consume, this->shared_from_this(), packet));
+    }
+
+    void push(const NdnPacket &packet) {
+        if (_ring.push(NdnPacket(packet))) {
+            _strand.post(boost::bind(&Consumer::drain, this->shared_from_this()));
+        }
+    }
+
+private:
+    void drain() {
+        if (_ring.drain([this](NdnPacket &&packet) {
+            consume(packet);
+        }, RING_SIZE)) {
+            _strand.post(boost::bind(&Consumer::drain, this->shared_from_this()));
+        }
+    }
+
+    void consume(const NdnPacket &packet) {
+        const char *data = packet.getData().data();
+        uint64_t sequence;
+        std::memcpy(&sequence, data + 3, sizeof(sequence));
+        uint64_t &next = _next[(uint8_t)data[2]];
+        _is_ordered = _is_ordered && sequence == next;
+        next = sequence + 1;
+        _received.fetch_add(1, std::memory_order_release);
+    }
+};
+
+static void run(const std::string &label, size_t producers, size_t packets, bool use_ring) {
+    boost::asio::io_service ios;
+    std::unique_ptr<boost::asio::io_service::work> work(new boost::asio::io_service::work(ios));
+    boost::thread_group io_threads;
+    for (size_t i = 0; i < IO_THREADS; ++i) {
+        io_threads.create_thread(boost::bind(&boost::asio::io_service::run, &ios));
+    }
+    auto consumer = std::make_shared<Consumer>(ios, producers);
+
+    auto start = std::chrono::steady_clock::now();
+    boost::thread_group producer_threads;
+    for (size_t i = 0; i < producers; ++i) {
+        producer_threads.create_thread([&consumer, i, packets, use_ring]() {
+            std::string data(PACKET_SIZE, 'x');
+            data[0] = 0x05;
+            data[1] = PACKET_SIZE - 2;
+            data[2] = (char)i;
+            for (uint64_t sequence = 0; sequence < packets; ++sequence) {
+                std::memcpy(&data[3], &sequence, sizeof(sequence));
+                NdnPacket packet(data.data(), data.size());
+                if (use_ring) {
+                    consumer->push(packet);
+                } else {
+                    consumer->post(packet);
+                }
+            }
+        });
+    }
+    producer_threads.join_all();
+    while (consumer->getReceived() < producers * packets) {
+        boost::this_thread::yield();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(end - start).count();
+    std::cout << label << ", " << producers << " producer(s): " << (uint64_t)(producers * packets / elapsed)
+              << " packets/s";
+    if (consumer->getSpillCount() > 0) {
+        std::cout << ", " << consumer->getSpillCount() << " spilled as the ring was full";
+    }
+    if (!consumer->isOrdered()) {
+        std::cout << ", OUT OF ORDER";
+    }
+    std::cout << std::endl;
+
+    work.reset();
+    io_threads.join_all();
+}
+
+int main(int argc, char *argv[]) {
+    size_t packets = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    run("strand post", 1, packets, false);
+    run("send ring", 1, packets, true);
+    run("strand post", IO_THREADS, packets, false);
+    run("send ring", IO_THREADS, packets, true);
+    return 0;
+}
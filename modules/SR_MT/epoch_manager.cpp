@@ -0,0 +1,55 @@
+#include "epoch_manager.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+static std::atomic<size_t> thread_counter {0};
+
+EpochManager::Guard::Guard(EpochManager &manager) : _slot(manager._slots[getThreadIndex()].epoch) {
+    _slot.store(manager._epoch.load());
+}
+
+EpochManager::Guard::~Guard() {
+    _slot.store(0, std::memory_order_release);
+}
+
+EpochManager::~EpochManager() {
+    for (auto &retired : _retired) {
+        retired.second();
+    }
+}
+
+void EpochManager::retire(const std::function<void()> &deleter) {
+    std::lock_guard<std::mutex> lock(_retired_mutex);
+    // readers entering after this increment can only see the new object
+    _retired.emplace_back(_epoch.fetch_add(1), deleter);
+    reclaim();
+}
+
+void EpochManager::reclaim() {
+    uint64_t min_epoch = UINT64_MAX;
+    for (auto &slot : _slots) {
+        uint64_t epoch = slot.epoch.load();
+        if (epoch != 0) {
+            min_epoch = std::min(min_epoch, epoch);
+        }
+    }
+    auto it = std::partition(_retired.begin(), _retired.end(),
+                             [min_epoch](const std::pair<uint64_t, std::function<void()>> &retired) {
+                                 return retired.first >= min_epoch;
+                             });
+    std::vector<std::pair<uint64_t, std::function<void()>>> reclaimable(std::make_move_iterator(it),
+                                                                         std::make_move_iterator(_retired.end()));
+    _retired.erase(it, _retired.end());
+    for (auto &retired : reclaimable) {
+        retired.second();
+    }
+}
+
+size_t EpochManager::getThreadIndex() {
+    static thread_local size_t thread_index = thread_counter++;
+    if (thread_index >= MAX_THREADS) {
+        throw std::runtime_error("too many threads registered in the epoch manager");
+    }
+    return thread_index;
+}
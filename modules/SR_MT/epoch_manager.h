@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Epoch based reclamation for objects read without locks by the io threads. Readers enter a Guard for the time
+// they use a published pointer, writers swap the pointer then retire the old object, which is only destroyed
+// once every thread that could still hold it has left its Guard. Guards must not be nested on a thread.
+class EpochManager {
+public:
+    static const size_t MAX_THREADS = 64;
+
+    class Guard {
+    private:
+        std::atomic<uint64_t> &_slot;
+
+    public:
+        explicit Guard(EpochManager &manager);
+
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+
+        Guard& operator=(const Guard&) = delete;
+    };
+
+private:
+    struct Slot {
+        // epoch observed by the thread when it entered its Guard, 0 when outside
+        std::atomic<uint64_t> epoch {0};
+        char padding[128 - sizeof(std::atomic<uint64_t>)];
+    };
+
+    std::atomic<uint64_t> _epoch {1};
+    Slot _slots[MAX_THREADS];
+
+    std::mutex _retired_mutex;
+    std::vector<std::pair<uint64_t, std::function<void()>>> _retired;
+
+public:
+    EpochManager() = default;
+
+    ~EpochManager();
+
+    // deleter is called once no reader can still see the retired object, at the latest on a following retire
+    void retire(const std::function<void()> &deleter);
+
+private:
+    void reclaim();
+
+    static size_t getThreadIndex();
+};
@@ -1,15 +1,9 @@
 #include "loadbalancing_strategy.h"
 
-std::vector<std::shared_ptr<Face>> LoadbalancingStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces) {
-    std::vector<std::shared_ptr<Face>> v;
+size_t LoadbalancingStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
     if (faces.empty()) {
-        return v;
-    } else {
-        tbb::spin_mutex::scoped_lock lock(_mutex);
-        if (_index >= faces.size()) {
-            _index = 0;
-        }
-        v.emplace_back(faces[_index++]);
-        return v;
+        return 0;
     }
+    selected[0] = _index.fetch_add(1, std::memory_order_relaxed) % faces.size();
+    return 1;
 }
\ No newline at end of file
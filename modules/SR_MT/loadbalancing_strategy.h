@@ -1,14 +1,11 @@
 #pragma once
 
-#include "atomic"
-
-#include <tbb/spin_mutex.h>
+#include <atomic>
 
 #include "strategy.h"
 
 class LoadbalancingStrategy : public Strategy {
 private:
-    tbb::spin_mutex _mutex;
     std::atomic<size_t> _index {0};
 
 public:
@@ -16,5 +13,5 @@ public:
 
     ~LoadbalancingStrategy() override = default;
 
-    std::vector<std::shared_ptr<Face>> selectFaces(const std::vector<std::shared_ptr<Face>> &faces) override;
+    size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) override;
 };
\ No newline at end of file
@@ -10,6 +10,8 @@ int main(int argc, char *argv[]) {
     std::string name = "";
     uint16_t local_port = 0;
     uint16_t local_command_port = 0;
+    IoBackend backend = IoBackend::ASIO;
+    Runtime runtime = Runtime::SHARED;
 
     char flags = 0;
     for (int i = 1; i < argc; i += 2) {
@@ -26,6 +28,14 @@ int main(int argc, char *argv[]) {
                 local_command_port = std::atoi(argv[i + 1]);
                 flags |= 0x4;
                 break;
+            case 'b':
+                // optional, "uring" or "asio"
+                backend = std::string(argv[i + 1]) == "uring" ? IoBackend::IO_URING : IoBackend::ASIO;
+                break;
+            case 'r':
+                // optional, "core" for one io thread pinned per core, "shared" by default
+                runtime = std::string(argv[i + 1]) == "core" ? Runtime::PER_CORE : Runtime::SHARED;
+                break;
             case 'h':
             default:
                 exit(0);
@@ -42,7 +52,7 @@ int main(int argc, char *argv[]) {
     logger::isTee(true);
     logger::setMinimalLogLevel(logger::INFO);
 
-    StrategyRouter strategy_router(name, local_port, local_command_port);
+    StrategyRouter strategy_router(name, local_port, local_command_port, backend, runtime);
     strategy_router.start();
 
     signal(SIGINT, signal_handler);
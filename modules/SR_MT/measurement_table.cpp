@@ -0,0 +1,100 @@
+#include "measurement_table.h"
+
+size_t MeasurementTable::size() const {
+    return _size.load(std::memory_order_relaxed);
+}
+
+void MeasurementTable::clear() {
+    for (auto &shard : _shards) {
+        tbb::spin_mutex::scoped_lock lock(shard.mutex);
+        for (auto it = shard.pending.begin(); it != shard.pending.end();) {
+            erase(shard, it++);
+        }
+        shard.expiries.clear();
+    }
+}
+
+void MeasurementTable::insert(const NdnPacket &interest, const std::shared_ptr<Face> &face, const Clock::time_point &now) {
+    const char *name;
+    size_t size;
+    if (!interest.getName(name, size)) {
+        return;
+    }
+    uint64_t hash = NdnPacket::hashBytes(NdnPacket::HASH_OFFSET_BASIS, name, name + size);
+    auto expiry = now + std::chrono::milliseconds(interest.getInterestLifetime());
+    auto &shard = getShard(hash);
+    tbb::spin_mutex::scoped_lock lock(shard.mutex);
+    auto range = shard.pending.equal_range(hash);
+    auto it = range.first;
+    while (it != range.second && it->second.face != face) {
+        ++it;
+    }
+    // a retransmission on the same face stays a single outstanding Interest
+    if (it != range.second) {
+        it->second.expiry = expiry;
+    } else {
+        shard.pending.emplace(hash, PendingInterest{face, expiry});
+        face->incrementOutstandingInterests();
+        _size.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.expiries.emplace(expiry, hash);
+}
+
+bool MeasurementTable::satisfy(const NdnPacket &data, size_t face_id) {
+    uint64_t hashes[MAX_COMPONENTS + 1];
+    size_t sizes[MAX_COMPONENTS + 1];
+    size_t components = data.hashNamePrefixes(hashes, sizes, MAX_COMPONENTS);
+    for (size_t i = components + 1; i-- > 0;) {
+        auto &shard = getShard(hashes[i]);
+        tbb::spin_mutex::scoped_lock lock(shard.mutex);
+        auto range = shard.pending.equal_range(hashes[i]);
+        for (auto pending_it = range.first; pending_it != range.second; ++pending_it) {
+            if (pending_it->second.face->getFaceId() == face_id) {
+                // the remaining expiry entries of this hash are skipped when they fire
+                erase(shard, pending_it);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void MeasurementTable::expire(const Clock::time_point &now) {
+    for (auto &shard : _shards) {
+        tbb::spin_mutex::scoped_lock lock(shard.mutex);
+        while (!shard.expiries.empty() && shard.expiries.begin()->first <= now) {
+            auto range = shard.pending.equal_range(shard.expiries.begin()->second);
+            for (auto it = range.first; it != range.second;) {
+                if (it->second.expiry <= now) {
+                    erase(shard, it++);
+                } else {
+                    ++it;
+                }
+            }
+            shard.expiries.erase(shard.expiries.begin());
+        }
+    }
+}
+
+void MeasurementTable::removeFace(const std::shared_ptr<Face> &face) {
+    for (auto &shard : _shards) {
+        tbb::spin_mutex::scoped_lock lock(shard.mutex);
+        for (auto it = shard.pending.begin(); it != shard.pending.end();) {
+            if (it->second.face == face) {
+                erase(shard, it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+MeasurementTable::Shard& MeasurementTable::getShard(uint64_t hash) {
+    return _shards[(hash >> 32) % SHARDS];
+}
+
+void MeasurementTable::erase(Shard &shard, std::unordered_multimap<uint64_t, PendingInterest>::iterator it) {
+    it->second.face->decrementOutstandingInterests();
+    shard.pending.erase(it);
+    _size.fetch_sub(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <tbb/spin_mutex.h>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+#include "network/face.h"
+#include "network/ndn_packet.h"
+
+// Interests forwarded to the egress faces and still waiting for their Data. Names are only hashed, a Data
+// satisfies the Interest sent to its face with the longest matching prefix. Every pending Interest is counted in
+// the outstanding Interests of its face, so the strategies read the load of a face without touching the table.
+// The table is split in shards locked independently, the io threads rarely contend on the same shard.
+class MeasurementTable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static const size_t SHARDS = 64;
+    static const size_t MAX_COMPONENTS = 64;
+
+private:
+    struct PendingInterest {
+        std::shared_ptr<Face> face;
+        Clock::time_point expiry;
+    };
+
+    struct Shard {
+        tbb::spin_mutex mutex;
+        std::unordered_multimap<uint64_t, PendingInterest> pending;
+        std::multimap<Clock::time_point, uint64_t> expiries;
+    };
+
+    Shard _shards[SHARDS];
+    std::atomic<size_t> _size {0};
+
+public:
+    MeasurementTable() = default;
+
+    ~MeasurementTable() = default;
+
+    size_t size() const;
+
+    void clear();
+
+    void insert(const NdnPacket &interest, const std::shared_ptr<Face> &face, const Clock::time_point &now);
+
+    // true if the Data matches an Interest sent to the face it came from
+    bool satisfy(const NdnPacket &data, size_t face_id);
+
+    void expire(const Clock::time_point &now);
+
+    void removeFace(const std::shared_ptr<Face> &face);
+
+private:
+    Shard& getShard(uint64_t hash);
+
+    void erase(Shard &shard, std::unordered_multimap<uint64_t, PendingInterest>::iterator it);
+};
@@ -18,29 +18,93 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
 
+#include <pthread.h>
+#include <sched.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "network/packet_ring.h"
+
+// how the io threads of a module share its handlers
+enum class Runtime {
+    // the threads all run the same io_service, a handler runs on any of them and the faces rely on their strand
+    SHARED,
+    // each thread runs its own io_service pinned to its own core, a face stays on the core it was assigned to and
+    // the cores exchange messages through lock-free mailboxes
+    PER_CORE,
+};
+
 class Module {
+public:
+    using Message = std::function<void()>;
+
+    static const size_t NO_CORE = SIZE_MAX;
+
+private:
+    static const size_t MAILBOX_SIZE = 1024;
+
+    // a single core pushes into a mailbox and a single core drains it
+    using Mailbox = PacketRing<Message, RingProducer::SINGLE>;
+
 protected:
     size_t _concurrency;
+    Runtime _runtime;
+    // with Runtime::PER_CORE, the io_service of the first core
     boost::asio::io_service _ios;
     boost::asio::io_service::work _ios_work;
     boost::thread_group _thread_pool;
 
-public:
-    explicit Module(size_t concurrency) : _concurrency(concurrency), _ios(concurrency), _ios_work(_ios) {
+private:
+    // with Runtime::PER_CORE, the io_services of the other cores
+    std::vector<std::unique_ptr<boost::asio::io_service>> _core_services;
+    std::vector<std::unique_ptr<boost::asio::io_service::work>> _core_works;
+    // the messages from core i to core j are in _mailboxes[i * _concurrency + j]
+    std::deque<Mailbox> _mailboxes;
+    std::atomic<size_t> _next_core {0};
 
+public:
+    // with Runtime::PER_CORE, concurrency is the number of cores used
+    explicit Module(size_t concurrency, Runtime runtime = Runtime::SHARED)
+            : _concurrency(concurrency)
+            , _runtime(runtime)
+            , _ios(runtime == Runtime::PER_CORE ? 1 : concurrency)
+            , _ios_work(_ios) {
+        if (_runtime == Runtime::PER_CORE) {
+            for (size_t core = 1; core < _concurrency; ++core) {
+                _core_services.emplace_back(new boost::asio::io_service(1));
+                _core_works.emplace_back(new boost::asio::io_service::work(*_core_services.back()));
+            }
+            for (size_t i = 0; i < _concurrency * _concurrency; ++i) {
+                _mailboxes.emplace_back((size_t)MAILBOX_SIZE);
+            }
+        }
     }
 
     virtual ~Module() = default;
 
     void start() {
-        for (int i = 0; i < _concurrency; ++i) {
-            _thread_pool.create_thread(boost::bind(&boost::asio::io_service::run, &_ios));
+        if (_runtime == Runtime::PER_CORE) {
+            for (size_t core = 0; core < _concurrency; ++core) {
+                _thread_pool.create_thread(boost::bind(&Module::runCore, this, core));
+            }
+        } else {
+            for (int i = 0; i < _concurrency; ++i) {
+                _thread_pool.create_thread(boost::bind(&boost::asio::io_service::run, &_ios));
+            }
         }
         _ios.post(boost::bind(&Module::run, this));
     }
 
     void stop() {
         _ios.stop();
+        for (const auto &ios : _core_services) {
+            ios->stop();
+        }
         _thread_pool.join_all();
     }
 
@@ -49,4 +113,76 @@ public:
     const boost::asio::io_service& get_io_service() const {
         return _ios;
     }
-};
\ No newline at end of file
+
+    size_t getCores() const {
+        return _runtime == Runtime::PER_CORE ? _concurrency : 1;
+    }
+
+    boost::asio::io_service& getCoreService(size_t core) {
+        return core == 0 ? _ios : *_core_services[core - 1];
+    }
+
+    // the io_service a new face runs on for its whole life, the cores take turns
+    boost::asio::io_service& assignCore() {
+        return getCoreService(_next_core.fetch_add(1, std::memory_order_relaxed) % getCores());
+    }
+
+    // the core running the calling thread, NO_CORE outside of the io threads of a Runtime::PER_CORE module
+    static size_t getCurrentCore() {
+        return currentCore();
+    }
+
+    // runs message on the given core. From another core, the message goes through the mailbox between both cores and
+    // only the first message of a burst posts a handler, from any other thread it is posted
+    void sendToCore(size_t core, Message message) {
+        size_t from = getCurrentCore();
+        if (_runtime != Runtime::PER_CORE || from == NO_CORE) {
+            getCoreService(core).post(message);
+            return;
+        }
+        Mailbox &mailbox = _mailboxes[from * _concurrency + core];
+        if (!mailbox.push(std::move(message))) {
+            // the mailbox is full, the message takes the slow way
+            getCoreService(core).post(message);
+        } else if (mailbox.needsWakeup()) {
+            getCoreService(core).post(boost::bind(&Module::drainMailbox, this, from, core));
+        }
+    }
+
+private:
+    static size_t& currentCore() {
+        static thread_local size_t core = NO_CORE;
+        return core;
+    }
+
+    void runCore(size_t core) {
+        currentCore() = core;
+        // the cores are taken among the ones the process may run on, several io threads share one if there are less
+        cpu_set_t allowed;
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0 && CPU_COUNT(&allowed) > 0) {
+            size_t index = core % CPU_COUNT(&allowed);
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed) && index-- == 0) {
+                    cpu_set_t pinned;
+                    CPU_ZERO(&pinned);
+                    CPU_SET(cpu, &pinned);
+                    pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned);
+                    break;
+                }
+            }
+        }
+        getCoreService(core).run();
+    }
+
+    void drainMailbox(size_t from, size_t to) {
+        Mailbox &mailbox = _mailboxes[from * _concurrency + to];
+        mailbox.beginDrain();
+        size_t count = mailbox.pop([](Message &&message) {
+            message();
+        }, MAILBOX_SIZE);
+        // the rest waits for a later turn, so the other handlers of the core aren't held back
+        if (count == MAILBOX_SIZE && mailbox.needsWakeup()) {
+            getCoreService(to).post(boost::bind(&Module::drainMailbox, this, from, to));
+        }
+    }
+};
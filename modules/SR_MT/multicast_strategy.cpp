@@ -1,5 +1,11 @@
 #include "multicast_strategy.h"
 
-std::vector<std::shared_ptr<Face>> MulticastStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces) {
-    return faces;
+#include <algorithm>
+
+size_t MulticastStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
+    size_t count = std::min(faces.size(), (size_t)MAX_SELECTED_FACES);
+    for (size_t i = 0; i < count; ++i) {
+        selected[i] = i;
+    }
+    return count;
 }
\ No newline at end of file
@@ -2,17 +2,21 @@
 
 #include <boost/asio.hpp>
 
+#include <atomic>
 #include <functional>
 
 #include <memory>
 #include <string>
 
 #include "ndn_packet.h"
+#include "tx_queue.h"
 
 class Face {
 public:
     using Callback = std::function<void(const NdnPacket&)>;
     using ErrorCallback = std::function<void(const std::shared_ptr<Face>&)>;
+    // called from the strand of the face when its transmit queue starts or stops dropping packets
+    using CongestionCallback = std::function<void(const std::shared_ptr<Face>&, bool congested)>;
 
 private:
     static size_t counter;
@@ -21,11 +25,15 @@ protected:
     const size_t _face_id;
 
     bool _is_connected = false;
+    std::atomic<bool> _is_congested {false};
 
     boost::asio::io_service &_ios;
 
+    std::atomic<size_t> _outstanding_interests {0};
+
     Callback _callback;
     ErrorCallback _error_callback;
+    CongestionCallback _congestion_callback;
 
 public:
     explicit Face(boost::asio::io_service &ios) : _face_id(++counter), _ios(ios) {
@@ -42,6 +50,32 @@ public:
         return _is_connected;
     }
 
+    // Interests sent on this face and still waiting for Data, kept up to date by the measurement table
+    size_t getOutstandingInterests() const {
+        return _outstanding_interests.load(std::memory_order_relaxed);
+    }
+
+    void incrementOutstandingInterests() {
+        _outstanding_interests.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void decrementOutstandingInterests() {
+        _outstanding_interests.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    bool isCongested() const {
+        return _is_congested.load(std::memory_order_relaxed);
+    }
+
+    // must be set before the face is opened
+    void setCongestionCallback(const CongestionCallback &congestion_callback) {
+        _congestion_callback = congestion_callback;
+    }
+
+    virtual void setTxQueueLimits(const TxQueueLimits &limits) = 0;
+
+    virtual TxQueueStats getTxQueueStats() const = 0;
+
     virtual std::string getUnderlyingProtocol() const = 0;
 
     virtual std::string getUnderlyingEndpoint() const = 0;
@@ -51,4 +85,7 @@ public:
     virtual void close() = 0;
 
     virtual void send(const NdnPacket &packet) = 0;
+
+protected:
+    void updateCongestion(const std::shared_ptr<Face> &face, bool congested);
 };
\ No newline at end of file
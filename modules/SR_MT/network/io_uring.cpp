@@ -0,0 +1,176 @@
+#include "io_uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+static int io_uring_setup(unsigned entries, io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int io_uring_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0);
+}
+
+static int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+void IoUring::BufferRing::add(void *buffer, uint32_t size, uint16_t buffer_id) {
+    uint16_t tail = __atomic_load_n(&_ring->tail, __ATOMIC_RELAXED);
+    // not _ring->bufs, the empty struct that the uapi header puts before the array has a size of one byte in C++
+    io_uring_buf &buf = ((io_uring_buf*)_ring)[(uint16_t)(tail + _pending) & _mask];
+    buf.addr = (uint64_t)buffer;
+    buf.len = size;
+    buf.bid = buffer_id;
+    ++_pending;
+}
+
+void IoUring::BufferRing::advance() {
+    uint16_t tail = __atomic_load_n(&_ring->tail, __ATOMIC_RELAXED);
+    __atomic_store_n(&_ring->tail, (uint16_t)(tail + _pending), __ATOMIC_RELEASE);
+    _pending = 0;
+}
+
+IoUring::IoUring(unsigned entries) {
+    std::memset(&_params, 0, sizeof(_params));
+    _fd = io_uring_setup(entries, &_params);
+    if (_fd < 0) {
+        throw std::system_error(errno, std::system_category(), "io_uring_setup");
+    }
+    _sq_ring_size = _params.sq_off.array + _params.sq_entries * sizeof(uint32_t);
+    _cq_ring_size = _params.cq_off.cqes + _params.cq_entries * sizeof(io_uring_cqe);
+    if (_params.features & IORING_FEAT_SINGLE_MMAP) {
+        _sq_ring_size = _cq_ring_size = std::max(_sq_ring_size, _cq_ring_size);
+    }
+    _sq_ring = mmap(nullptr, _sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_params.features & IORING_FEAT_SINGLE_MMAP) {
+        _cq_ring = _sq_ring;
+    } else if (_sq_ring != MAP_FAILED) {
+        _cq_ring = mmap(nullptr, _cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+    }
+    _sqes_size = _params.sq_entries * sizeof(io_uring_sqe);
+    if (_sq_ring != MAP_FAILED && _cq_ring != MAP_FAILED) {
+        _sqes = (io_uring_sqe*)mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+    }
+    if (_sq_ring == MAP_FAILED || _cq_ring == MAP_FAILED || _sqes == MAP_FAILED) {
+        int err = errno;
+        _sq_ring = _sq_ring == MAP_FAILED ? nullptr : _sq_ring;
+        _cq_ring = _cq_ring == MAP_FAILED ? nullptr : _cq_ring;
+        _sqes = _sqes == MAP_FAILED ? nullptr : _sqes;
+        release();
+        throw std::system_error(err, std::system_category(), "io_uring mmap");
+    }
+    char *sq = (char*)_sq_ring;
+    _sq_head = (std::atomic<uint32_t>*)(sq + _params.sq_off.head);
+    _sq_tail = (std::atomic<uint32_t>*)(sq + _params.sq_off.tail);
+    _sq_mask = *(uint32_t*)(sq + _params.sq_off.ring_mask);
+    _sq_array = (uint32_t*)(sq + _params.sq_off.array);
+    _sq_local_tail = _sq_submitted_tail = _sq_tail->load(std::memory_order_relaxed);
+    char *cq = (char*)_cq_ring;
+    _cq_head = (std::atomic<uint32_t>*)(cq + _params.cq_off.head);
+    _cq_tail = (std::atomic<uint32_t>*)(cq + _params.cq_off.tail);
+    _cq_mask = *(uint32_t*)(cq + _params.cq_off.ring_mask);
+    _cqes = (io_uring_cqe*)(cq + _params.cq_off.cqes);
+}
+
+IoUring::~IoUring() {
+    release();
+}
+
+int IoUring::getFd() const {
+    return _fd;
+}
+
+io_uring_sqe* IoUring::getSqe() {
+    uint32_t head = _sq_head->load(std::memory_order_acquire);
+    if (_sq_local_tail - head >= _params.sq_entries) {
+        return nullptr;
+    }
+    uint32_t index = _sq_local_tail++ & _sq_mask;
+    _sq_array[index] = index;
+    io_uring_sqe *sqe = &_sqes[index];
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int IoUring::submit() {
+    unsigned to_submit = _sq_local_tail - _sq_submitted_tail;
+    if (to_submit == 0) {
+        return 0;
+    }
+    _sq_tail->store(_sq_local_tail, std::memory_order_release);
+    _sq_submitted_tail = _sq_local_tail;
+    int ret;
+    do {
+        ret = io_uring_enter(_fd, to_submit, 0, 0);
+    } while (ret < 0 && errno == EINTR);
+    return ret;
+}
+
+void IoUring::registerEventFd(int fd) {
+    if (io_uring_register(_fd, IORING_REGISTER_EVENTFD, &fd, 1) < 0) {
+        throw std::system_error(errno, std::system_category(), "io_uring register eventfd");
+    }
+}
+
+void IoUring::registerBuffers(const iovec *buffers, unsigned count) {
+    if (io_uring_register(_fd, IORING_REGISTER_BUFFERS, buffers, count) < 0) {
+        throw std::system_error(errno, std::system_category(), "io_uring register buffers");
+    }
+}
+
+IoUring::BufferRing& IoUring::setupBufferRing(uint16_t group_id, uint16_t entries) {
+    size_t size = entries * sizeof(io_uring_buf);
+    void *ring = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ring == MAP_FAILED) {
+        throw std::system_error(errno, std::system_category(), "io_uring buffer ring mmap");
+    }
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)ring;
+    reg.ring_entries = entries;
+    reg.bgid = group_id;
+    if (io_uring_register(_fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        int err = errno;
+        munmap(ring, size);
+        throw std::system_error(err, std::system_category(), "io_uring register buffer ring");
+    }
+    _buffer_ring._ring = (io_uring_buf_ring*)ring;
+    _buffer_ring._entries = entries;
+    _buffer_ring._mask = entries - 1;
+    return _buffer_ring;
+}
+
+IoUring::BufferRing& IoUring::getBufferRing() {
+    return _buffer_ring;
+}
+
+void IoUring::release() {
+    // closing the ring first releases the pages the kernel pinned
+    if (_fd >= 0) {
+        close(_fd);
+        _fd = -1;
+    }
+    if (_buffer_ring._ring) {
+        munmap(_buffer_ring._ring, _buffer_ring._entries * sizeof(io_uring_buf));
+        _buffer_ring._ring = nullptr;
+    }
+    if (_sqes) {
+        munmap(_sqes, _sqes_size);
+        _sqes = nullptr;
+    }
+    if (_cq_ring && _cq_ring != _sq_ring) {
+        munmap(_cq_ring, _cq_ring_size);
+    }
+    _cq_ring = nullptr;
+    if (_sq_ring) {
+        munmap(_sq_ring, _sq_ring_size);
+        _sq_ring = nullptr;
+    }
+}
\ No newline at end of file
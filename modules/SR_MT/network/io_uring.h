@@ -0,0 +1,109 @@
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// how the faces of a master face do their socket I/O, chosen when the module starts
+enum class IoBackend {
+    // the epoll reactor of the io_service, one readiness notification and one syscall per packet
+    ASIO,
+    // an io_uring per listener or connection, whose eventfd is the only descriptor left in the reactor
+    IO_URING,
+};
+
+// Minimal io_uring on top of the raw syscalls, owned and used by a single strand. Completions are reaped when the
+// registered eventfd becomes readable, so the ring plugs into the io_service like any other descriptor.
+class IoUring {
+public:
+    // ring of buffers the kernel picks from for the operations flagged with IOSQE_BUFFER_SELECT
+    class BufferRing {
+    private:
+        io_uring_buf_ring *_ring = nullptr;
+        size_t _entries = 0;
+        uint16_t _mask = 0;
+        uint16_t _pending = 0;
+
+        friend class IoUring;
+
+    public:
+        BufferRing() = default;
+
+        // hands a buffer back to the kernel, visible after the next advance
+        void add(void *buffer, uint32_t size, uint16_t buffer_id);
+
+        void advance();
+    };
+
+private:
+    int _fd = -1;
+    io_uring_params _params;
+
+    void *_sq_ring = nullptr;
+    size_t _sq_ring_size = 0;
+    void *_cq_ring = nullptr;
+    size_t _cq_ring_size = 0;
+    io_uring_sqe *_sqes = nullptr;
+    size_t _sqes_size = 0;
+
+    std::atomic<uint32_t> *_sq_head;
+    std::atomic<uint32_t> *_sq_tail;
+    uint32_t _sq_mask;
+    uint32_t *_sq_array;
+    uint32_t _sq_local_tail = 0;
+    uint32_t _sq_submitted_tail = 0;
+
+    std::atomic<uint32_t> *_cq_head;
+    std::atomic<uint32_t> *_cq_tail;
+    uint32_t _cq_mask;
+    io_uring_cqe *_cqes;
+
+    BufferRing _buffer_ring;
+
+public:
+    // throws std::system_error when the kernel refuses to create the ring
+    explicit IoUring(unsigned entries);
+
+    ~IoUring();
+
+    IoUring(const IoUring&) = delete;
+
+    IoUring& operator=(const IoUring&) = delete;
+
+    int getFd() const;
+
+    // next free submission entry, zeroed, or nullptr if the submission queue is full
+    io_uring_sqe* getSqe();
+
+    // submits everything prepared since the last call with a single syscall, returns the number submitted
+    int submit();
+
+    // calls handler(const io_uring_cqe&) for each available completion and returns how many there were
+    template<typename Handler>
+    size_t reap(Handler &&handler) {
+        uint32_t head = _cq_head->load(std::memory_order_relaxed);
+        uint32_t tail = _cq_tail->load(std::memory_order_acquire);
+        size_t count = 0;
+        for (; head != tail; ++head, ++count) {
+            handler(_cqes[head & _cq_mask]);
+        }
+        _cq_head->store(head, std::memory_order_release);
+        return count;
+    }
+
+    void registerEventFd(int fd);
+
+    // registers buffers used by IORING_OP_READ_FIXED and IORING_OP_WRITE_FIXED, by index
+    void registerBuffers(const iovec *buffers, unsigned count);
+
+    // one group of provided buffers per ring, entries must be a power of two
+    BufferRing& setupBufferRing(uint16_t group_id, uint16_t entries);
+
+    BufferRing& getBufferRing();
+
+private:
+    void release();
+};
\ No newline at end of file
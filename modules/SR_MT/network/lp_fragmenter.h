@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Splits the network packets larger than the MTU of a datagram face into NDNLPv2 fragments, each one sent as a
+// LpPacket of its own with consecutive sequence numbers (see LpReassembler for the other side). Packets fitting
+// the MTU are sent as they are. Used from the strand of the face, the MTU can be changed from any thread.
+class LpFragmenter {
+public:
+    // ethernet MTU minus the IPv4 and UDP headers
+    static const size_t DEFAULT_MTU = 1472;
+    // largest UDP payload over IPv4
+    static const size_t MAX_MTU = 65507;
+    // LpPacket, Sequence, FragIndex, FragCount and Fragment headers of a fragment of at most 64KiB
+    static const size_t MAX_HEADER_SIZE = 4 + 10 + 4 + 4 + 4;
+    // a fragment carries at least 256 bytes, so a packet of 64KiB is cut in at most LpReassembler::MAX_FRAGMENTS
+    static const size_t MIN_MTU = MAX_HEADER_SIZE + 256;
+
+private:
+    std::atomic<size_t> _mtu;
+    uint64_t _sequence;
+    std::vector<char> _fragment;
+
+public:
+    explicit LpFragmenter(size_t mtu = DEFAULT_MTU);
+
+    size_t getMtu() const;
+
+    // 0 disables the fragmentation, other values are clamped to [MIN_MTU, MAX_MTU]
+    void setMtu(size_t mtu);
+
+    // largest datagram the packets can be aggregated into, the MTU or MAX_MTU without fragmentation
+    size_t getDatagramSize() const;
+
+    // only TLV packets can share a datagram, the receiver splits it on their boundaries
+    static bool canAggregate(const char *packet, size_t size);
+
+    // calls sink(fragment, size) on each fragment of the packet in order, returns false without calling sink when
+    // the packet fits the MTU
+    template<typename Sink>
+    bool fragment(const char *packet, size_t size, Sink &&sink) {
+        size_t mtu = _mtu.load(std::memory_order_relaxed);
+        if (mtu == 0 || size <= mtu) {
+            return false;
+        }
+        size_t payload = mtu - MAX_HEADER_SIZE;
+        size_t count = (size + payload - 1) / payload;
+        for (size_t index = 0; index < count; ++index) {
+            size_t offset = index * payload;
+            size_t fragment_size = encode(packet + offset, std::min(payload, size - offset), index, count);
+            sink((const char *)_fragment.data(), fragment_size);
+        }
+        _sequence += count;
+        return true;
+    }
+
+private:
+    size_t encode(const char *payload, size_t size, size_t index, size_t count);
+
+    static size_t varNumberSize(uint64_t number);
+
+    static char* writeVarNumber(char *it, uint64_t number);
+
+    static char* writeNonNegativeInteger(char *it, uint8_t type, uint64_t number);
+};
@@ -9,6 +9,8 @@ class MasterFace {
 public:
     using NotificationCallback = std::function<void(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face>&)>;
     using ErrorCallback = std::function<void(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face>&)>;
+    // gives the io_service a new face runs on
+    using CoreAssigner = std::function<boost::asio::io_service&()>;
 
 private:
     static size_t counter;
@@ -17,13 +19,18 @@ protected:
     const size_t _master_face_id;
 
     boost::asio::io_service &_ios;
+    CoreAssigner _core_assigner;
 
     NotificationCallback _notification_callback;
     Face::Callback _face_callback;
     ErrorCallback _error_callback;
+    Face::CongestionCallback _congestion_callback;
+    TxQueueLimits _tx_queue_limits;
 
 public:
-    explicit MasterFace(boost::asio::io_service &ios) : _master_face_id(++counter), _ios(ios) {
+    // without a core assigner, the faces run on the io_service of the master face
+    explicit MasterFace(boost::asio::io_service &ios, const CoreAssigner &core_assigner = CoreAssigner())
+            : _master_face_id(++counter), _ios(ios), _core_assigner(core_assigner) {
 
     }
 
@@ -37,6 +44,15 @@ public:
         return _master_face_id;
     }
 
+    // both apply to the faces accepted from then on
+    void setCongestionCallback(const Face::CongestionCallback &congestion_callback) {
+        _congestion_callback = congestion_callback;
+    }
+
+    void setTxQueueLimits(const TxQueueLimits &limits) {
+        _tx_queue_limits = limits;
+    }
+
     virtual std::string getUnderlyingProtocol() const = 0;
 
     virtual void listen(const NotificationCallback &notification_callback, const Face::Callback &callback, const ErrorCallback &error_callback) = 0;
@@ -44,4 +60,14 @@ public:
     virtual void close() = 0;
 
     virtual void sendToAllFaces(const NdnPacket &packet) = 0;
+
+protected:
+    boost::asio::io_service& assignCore() {
+        return _core_assigner ? _core_assigner() : _ios;
+    }
+
+    void prepareFace(const std::shared_ptr<Face> &face) {
+        face->setTxQueueLimits(_tx_queue_limits);
+        face->setCongestionCallback(_congestion_callback);
+    }
 };
\ No newline at end of file
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 class NdnPacket {
+public:
+    static const uint64_t HASH_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+
 private:
-    const std::vector<char> _data;
+    std::vector<char> _data;
 
 public:
     enum Type {
@@ -34,4 +38,93 @@ public:
     const std::vector<char>& getData() const {
         return _data;
     }
+
+    // value of the Name TLV of an Interest or a Data, false if the packet is malformed
+    bool getName(const char *&value, size_t &size) const {
+        const char *it = _data.data();
+        const char *end = it + _data.size();
+        uint64_t type, length;
+        if (!readVarNumber(it, end, type) || !readVarNumber(it, end, length) || length > (uint64_t)(end - it)) {
+            return false;
+        }
+        end = it + length;
+        if (!readVarNumber(it, end, type) || type != 0x07 || !readVarNumber(it, end, length) || length > (uint64_t)(end - it)) {
+            return false;
+        }
+        value = it;
+        size = length;
+        return true;
+    }
+
+    // FNV-1a hash of each prefix of the name, hashes[i] and sizes[i] are the hash and the size of the encoding of
+    // the first i components. Returns the number of components read, at most max_components
+    size_t hashNamePrefixes(uint64_t *hashes, size_t *sizes, size_t max_components) const {
+        hashes[0] = HASH_OFFSET_BASIS;
+        sizes[0] = 0;
+        const char *name;
+        size_t size;
+        if (!getName(name, size)) {
+            return 0;
+        }
+        const char *it = name;
+        const char *end = name + size;
+        uint64_t type, length;
+        size_t components = 0;
+        while (components < max_components) {
+            const char *component = it;
+            if (!readVarNumber(it, end, type) || !readVarNumber(it, end, length) || length > (uint64_t)(end - it)) {
+                break;
+            }
+            it += length;
+            hashes[components + 1] = hashBytes(hashes[components], component, it);
+            sizes[components + 1] = it - name;
+            ++components;
+        }
+        return components;
+    }
+
+    // InterestLifetime in milliseconds, 4000 when the Interest does not set it
+    uint64_t getInterestLifetime() const {
+        const char *it = _data.data();
+        const char *end = it + _data.size();
+        uint64_t type, length;
+        if (!readVarNumber(it, end, type) || !readVarNumber(it, end, length) || length > (uint64_t)(end - it)) {
+            return 4000;
+        }
+        end = it + length;
+        while (readVarNumber(it, end, type) && readVarNumber(it, end, length) && length <= (uint64_t)(end - it)) {
+            if (type == 0x0c && length <= 8) {
+                uint64_t lifetime = 0;
+                for (size_t i = 0; i < length; ++i) {
+                    lifetime = (lifetime << 8) | (uint8_t)it[i];
+                }
+                return lifetime;
+            }
+            it += length;
+        }
+        return 4000;
+    }
+
+    static uint64_t hashBytes(uint64_t hash, const char *begin, const char *end) {
+        for (; begin != end; ++begin) {
+            hash = (hash ^ (uint8_t)*begin) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    static bool readVarNumber(const char *&it, const char *end, uint64_t &number) {
+        if (it >= end) {
+            return false;
+        }
+        uint8_t first = (uint8_t)*it++;
+        size_t size = first < 253 ? 0 : first == 253 ? 2 : first == 254 ? 4 : 8;
+        if ((size_t)(end - it) < size) {
+            return false;
+        }
+        number = size ? 0 : first;
+        for (size_t i = 0; i < size; ++i) {
+            number = (number << 8) | (uint8_t)*it++;
+        }
+        return true;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// who may push into a PacketRing
+enum class RingProducer {
+    // a single thread, or strand, claims the slots without a compare-and-swap
+    SINGLE,
+    // any thread, a batch of slots is claimed with one compare-and-swap
+    MULTI,
+};
+
+// Bounded lock-free ring handing packets over from the producers to a single consumer, usually a strand. The
+// capacity is rounded up to a power of two so an index is masked instead of divided, and the indices sit on their
+// own cache lines so the producers and the consumer don't bounce each other's lines. A slot holds the number of the
+// push that filled it: the consumer only takes a slot once it is published, the producers only claim slots behind
+// the head the consumer published, so a slow producer delays the consumer but never corrupts a slot.
+// needsWakeup() and beginDrain() let the producers schedule the consumer only when it is not already scheduled.
+template<typename T, RingProducer Producer = RingProducer::MULTI>
+class PacketRing {
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence {0};
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    const size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+
+    // next slot claimed by a producer
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _tail {0};
+    // next slot taken by the consumer, the slots before it are free
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> _head {0};
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> _is_scheduled {false};
+
+public:
+    explicit PacketRing(size_t capacity) : _mask(roundUp(capacity) - 1), _slots(new Slot[_mask + 1]) {
+
+    }
+
+    ~PacketRing() {
+        pop([](T &&) {}, _mask + 1);
+    }
+
+    PacketRing(const PacketRing&) = delete;
+
+    PacketRing& operator=(const PacketRing&) = delete;
+
+    size_t capacity() const {
+        return _mask + 1;
+    }
+
+    // moves the first items in, returns how many fit, the others are left untouched
+    size_t push(T *items, size_t count) {
+        uint64_t tail;
+        size_t claimed;
+        do {
+            // the head first, a tail loaded after it can't be behind it
+            uint64_t head = _head.load(std::memory_order_acquire);
+            tail = _tail.load(std::memory_order_relaxed);
+            claimed = std::min(count, (size_t)(_mask + 1 - (tail - head)));
+            if (claimed == 0) {
+                return 0;
+            }
+        } while (Producer == RingProducer::MULTI
+                 && !_tail.compare_exchange_weak(tail, tail + claimed, std::memory_order_relaxed));
+        if (Producer == RingProducer::SINGLE) {
+            _tail.store(tail + claimed, std::memory_order_relaxed);
+        }
+        for (size_t i = 0; i < claimed; ++i) {
+            Slot &slot = _slots[(tail + i) & _mask];
+            new (&slot.storage) T(std::move(items[i]));
+            slot.sequence.store(tail + i + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    // false if the ring is full, item is then left untouched
+    bool push(T &&item) {
+        return push(&item, 1) == 1;
+    }
+
+    // consumer side, calls sink(T&&) on the published items in order, at most max of them, and returns how many
+    template<typename Sink>
+    size_t pop(Sink &&sink, size_t max) {
+        uint64_t head = _head.load(std::memory_order_relaxed);
+        size_t count = 0;
+        for (; count < max; ++count) {
+            Slot &slot = _slots[(head + count) & _mask];
+            if (slot.sequence.load(std::memory_order_acquire) != head + count + 1) {
+                break;
+            }
+            T *item = reinterpret_cast<T*>(&slot.storage);
+            sink(std::move(*item));
+            item->~T();
+        }
+        if (count > 0) {
+            _head.store(head + count, std::memory_order_release);
+        }
+        return count;
+    }
+
+    // producer side after a push, true if the consumer isn't scheduled yet and the caller must schedule it
+    bool needsWakeup() {
+        return !_is_scheduled.exchange(true, std::memory_order_acq_rel);
+    }
+
+    // consumer side before popping, the items pushed from then on schedule it again
+    void beginDrain() {
+        _is_scheduled.exchange(false, std::memory_order_acq_rel);
+    }
+
+private:
+    static size_t roundUp(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        return size;
+    }
+};
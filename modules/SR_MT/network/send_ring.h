@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "packet_ring.h"
+
+// PacketRing of a face, backed by a list taking the items that don't fit so that the items of each producer still
+// reach the consumer in the order they were pushed. Once an item went to the list, the following ones go there too
+// until the consumer has taken it, and the consumer takes the ring before the list.
+template<typename T>
+class SendRing {
+private:
+    PacketRing<T> _ring;
+    std::atomic<bool> _has_spilled {false};
+    std::mutex _spill_mutex;
+    std::vector<T> _spilled;
+    std::atomic<size_t> _spill_counter {0};
+
+public:
+    explicit SendRing(size_t capacity) : _ring(capacity) {
+
+    }
+
+    SendRing(const SendRing&) = delete;
+
+    SendRing& operator=(const SendRing&) = delete;
+
+    // producer side, true if the consumer isn't scheduled yet and the caller must schedule it
+    bool push(T &&item) {
+        if (_has_spilled.load(std::memory_order_acquire) || !_ring.push(std::move(item))) {
+            std::lock_guard<std::mutex> lock(_spill_mutex);
+            _spilled.emplace_back(std::move(item));
+            _has_spilled.store(true, std::memory_order_release);
+            _spill_counter.fetch_add(1, std::memory_order_relaxed);
+        }
+        return _ring.needsWakeup();
+    }
+
+    // consumer side, calls sink(T&&) on the items in order, and returns true if max of them were taken from the
+    // ring and the caller must schedule the consumer again for the others
+    template<typename Sink>
+    bool drain(Sink &&sink, size_t max) {
+        _ring.beginDrain();
+        if (_ring.pop(sink, max) == max) {
+            return _ring.needsWakeup();
+        }
+        if (_has_spilled.load(std::memory_order_acquire)) {
+            std::vector<T> items;
+            {
+                std::lock_guard<std::mutex> lock(_spill_mutex);
+                // the items a producer pushed to the ring before it spilled were published before it took the lock
+                _ring.pop([&items](T &&item) {
+                    items.emplace_back(std::move(item));
+                }, _ring.capacity());
+                std::move(_spilled.begin(), _spilled.end(), std::back_inserter(items));
+                _spilled.clear();
+                _has_spilled.store(false, std::memory_order_release);
+            }
+            for (auto &item : items) {
+                sink(std::move(item));
+            }
+        }
+        return false;
+    }
+
+    // number of items that didn't fit in the ring
+    size_t getSpillCount() const {
+        return _spill_counter.load(std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,110 @@
+#include "shm_master_face.h"
+
+#include <boost/bind.hpp>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../log/logger.h"
+
+#include "unix_master_face.h"
+
+ShmMasterFace::ShmMasterFace(boost::asio::io_service &ios, const std::string &path, const CoreAssigner &core_assigner)
+        : MasterFace(ios, core_assigner)
+        , _path(path)
+        , _socket(ios)
+        , _acceptor(ios) {
+
+}
+
+std::string ShmMasterFace::getSocketPath(const std::string &name) {
+    return UnixMasterFace::RUNTIME_DIRECTORY + "/" + name + ".shm";
+}
+
+std::string ShmMasterFace::getUnderlyingProtocol() const {
+    return "SHM";
+}
+
+void ShmMasterFace::listen(const NotificationCallback &notification_callback, const Face::Callback &face_callback, const ErrorCallback &error_callback) {
+    _notification_callback = notification_callback;
+    _face_callback = face_callback;
+    _error_callback = error_callback;
+    // a socket left by a previous run of the module would make bind fail
+    ::mkdir(UnixMasterFace::RUNTIME_DIRECTORY.c_str(), 0700);
+    ::unlink(_path.c_str());
+    boost::system::error_code err;
+    _acceptor.open(boost::asio::local::stream_protocol(), err);
+    if (!err) {
+        _acceptor.bind(boost::asio::local::stream_protocol::endpoint(_path), err);
+    }
+    if (!err) {
+        _acceptor.listen(16, err);
+    }
+    std::stringstream ss;
+    if (err) {
+        ss << "master face with ID = " << _master_face_id << " cannot listen on shm://" << _path << ": " << err.message();
+        logger::log(logger::WARNING, ss.str());
+        return;
+    }
+    ss << "master face with ID = " << _master_face_id << " listening on shm://" << _path;
+    logger::log(logger::INFO, ss.str());
+    accept();
+}
+
+void ShmMasterFace::close() {
+    if (_acceptor.is_open()) {
+        _acceptor.close();
+        ::unlink(_path.c_str());
+    }
+    for(const auto &face : _faces) {
+        face->close();
+    }
+}
+
+void ShmMasterFace::sendToAllFaces(const NdnPacket &packet) {
+    for(const auto &face : _faces) {
+        face->send(packet);
+    }
+}
+
+void ShmMasterFace::accept() {
+    // the socket of the next face is created on the core it will run on
+    _socket = decltype(_socket)(assignCore());
+    _acceptor.async_accept(_socket, boost::bind(&ShmMasterFace::acceptHandler, shared_from_this(), _1));
+}
+
+void ShmMasterFace::acceptHandler(const boost::system::error_code &err) {
+    if(!err) {
+        // the descriptors come with the first message, the socket is readable once they are there
+        auto socket = std::make_shared<boost::asio::local::stream_protocol::socket>(std::move(_socket));
+        socket->async_receive(boost::asio::null_buffers(),
+                              boost::bind(&ShmMasterFace::handshakeHandler, shared_from_this(), socket, _1));
+        accept();
+    } else if (err != boost::asio::error::operation_aborted) {
+        std::cerr << err.message() << std::endl;
+    }
+}
+
+void ShmMasterFace::handshakeHandler(const std::shared_ptr<boost::asio::local::stream_protocol::socket> &socket,
+                                     const boost::system::error_code &err) {
+    int fds[ShmFace::DESCRIPTORS];
+    if (err || !ShmFace::receiveDescriptors(*socket, fds)) {
+        std::stringstream ss;
+        ss << "connection on shm://" << _path << " closed before sending its shared memory";
+        logger::log(logger::WARNING, ss.str());
+        return;
+    }
+    std::stringstream ss;
+    ss << "new connection on shm://" << _path;
+    logger::log(logger::INFO, ss.str());
+    auto face = std::make_shared<ShmFace>(std::move(*socket), fds);
+    prepareFace(face);
+    _faces.emplace(face);
+    _notification_callback(shared_from_this(), face);
+    face->open(_face_callback, boost::bind(&ShmMasterFace::onFaceError, shared_from_this(), _1));
+}
+
+void ShmMasterFace::onFaceError(const std::shared_ptr<Face> &face) {
+    _faces.erase(face);
+    _error_callback(shared_from_this(), face);
+}
\ No newline at end of file
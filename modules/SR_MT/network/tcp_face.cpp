@@ -2,7 +2,11 @@
 
 #include <boost/bind.hpp>
 
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
 #include <sstream>
+#include <system_error>
 
 #include "../log/logger.h"
 
@@ -11,8 +15,11 @@ TcpFace::TcpFace(boost::asio::io_service &ios, std::string host, uint16_t port)
         , _skip_connect(false)
         , _endpoint(boost::asio::ip::address::from_string(host), port)
         , _socket(ios)
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
         , _strand(ios)
-        , _timer(ios) {
+        , _timer(ios)
+        , _backend(IoBackend::ASIO)
+        , _ring_event(ios) {
 }
 
 TcpFace::TcpFace(boost::asio::io_service &ios, const boost::asio::ip::tcp::endpoint &endpoint)
@@ -20,18 +27,32 @@ TcpFace::TcpFace(boost::asio::io_service &ios, const boost::asio::ip::tcp::endpo
         , _skip_connect(false)
         , _endpoint(endpoint)
         , _socket(ios)
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
         , _strand(ios)
-        , _timer(ios) {
+        , _timer(ios)
+        , _backend(IoBackend::ASIO)
+        , _ring_event(ios) {
 }
 
-TcpFace::TcpFace(boost::asio::ip::tcp::socket &&socket)
+TcpFace::TcpFace(boost::asio::ip::tcp::socket &&socket, IoBackend backend)
         : Face(socket.get_io_service())
         , _skip_connect(true)
         , _endpoint(socket.remote_endpoint())
         , _socket(std::move(socket))
+        , _framer(BUFFER_SIZE, NDN_MAX_PACKET_SIZE)
         , _strand(socket.get_io_service())
-        , _timer(socket.get_io_service()) {
+        , _timer(socket.get_io_service())
+        , _backend(backend)
+        , _ring_event(socket.get_io_service()) {
+
+}
 
+void TcpFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats TcpFace::getTxQueueStats() const {
+    return _queue.getStats();
 }
 
 std::string TcpFace::getUnderlyingProtocol() const {
@@ -51,17 +72,44 @@ void TcpFace::open(const Callback &callback, const ErrorCallback &error_callback
         connect();
     } else {
         _is_connected = true;
-        read();
+        if (_backend == IoBackend::IO_URING) {
+            ringOpen();
+        }
+        if (_ring) {
+            // the submission queue of the ring is only touched from the strand
+            _strand.post(boost::bind(&TcpFace::read, shared_from_this()));
+        } else {
+            read();
+        }
     }
 }
 
 void TcpFace::close() {
     _is_connected = false;
+    if (_ring) {
+        // the ring holds its own reference on the socket, a shutdown completes the pending read
+        ::shutdown(_socket.native_handle(), SHUT_RDWR);
+    }
     _socket.close();
 }
 
 void TcpFace::send(const NdnPacket &packet) {
+#ifdef NDN_SEND_RINGS
+    if (_send_ring.push(NdnPacket(packet))) {
+        _strand.post(boost::bind(&TcpFace::drainSendRing, shared_from_this()));
+    }
+#else
     _strand.post(boost::bind(&TcpFace::sendImpl, shared_from_this(), packet));
+#endif
+}
+
+void TcpFace::drainSendRing() {
+    // the rest waits for a later turn of the strand, so its other handlers aren't held back
+    if (_send_ring.drain([this](NdnPacket &&packet) {
+        sendImpl(std::move(packet));
+    }, SEND_RING_SIZE)) {
+        _strand.post(boost::bind(&TcpFace::drainSendRing, shared_from_this()));
+    }
 }
 
 void TcpFace::connect() {
@@ -118,73 +166,37 @@ void TcpFace::reconnectHandler(const boost::system::error_code &err, size_t rema
 }
 
 void TcpFace::read() {
-    boost::asio::async_read(_socket, boost::asio::buffer(_buffer + _buffer_size, BUFFER_SIZE - _buffer_size), boost::asio::transfer_at_least(1),
+    char *buffer = _framer.prepare();
+    if (_ring) {
+        io_uring_sqe *sqe = _ring->getSqe();
+        if (!sqe) {
+            // every operation is submitted as soon as it is queued, a full queue means the ring is unusable
+            logger::log(logger::ERROR, "io_uring submission queue full on tcp://" + getUnderlyingEndpoint() + ", closing the face");
+            _error_callback(shared_from_this());
+            return;
+        }
+        sqe->opcode = IORING_OP_READ_FIXED;
+        sqe->fd = _socket.native_handle();
+        sqe->addr = (uint64_t)buffer;
+        sqe->len = _framer.getFreeSize();
+        sqe->buf_index = 0;
+        sqe->user_data = IORING_OP_READ_FIXED;
+        _ring->submit();
+        if (_ring_operations++ == 0) {
+            ringWait();
+        }
+        return;
+    }
+    boost::asio::async_read(_socket, boost::asio::buffer(buffer, _framer.getFreeSize()), boost::asio::transfer_at_least(1),
                             boost::bind(&TcpFace::readHandler, shared_from_this(), _1, _2));
 }
 
 void TcpFace::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
     if(!err) {
-        _buffer_size += bytes_transferred;
-        char *current = _buffer;
-        char *end = _buffer + _buffer_size;
-        while (current < end) {
-            if ((uint8_t)current[0] == 0x5 || (uint8_t)current[0] == 0x6) {
-                //check length
-                uint64_t size = 0;
-                switch ((uint8_t)current[1]) {
-                    default:
-                        size += (uint8_t)current[1];
-                        size += 2;
-                        break;
-                    case 0xFD:
-                        size += (uint8_t)current[2];
-                        size <<= 8;
-                        size += (uint8_t)current[3];
-                        size += 4;
-                        break;
-                    case 0xFE:
-                        size += (uint8_t)current[2];
-                        size <<= 8;
-                        size += (uint8_t)current[3];
-                        size <<= 8;
-                        size += (uint8_t)current[4];
-                        size <<= 8;
-                        size += (uint8_t)current[5];
-                        size += 6;
-                        break;
-                    case 0xFF:
-                        size += (uint8_t)current[2];
-                        size <<= 8;
-                        size += (uint8_t)current[3];
-                        size <<= 8;
-                        size += (uint8_t)current[4];
-                        size <<= 8;
-                        size += (uint8_t)current[5];
-                        size <<= 8;
-                        size += (uint8_t)current[6];
-                        size <<= 8;
-                        size += (uint8_t)current[7];
-                        size <<= 8;
-                        size += (uint8_t)current[8];
-                        size <<= 8;
-                        size += (uint8_t)current[9];
-                        size += 10;
-                        break;
-                }
-                if (size > NDN_MAX_PACKET_SIZE) {
-                    ++current;
-                } else if (size <= end - current) {
-                    _callback(NdnPacket(current, size));
-                    current += size;
-                } else {
-                    break;
-                }
-            }
-        }
-        if (current > end) {
-            std::copy(current, end, _buffer);
-            _buffer_size = end - current;
-        }
+        _framer.commit(bytes_transferred);
+        _framer.extract([this](const char *packet, size_t size) {
+            _callback(NdnPacket(packet, size));
+        });
         read();
     } else {
         if(!_skip_connect && _is_connected) {
@@ -198,9 +210,12 @@ void TcpFace::readHandler(const boost::system::error_code &err, size_t bytes_tra
     }
 }
 
-void TcpFace::sendImpl(const NdnPacket &packet) {
-    _queue.push_back(packet);
-    if (is_writing) {
+void TcpFace::sendImpl(NdnPacket packet) {
+    size_t size = packet.getData().size();
+    bool is_data = packet.getType() == NdnPacket::DATA;
+    _queue.push(std::move(packet), size, is_data);
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (is_writing || _queue.empty()) {
         return;
     }
     is_writing = true;
@@ -208,13 +223,42 @@ void TcpFace::sendImpl(const NdnPacket &packet) {
 }
 
 void TcpFace::write() {
+    if (_ring) {
+        size_t count = 0;
+        _queue.forEach(MAX_WRITE_PACKETS, [this, &count](const NdnPacket &packet) {
+            size_t offset = count == 0 ? _write_offset : 0;
+            _write_iovecs[count].iov_base = (void*)(packet.getData().data() + offset);
+            _write_iovecs[count].iov_len = packet.getData().size() - offset;
+            ++count;
+            return true;
+        });
+        _queue.markInFlight(count);
+        io_uring_sqe *sqe = _ring->getSqe();
+        if (!sqe) {
+            logger::log(logger::ERROR, "io_uring submission queue full on tcp://" + getUnderlyingEndpoint() + ", closing the face");
+            _error_callback(shared_from_this());
+            return;
+        }
+        sqe->opcode = IORING_OP_WRITEV;
+        sqe->fd = _socket.native_handle();
+        sqe->addr = (uint64_t)_write_iovecs;
+        sqe->len = count;
+        sqe->user_data = IORING_OP_WRITEV;
+        _ring->submit();
+        if (_ring_operations++ == 0) {
+            ringWait();
+        }
+        return;
+    }
+    _queue.markInFlight(1);
     boost::asio::async_write(_socket, boost::asio::buffer(_queue.front().getData()),
                              _strand.wrap(boost::bind(&TcpFace::writeHandler, shared_from_this(), _1, _2)));
 }
 
 void TcpFace::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
     if(!err) {
-        _queue.pop_front();
+        _queue.pop();
+        updateCongestion(shared_from_this(), _queue.isCongested());
         if (!_queue.empty()) {
             write();
         } else {
@@ -227,4 +271,78 @@ void TcpFace::timerHandler(const boost::system::error_code &err) {
     if (!err) {
         _error_callback(shared_from_this());
     }
+}
+
+void TcpFace::ringOpen() {
+    try {
+        _ring.reset(new IoUring(8));
+        int event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (event_fd < 0) {
+            throw std::system_error(errno, std::system_category(), "eventfd");
+        }
+        _ring_event.assign(event_fd);
+        _ring->registerEventFd(event_fd);
+        iovec buffer = {_framer.getBuffer(), _framer.getCapacity()};
+        _ring->registerBuffers(&buffer, 1);
+    } catch (const std::system_error &e) {
+        std::stringstream ss;
+        ss << "io_uring unavailable for tcp://" << _endpoint << " (" << e.what() << "), using the asio backend";
+        logger::log(logger::WARNING, ss.str());
+        _ring.reset();
+    }
+}
+
+void TcpFace::ringWait() {
+    _ring_event.async_read_some(boost::asio::buffer(&_ring_event_value, sizeof(_ring_event_value)),
+                                _strand.wrap(boost::bind(&TcpFace::ringHandler, shared_from_this(), _1, _2)));
+}
+
+void TcpFace::ringHandler(const boost::system::error_code &err, size_t bytes_transferred) {
+    if (err) {
+        return;
+    }
+    // the handlers below submit the next operations, the wait is armed again only if some are still pending
+    size_t operations = _ring_operations;
+    _ring_operations = 0;
+    size_t completed = _ring->reap([this](const io_uring_cqe &cqe) {
+        if (cqe.user_data == IORING_OP_READ_FIXED) {
+            if (cqe.res > 0) {
+                readHandler(boost::system::error_code(), cqe.res);
+            } else if (cqe.res == 0) {
+                readHandler(boost::asio::error::eof, 0);
+            } else {
+                readHandler(boost::system::error_code(-cqe.res, boost::system::system_category()), 0);
+            }
+        } else {
+            ringWriteHandler(cqe.res);
+        }
+    });
+    _ring_operations += operations - completed;
+    if (_ring_operations > 0) {
+        ringWait();
+    }
+}
+
+void TcpFace::ringWriteHandler(int result) {
+    if (result < 0) {
+        std::cerr << std::strerror(-result) << std::endl;
+        return;
+    }
+    size_t written = result;
+    while (written > 0) {
+        size_t remaining = _queue.front().getData().size() - _write_offset;
+        if (written < remaining) {
+            _write_offset += written;
+            break;
+        }
+        written -= remaining;
+        _write_offset = 0;
+        _queue.pop();
+    }
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (!_queue.empty()) {
+        write();
+    } else {
+        is_writing = false;
+    }
 }
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "face.h"
+#include "send_ring.h"
+#include "tlv_framer.h"
+#include "io_uring.h"
 
 #include <boost/asio.hpp>
 
@@ -9,24 +12,37 @@
 #include <deque>
 #include <vector>
 
+// With the io_uring backend, an accepted face reads into its buffer registered once with its own ring and writes
+// its whole queue with one writev, the connection and reconnection of egress faces stay on asio.
 class TcpFace : public Face, public std::enable_shared_from_this<TcpFace> {
 public:
     static const size_t NDN_MAX_PACKET_SIZE = 8800;
-    static const size_t BUFFER_SIZE = 1 << 14;
+    static const size_t BUFFER_SIZE = 1 << 15;
+    static const size_t MAX_WRITE_PACKETS = 64;
+    static const size_t SEND_RING_SIZE = 256;
 
 private:
     bool _skip_connect;
 
     boost::asio::ip::tcp::endpoint _endpoint;
     boost::asio::ip::tcp::socket _socket;
-    char _buffer[BUFFER_SIZE];
-    size_t _buffer_size = 0;
+    TlvFramer _framer;
     bool is_writing = false;
-    std::deque<NdnPacket> _queue;
+    TxQueue<NdnPacket> _queue;
+    // packets handed over by the threads sending on the face, drained from the strand
+    SendRing<NdnPacket> _send_ring {SEND_RING_SIZE};
 
     boost::asio::strand _strand;
     boost::asio::deadline_timer _timer;
 
+    IoBackend _backend;
+    iovec _write_iovecs[MAX_WRITE_PACKETS];
+    size_t _write_offset = 0;
+    size_t _ring_operations = 0;
+    uint64_t _ring_event_value;
+    boost::asio::posix::stream_descriptor _ring_event;
+    std::unique_ptr<IoUring> _ring;
+
 public:
     // use these when creating a face yourself
     TcpFace(boost::asio::io_service &ios, std::string host, uint16_t port);
@@ -34,10 +50,14 @@ public:
     TcpFace(boost::asio::io_service &ios, const boost::asio::ip::tcp::endpoint &endpoint);
 
     // specific constructor for MasterFace, not recommended to use it yourself
-    explicit TcpFace(boost::asio::ip::tcp::socket &&socket);
+    explicit TcpFace(boost::asio::ip::tcp::socket &&socket, IoBackend backend = IoBackend::ASIO);
 
     ~TcpFace() override = default;
 
+    void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+    TxQueueStats getTxQueueStats() const override;
+
     std::string getUnderlyingProtocol() const override;
 
     std::string getUnderlyingEndpoint() const override;
@@ -63,11 +83,21 @@ private:
 
     std::vector<NdnPacket> findPackets();
 
-    void sendImpl(const NdnPacket &packet);
+    void sendImpl(NdnPacket packet);
+
+    void drainSendRing();
 
     void write();
 
     void writeHandler(const boost::system::error_code &err, size_t bytesTransferred);
 
     void timerHandler(const boost::system::error_code &err);
+
+    void ringOpen();
+
+    void ringWait();
+
+    void ringHandler(const boost::system::error_code &err, size_t bytes_transferred);
+
+    void ringWriteHandler(int result);
 };
\ No newline at end of file
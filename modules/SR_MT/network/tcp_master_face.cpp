@@ -4,9 +4,10 @@
 
 #include "../log/logger.h"
 
-TcpMasterFace::TcpMasterFace(boost::asio::io_service &ios, uint16_t port)
-        : MasterFace(ios)
+TcpMasterFace::TcpMasterFace(boost::asio::io_service &ios, uint16_t port, IoBackend backend, const CoreAssigner &core_assigner)
+        : MasterFace(ios, core_assigner)
         , _port(port)
+        , _backend(backend)
         , _socket(ios)
         , _acceptor(ios, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)) {
 
@@ -41,6 +42,8 @@ void TcpMasterFace::sendToAllFaces(const NdnPacket &packet) {
 }
 
 void TcpMasterFace::accept() {
+    // the socket of the next face is created on the core it will run on
+    _socket = decltype(_socket)(assignCore());
     _acceptor.async_accept(_socket, boost::bind(&TcpMasterFace::acceptHandler, shared_from_this(), _1));
 }
 
@@ -49,7 +52,8 @@ void TcpMasterFace::acceptHandler(const boost::system::error_code &err) {
         std::stringstream ss;
         ss << "new connection from tcp://" << _socket.remote_endpoint();
         logger::log(logger::INFO, ss.str());
-        auto &face = *_faces.emplace(std::make_shared<TcpFace>(std::move(_socket))).first;
+        auto &face = *_faces.emplace(std::make_shared<TcpFace>(std::move(_socket), _backend)).first;
+        prepareFace(face);
         face->open(_face_callback, boost::bind(&TcpMasterFace::onFaceError, shared_from_this(), _1));
         _notification_callback(shared_from_this(), face);
         accept();
@@ -9,13 +9,15 @@
 class TcpMasterFace : public MasterFace, public std::enable_shared_from_this<TcpMasterFace> {
 private:
     uint16_t _port;
+    IoBackend _backend;
     boost::asio::ip::tcp::socket _socket;
     boost::asio::ip::tcp::acceptor _acceptor;
 
     std::unordered_set<std::shared_ptr<Face>> _faces;
 
 public:
-    TcpMasterFace(boost::asio::io_service &ios, uint16_t port);
+    TcpMasterFace(boost::asio::io_service &ios, uint16_t port, IoBackend backend = IoBackend::ASIO,
+                  const CoreAssigner &core_assigner = CoreAssigner());
 
     ~TcpMasterFace() override = default;
 
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <list>
+
+// what a full transmit queue gives up to make room for a new packet
+enum class DropPolicy {
+    // the new packet
+    TAIL_DROP,
+    // the oldest waiting packets, an Interest that waited that long has likely expired downstream anyway
+    HEAD_DROP,
+    // the oldest waiting Interests, Data are only dropped when no Interest is left to drop
+    PRIORITY_DROP,
+};
+
+struct TxQueueLimits {
+    size_t packets = 4096;
+    size_t bytes = 8 << 20;
+    DropPolicy policy = DropPolicy::TAIL_DROP;
+};
+
+struct TxQueueStats {
+    size_t packets;
+    size_t bytes;
+    size_t dropped_packets;
+    size_t dropped_bytes;
+};
+
+// Transmit queue of a face bounded in packets and in bytes, used from the strand of the face. The limits and the
+// statistics can be accessed from any thread. The queue is congested from its first drop until it drains below
+// half of its limits, the packets being written are never dropped.
+template<typename T>
+class TxQueue {
+private:
+    struct Entry {
+        T item;
+        size_t size;
+        bool is_data;
+        bool in_flight;
+    };
+
+    using Iterator = typename std::list<Entry>::iterator;
+
+    std::list<Entry> _entries;
+    // the queued Interests in order, so the oldest one is found without a scan
+    std::deque<Iterator> _interests;
+    bool _is_congested = false;
+
+    std::atomic<size_t> _max_packets;
+    std::atomic<size_t> _max_bytes;
+    std::atomic<DropPolicy> _policy;
+
+    std::atomic<size_t> _packets {0};
+    std::atomic<size_t> _bytes {0};
+    std::atomic<size_t> _dropped_packets {0};
+    std::atomic<size_t> _dropped_bytes {0};
+
+public:
+    explicit TxQueue(const TxQueueLimits &limits = TxQueueLimits())
+            : _max_packets(limits.packets)
+            , _max_bytes(limits.bytes)
+            , _policy(limits.policy) {
+
+    }
+
+    void setLimits(const TxQueueLimits &limits) {
+        _max_packets.store(limits.packets, std::memory_order_relaxed);
+        _max_bytes.store(limits.bytes, std::memory_order_relaxed);
+        _policy.store(limits.policy, std::memory_order_relaxed);
+    }
+
+    TxQueueStats getStats() const {
+        return {_packets.load(std::memory_order_relaxed), _bytes.load(std::memory_order_relaxed),
+                _dropped_packets.load(std::memory_order_relaxed), _dropped_bytes.load(std::memory_order_relaxed)};
+    }
+
+    bool isCongested() const {
+        return _is_congested;
+    }
+
+    bool empty() const {
+        return _entries.empty();
+    }
+
+    size_t size() const {
+        return _entries.size();
+    }
+
+    T& front() {
+        return _entries.front().item;
+    }
+
+    // queues a packet unless the policy drops it, returns false if it was dropped
+    bool push(T item, size_t size, bool is_data) {
+        while (_packets + 1 > _max_packets.load(std::memory_order_relaxed) || _bytes + size > _max_bytes.load(std::memory_order_relaxed)) {
+            _is_congested = true;
+            if (!evict()) {
+                ++_dropped_packets;
+                _dropped_bytes += size;
+                return false;
+            }
+        }
+        _entries.push_back(Entry{std::move(item), size, is_data, false});
+        if (!is_data) {
+            _interests.push_back(std::prev(_entries.end()));
+        }
+        ++_packets;
+        _bytes += size;
+        return true;
+    }
+
+    void pop() {
+        if (!_entries.front().is_data) {
+            _interests.pop_front();
+        }
+        _bytes -= _entries.front().size;
+        --_packets;
+        _entries.pop_front();
+        if (_is_congested && _packets <= _max_packets.load(std::memory_order_relaxed) / 2
+            && _bytes <= _max_bytes.load(std::memory_order_relaxed) / 2) {
+            _is_congested = false;
+        }
+    }
+
+    // the first count packets are being written and must stay in place until popped
+    void markInFlight(size_t count) {
+        for (auto it = _entries.begin(); it != _entries.end() && count > 0; ++it, --count) {
+            it->in_flight = true;
+        }
+    }
+
+    // calls visitor(item) on the first packets, at most max of them, until it returns false, and returns how many
+    // it accepted
+    template<typename Visitor>
+    size_t forEach(size_t max, Visitor &&visitor) {
+        size_t count = 0;
+        for (auto it = _entries.begin(); it != _entries.end() && count < max && visitor(it->item); ++it) {
+            ++count;
+        }
+        return count;
+    }
+
+    void clear() {
+        _entries.clear();
+        _interests.clear();
+        _packets = 0;
+        _bytes = 0;
+        _is_congested = false;
+    }
+
+private:
+    bool evict() {
+        switch (_policy.load(std::memory_order_relaxed)) {
+            case DropPolicy::HEAD_DROP: {
+                auto it = _entries.begin();
+                while (it != _entries.end() && it->in_flight) {
+                    ++it;
+                }
+                if (it == _entries.end()) {
+                    return false;
+                }
+                if (!it->is_data) {
+                    for (auto interest = _interests.begin(); interest != _interests.end(); ++interest) {
+                        if (*interest == it) {
+                            _interests.erase(interest);
+                            break;
+                        }
+                    }
+                }
+                erase(it);
+                return true;
+            }
+            case DropPolicy::PRIORITY_DROP: {
+                auto interest = _interests.begin();
+                while (interest != _interests.end() && (*interest)->in_flight) {
+                    ++interest;
+                }
+                if (interest == _interests.end()) {
+                    return false;
+                }
+                Iterator it = *interest;
+                _interests.erase(interest);
+                erase(it);
+                return true;
+            }
+            case DropPolicy::TAIL_DROP:
+            default:
+                return false;
+        }
+    }
+
+    void erase(Iterator it) {
+        ++_dropped_packets;
+        _dropped_bytes += it->size;
+        --_packets;
+        _bytes -= it->size;
+        _entries.erase(it);
+    }
+};
@@ -9,7 +9,8 @@ UdpFace::UdpFace(boost::asio::io_service &ios, const std::string &host, uint16_t
         , _endpoint(boost::asio::ip::address::from_string(host), port)
         , _socket(ios, boost::asio::ip::udp::v4())
         , _strand(ios)
-        , _timer(ios) {
+        , _timer(ios)
+        , _flush_timer(ios) {
 }
 
 UdpFace::UdpFace(boost::asio::io_service &ios, const boost::asio::ip::udp::endpoint &endpoint)
@@ -17,7 +18,16 @@ UdpFace::UdpFace(boost::asio::io_service &ios, const boost::asio::ip::udp::endpo
         , _endpoint(endpoint)
         , _socket(ios, boost::asio::ip::udp::v4())
         , _strand(ios)
-        , _timer(ios) {
+        , _timer(ios)
+        , _flush_timer(ios) {
+}
+
+void UdpFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats UdpFace::getTxQueueStats() const {
+    return _queue.getStats();
 }
 
 std::string UdpFace::getUnderlyingProtocol() const {
@@ -30,6 +40,15 @@ std::string UdpFace::getUnderlyingEndpoint() const {
     return ss.str();
 }
 
+void UdpFace::setMtu(size_t mtu) {
+    _fragmenter.setMtu(mtu);
+}
+
+void UdpFace::setAggregation(bool enabled, const boost::posix_time::time_duration &delay) {
+    _aggregation = enabled;
+    _aggregation_delay = delay;
+}
+
 void UdpFace::open(const Callback &callback, const ErrorCallback &error_callback) {
     _callback = callback;
     _error_callback = error_callback;
@@ -41,7 +60,22 @@ void UdpFace::close() {
 }
 
 void UdpFace::send(const NdnPacket &packet) {
+#ifdef NDN_SEND_RINGS
+    if (_send_ring.push(NdnPacket(packet))) {
+        _strand.post(boost::bind(&UdpFace::drainSendRing, shared_from_this()));
+    }
+#else
     _strand.post(boost::bind(&UdpFace::sendImpl, shared_from_this(), packet));
+#endif
+}
+
+void UdpFace::drainSendRing() {
+    // the rest waits for a later turn of the strand, so its other handlers aren't held back
+    if (_send_ring.drain([this](NdnPacket &&packet) {
+        sendImpl(std::move(packet));
+    }, SEND_RING_SIZE)) {
+        _strand.post(boost::bind(&UdpFace::drainSendRing, shared_from_this()));
+    }
 }
 
 void UdpFace::read() {
@@ -52,23 +86,29 @@ void UdpFace::read() {
 void UdpFace::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
     if(!err) {
         if (_remote_endpoint == _endpoint) {
-            try {
-                switch (_buffer[0]) {
-                    case 0x00:
-                        // special packet, just echoes it
-                        send(NdnPacket("0", 1));
-                        break;
-                    case 0x05:
-                        _callback(NdnPacket(_buffer, bytes_transferred));
-                        break;
-                    case 0x06:
-                        _callback(NdnPacket(_buffer, bytes_transferred));
-                        break;
-                    default:
-                        break;
+            const char *it = _buffer;
+            const char *packet;
+            size_t size;
+            // a datagram may carry several packets, and a fragment only yields a packet once the others arrived
+            while (_reassembler.unpack(it, _buffer + bytes_transferred, packet, size)) {
+                try {
+                    switch (packet[0]) {
+                        case 0x00:
+                            // special packet, just echoes it
+                            send(NdnPacket("0", 1));
+                            break;
+                        case 0x05:
+                            _callback(NdnPacket(packet, size));
+                            break;
+                        case 0x06:
+                            _callback(NdnPacket(packet, size));
+                            break;
+                        default:
+                            break;
+                    }
+                } catch (const std::exception &e) {
+                    std::cerr << e.what() << std::endl;
                 }
-            } catch (const std::exception &e) {
-                std::cerr << e.what() << std::endl;
             }
         }
         read();
@@ -78,23 +118,75 @@ void UdpFace::readHandler(const boost::system::error_code &err, size_t bytes_tra
     }
 }
 
-void UdpFace::sendImpl(const NdnPacket &packet) {
-    _queue.push_back(packet);
-    if (_queue.size() == 1) {
+void UdpFace::sendImpl(NdnPacket packet) {
+    bool is_data = packet.getType() == NdnPacket::DATA;
+    // the fragments of a packet larger than the MTU are queued in its place
+    if (!_fragmenter.fragment(packet.getData().data(), packet.getData().size(), [this, is_data](const char *fragment, size_t size) {
+        _queue.push(NdnPacket(fragment, size), size, is_data);
+    })) {
+        size_t size = packet.getData().size();
+        _queue.push(std::move(packet), size, is_data);
+    }
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (!_is_writing && !_queue.empty()) {
+        flush();
+    }
+}
+
+void UdpFace::flush() {
+    size_t queued_bytes = _queue.getStats().bytes;
+    if (_is_flush_pending) {
+        // a full datagram doesn't wait
+        if (queued_bytes >= _fragmenter.getDatagramSize()) {
+            _flush_timer.cancel();
+        }
+    } else if (_aggregation && _aggregation_delay > boost::posix_time::time_duration() && queued_bytes < _fragmenter.getDatagramSize()) {
+        _is_flush_pending = true;
+        _flush_timer.expires_from_now(_aggregation_delay);
+        _flush_timer.async_wait(_strand.wrap(boost::bind(&UdpFace::flushHandler, shared_from_this(), _1)));
+    } else {
+        write();
+    }
+}
+
+void UdpFace::flushHandler(const boost::system::error_code &err) {
+    _is_flush_pending = false;
+    if (!_is_writing && !_queue.empty()) {
         write();
     }
 }
 
 void UdpFace::write() {
-    _socket.async_send_to(boost::asio::buffer(_queue.front().getData()), _endpoint,
+    size_t datagram_size = _fragmenter.getDatagramSize();
+    size_t bytes = 0;
+    _write_buffers.clear();
+    _queue.forEach(_aggregation ? MAX_AGGREGATED_PACKETS : 1, [this, datagram_size, &bytes](const NdnPacket &packet) -> bool {
+        const std::vector<char> &data = packet.getData();
+        bool can_aggregate = LpFragmenter::canAggregate(data.data(), data.size());
+        if (!_write_buffers.empty() && (!can_aggregate || bytes + data.size() > datagram_size)) {
+            return false;
+        }
+        _write_buffers.emplace_back(data.data(), data.size());
+        // a packet that can't be aggregated fills the datagram on its own
+        bytes += can_aggregate ? data.size() : datagram_size;
+        return true;
+    });
+    _is_writing = true;
+    _queue.markInFlight(_write_buffers.size());
+    _socket.async_send_to(_write_buffers, _endpoint,
                           _strand.wrap(boost::bind(&UdpFace::writeHandler, shared_from_this(), _1, _2)));
 }
 
 void UdpFace::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
     if(!err) {
-        _queue.pop_front();
+        for (size_t i = 0; i < _write_buffers.size(); ++i) {
+            _queue.pop();
+        }
+        updateCongestion(shared_from_this(), _queue.isCongested());
         if (!_queue.empty()) {
             write();
+        } else {
+            _is_writing = false;
         }
     }
 }
\ No newline at end of file
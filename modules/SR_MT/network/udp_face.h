@@ -1,6 +1,9 @@
 #pragma once
 
 #include "face.h"
+#include "send_ring.h"
+#include "lp_fragmenter.h"
+#include "lp_reassembler.h"
 
 #include <boost/asio.hpp>
 
@@ -13,6 +16,8 @@
 class UdpFace : public Face, public std::enable_shared_from_this<UdpFace> {
 public:
     static const size_t BUFFER_SIZE = 1 << 16;
+    static const size_t MAX_AGGREGATED_PACKETS = 64;
+    static const size_t SEND_RING_SIZE = 256;
 
 private:
     boost::asio::ip::udp::endpoint _endpoint;
@@ -20,10 +25,21 @@ private:
     boost::asio::ip::udp::socket _socket;
     boost::asio::strand _strand;
     char _buffer[BUFFER_SIZE];
-    std::deque<NdnPacket> _queue;
+    TxQueue<NdnPacket> _queue;
+    // packets handed over by the threads sending on the face, drained from the strand
+    SendRing<NdnPacket> _send_ring {SEND_RING_SIZE};
+    LpFragmenter _fragmenter;
+    LpReassembler _reassembler;
+    bool _is_writing = false;
+    std::vector<boost::asio::const_buffer> _write_buffers;
 
     boost::asio::deadline_timer _timer;
 
+    bool _aggregation = false;
+    boost::posix_time::time_duration _aggregation_delay;
+    bool _is_flush_pending = false;
+    boost::asio::deadline_timer _flush_timer;
+
 public:
     // use these when creating a face yourself
     UdpFace(boost::asio::io_service &ios, const std::string &host, uint16_t port);
@@ -32,10 +48,21 @@ public:
 
     ~UdpFace() override = default;
 
+    void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+    TxQueueStats getTxQueueStats() const override;
+
     std::string getUnderlyingProtocol() const override;
 
     std::string getUnderlyingEndpoint() const override;
 
+    // packets larger than the MTU are sent as NDNLPv2 fragments, 0 disables the fragmentation
+    void setMtu(size_t mtu);
+
+    // the queued packets leave several per datagram up to the MTU, a packet queued on an idle face waits up to delay
+    // for others to join it. Must be called before the face is opened
+    void setAggregation(bool enabled, const boost::posix_time::time_duration &delay = boost::posix_time::time_duration());
+
     void open(const Callback &callback, const ErrorCallback &error_callback) override;
 
     void close() override;
@@ -47,7 +74,13 @@ private:
 
     void readHandler(const boost::system::error_code &err, size_t bytes_transferred);
 
-    void sendImpl(const NdnPacket &packet);
+    void sendImpl(NdnPacket packet);
+
+    void drainSendRing();
+
+    void flush();
+
+    void flushHandler(const boost::system::error_code &err);
 
     void write();
 
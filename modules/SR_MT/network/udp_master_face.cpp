@@ -2,14 +2,34 @@
 
 #include <boost/bind.hpp>
 
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+#include <cstring>
+#include <system_error>
+
 #include "../log/logger.h"
 
-UdpMasterFace::UdpSubFace::UdpSubFace(UdpMasterFace &master_face, const boost::asio::ip::udp::endpoint &endpoint)
-        : Face(master_face.get_io_service())
-        , _master_face(master_face)
+#ifdef SO_REUSEPORT
+using reuse_port = boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
+UdpMasterFace::UdpSubFace::UdpSubFace(Listener &listener, const boost::asio::ip::udp::endpoint &endpoint)
+        : Face(listener._ios)
+        , _listener(listener)
         , _endpoint(endpoint)
-        , _timer(master_face.get_io_service()) {
+        , _last_activity(listener._ticks.load(std::memory_order_relaxed))
+        , _fragmenter(listener._master_face._mtu.load(std::memory_order_relaxed))
+        , _flush_timer(listener._ios) {
+
+}
 
+void UdpMasterFace::UdpSubFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats UdpMasterFace::UdpSubFace::getTxQueueStats() const {
+    return _queue.getStats();
 }
 
 std::string UdpMasterFace::UdpSubFace::getUnderlyingProtocol() const {
@@ -29,8 +49,6 @@ const boost::asio::ip::udp::endpoint& UdpMasterFace::UdpSubFace::getEndpoint() {
 void UdpMasterFace::UdpSubFace::open(const Callback &callback, const ErrorCallback &error_callback) {
     _callback = callback;
     _error_callback = error_callback;
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    _timer.async_wait(boost::bind(&UdpSubFace::timerHandler, shared_from_this(), _1, false));
 }
 
 void UdpMasterFace::UdpSubFace::close() {
@@ -38,139 +56,541 @@ void UdpMasterFace::UdpSubFace::close() {
 }
 
 void UdpMasterFace::UdpSubFace::send(const NdnPacket &packet) {
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    _master_face._strand.post(boost::bind(&UdpMasterFace::sendImpl, _master_face.shared_from_this(), packet, _endpoint));
+    touch();
+    _listener.handOff(Listener::Outgoing{shared_from_this(), packet});
 }
 
 void UdpMasterFace::UdpSubFace::proceedPacket(const char *buffer, size_t size) {
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    try {
-        switch (buffer[0]) {
-            case 0x05:
-                _callback(NdnPacket(buffer, size));
-                break;
-            case 0x06:
-                _callback(NdnPacket(buffer, size));
-                break;
-            default:
-                break;
-        }
-    } catch (const std::exception &e) {
-        std::cerr << e.what() << std::endl;
-    }
-}
-
-void UdpMasterFace::UdpSubFace::timerHandler(const boost::system::error_code &err, bool last_chance) {
-    if (_timer.expires_at() <= boost::asio::deadline_timer::traits_type::now()) {
-        if (!last_chance) {
-            // endpoint must manifest itself in the given time, else the socket will close (icmp or timeout)
-            _master_face._strand.post(boost::bind(&UdpMasterFace::sendImpl, _master_face.shared_from_this(), NdnPacket("0", 1), _endpoint));
-            _timer.expires_from_now(boost::posix_time::seconds(2));
-            _timer.async_wait(boost::bind(&UdpSubFace::timerHandler, shared_from_this(), _1, true));
+    touch();
+    const char *it = buffer;
+    const char *packet;
+    size_t packet_size;
+    // a datagram may carry several packets, and a fragment only yields a packet once the others arrived
+    while (_reassembler.unpack(it, buffer + size, packet, packet_size)) {
+        try {
+            switch (packet[0]) {
+                case 0x05:
+                    _callback(NdnPacket(packet, packet_size));
+                    break;
+                case 0x06:
+                    _callback(NdnPacket(packet, packet_size));
+                    break;
+                default:
+                    break;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+}
+
+void UdpMasterFace::UdpSubFace::sendImpl(NdnPacket packet) {
+    bool was_empty = _queue.empty();
+    bool is_data = packet.getType() == NdnPacket::DATA;
+    // the fragments of a packet larger than the MTU are queued in its place
+    if (!_fragmenter.fragment(packet.getData().data(), packet.getData().size(), [this, is_data](const char *fragment, size_t size) {
+        _queue.push(NdnPacket(fragment, size), size, is_data);
+    })) {
+        size_t size = packet.getData().size();
+        _queue.push(std::move(packet), size, is_data);
+    }
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    UdpMasterFace &master_face = _listener._master_face;
+    size_t queued_bytes = _queue.getStats().bytes;
+    if (_is_flush_pending) {
+        // a full datagram doesn't wait
+        if (queued_bytes >= _fragmenter.getDatagramSize()) {
+            _flush_timer.cancel();
+        }
+    } else if (was_empty && !_queue.empty()) {
+        if (master_face._aggregation && master_face._aggregation_delay > boost::posix_time::time_duration()
+            && queued_bytes < _fragmenter.getDatagramSize()) {
+            _is_flush_pending = true;
+            _flush_timer.expires_from_now(master_face._aggregation_delay);
+            _flush_timer.async_wait(_listener._strand.wrap(boost::bind(&UdpSubFace::flushHandler, shared_from_this(), _1)));
         } else {
+            _listener.schedule(shared_from_this());
+        }
+    }
+}
+
+void UdpMasterFace::UdpSubFace::flushHandler(const boost::system::error_code &err) {
+    _is_flush_pending = false;
+    if (!_queue.empty()) {
+        _listener.schedule(shared_from_this());
+    }
+}
+
+void UdpMasterFace::UdpSubFace::touch() {
+    _last_activity.store(_listener._ticks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+UdpMasterFace::Listener::Listener(UdpMasterFace &master_face, boost::asio::io_service &ios,
+                                  const boost::asio::ip::udp::endpoint &local_endpoint, bool reuse, IoBackend backend)
+        : _master_face(master_face)
+        , _ios(ios)
+        , _socket(ios)
+        , _strand(ios)
+        , _sweep_timer(ios)
+        , _ring_event(ios) {
+    _socket.open(local_endpoint.protocol());
+#ifdef SO_REUSEPORT
+    if (reuse) {
+        _socket.set_option(reuse_port(true));
+    }
+#endif
+    _socket.bind(local_endpoint);
+    if (backend == IoBackend::IO_URING) {
+        try {
+            ringOpen();
+        } catch (const std::system_error &e) {
             std::stringstream ss;
-            ss << "no activity from/to " << _endpoint << " since 5s" << std::endl;
-            logger::log(logger::INFO, ss.str());
-            _error_callback(shared_from_this());
+            ss << "io_uring unavailable for udp://" << local_endpoint << " (" << e.what() << "), using the asio backend";
+            logger::log(logger::WARNING, ss.str());
+            _ring.reset();
         }
+    }
+}
+
+void UdpMasterFace::Listener::read() {
+    if (_ring) {
+        ringRead();
+        _ring->submit();
+        ringWait();
+        return;
+    }
+    _socket.async_receive_from(boost::asio::buffer(_buffer, BUFFER_SIZE), _remote_endpoint,
+                               _strand.wrap(boost::bind(&Listener::readHandler, shared_from_this(), _1, _2)));
+}
+
+void UdpMasterFace::Listener::close() {
+    _strand.post(boost::bind(&Listener::closeImpl, shared_from_this()));
+}
+
+void UdpMasterFace::Listener::sendToAllFaces(const NdnPacket &packet) {
+    handOff(Outgoing{nullptr, packet});
+}
+
+void UdpMasterFace::Listener::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
+    if(!err) {
+        onDatagram(_buffer, bytes_transferred);
+        read();
     } else {
-        _timer.async_wait(boost::bind(&UdpSubFace::timerHandler, shared_from_this(), _1, false));
+        std::cerr << "[ERROR] " << err.message() << std::endl;
     }
 }
 
-//----------------------------------------------------------------------------------------------------------------------
+void UdpMasterFace::Listener::onDatagram(const char *buffer, size_t size) {
+    std::shared_ptr<UdpSubFace> face;
+    auto it = _faces.end();
+    if (_last_face && _last_face->_endpoint == _remote_endpoint) {
+        face = _last_face;
+        face->proceedPacket(buffer, size);
+    } else if ((it = _faces.find(_remote_endpoint)) != _faces.end()) {
+        face = it->second;
+        _last_face = face;
+        face->proceedPacket(buffer, size);
+    } else {
+        std::stringstream ss;
+        ss << "new connection from udp://" << _remote_endpoint;
+        logger::log(logger::INFO, ss.str());
+        face = std::make_shared<UdpSubFace>(*this, _remote_endpoint);
+        _master_face.prepareFace(face);
+        face->open(_master_face._face_callback, boost::bind(&Listener::onFaceError, shared_from_this(), _1));
+        _master_face._notification_callback(_master_face.shared_from_this(), face);
+        _faces.emplace(_remote_endpoint, face);
+        _last_face = face;
+        face->proceedPacket(buffer, size);
+    }
+}
 
-UdpMasterFace::UdpMasterFace(boost::asio::io_service &ios, uint16_t port)
-        : MasterFace(ios)
-        , _local_endpoint(boost::asio::ip::udp::v4(), port)
-        , _socket(_ios, boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port))
-        , _strand(_ios) {
+void UdpMasterFace::Listener::sweep() {
+    _sweep_timer.expires_from_now(boost::posix_time::seconds(1));
+    _sweep_timer.async_wait(_strand.wrap(boost::bind(&Listener::sweepHandler, shared_from_this(), _1)));
+}
 
+void UdpMasterFace::Listener::sweepHandler(const boost::system::error_code &err) {
+    if (err || !_is_open) {
+        return;
+    }
+    if (_ring_read_pending) {
+        ringRead();
+        _ring->submit();
+    }
+    uint64_t ticks = _ticks.fetch_add(1, std::memory_order_relaxed) + 1;
+    std::vector<std::shared_ptr<UdpSubFace>> idle_faces;
+    for (const auto &face : _faces) {
+        uint64_t idle = ticks - face.second->_last_activity.load(std::memory_order_relaxed);
+        if (idle > IDLE_TIMEOUT_TICKS) {
+            idle_faces.push_back(face.second);
+        } else if (idle <= KEEPALIVE_TICKS) {
+            face.second->_is_keepalive_sent = false;
+        } else if (!face.second->_is_keepalive_sent) {
+            // endpoint must manifest itself in the given time, else the socket will close (icmp or timeout)
+            face.second->_is_keepalive_sent = true;
+            face.second->sendImpl(NdnPacket("0", 1));
+        }
+    }
+    // the faces remove themselves from the table
+    for (const auto &face : idle_faces) {
+        std::stringstream ss;
+        ss << "no activity from/to " << face->_endpoint << " since " << IDLE_TIMEOUT_TICKS << "s" << std::endl;
+        logger::log(logger::INFO, ss.str());
+        face->_error_callback(face);
+    }
+    sweep();
 }
 
-std::string UdpMasterFace::getUnderlyingProtocol() const {
-    return "UDP";
+void UdpMasterFace::Listener::ringOpen() {
+    _ring.reset(new IoUring(2 * RING_SEND_SLOTS));
+    int event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd < 0) {
+        throw std::system_error(errno, std::system_category(), "eventfd");
+    }
+    _ring_event.assign(event_fd);
+    _ring->registerEventFd(event_fd);
+    _ring_buffers.reset(new char[RING_BUFFERS * RING_BUFFER_SIZE]);
+    IoUring::BufferRing &buffer_ring = _ring->setupBufferRing(0, RING_BUFFERS);
+    for (uint16_t i = 0; i < RING_BUFFERS; ++i) {
+        buffer_ring.add(_ring_buffers.get() + i * RING_BUFFER_SIZE, RING_BUFFER_SIZE, i);
+    }
+    buffer_ring.advance();
+    // only the lengths matter to a multishot recvmsg, they lay out the header of each received buffer
+    std::memset(&_ring_msg, 0, sizeof(_ring_msg));
+    _ring_msg.msg_namelen = sizeof(sockaddr_in6);
+    _send_slots.resize(RING_SEND_SLOTS);
+    for (size_t i = 0; i < RING_SEND_SLOTS; ++i) {
+        _free_send_slots.push_back(RING_SEND_SLOTS - 1 - i);
+    }
 }
 
-void UdpMasterFace::listen(const MasterFace::NotificationCallback &notification_callback, const Face::Callback &face_callback,
-                           const MasterFace::ErrorCallback &error_callback) {
-    _notification_callback = notification_callback;
-    _face_callback = face_callback;
-    _error_callback = error_callback;
-    std::stringstream ss;
-    ss << "master face with ID = " << _master_face_id << " listening on udp://" << _local_endpoint;
-    logger::log(logger::INFO, ss.str());
-    read();
+void UdpMasterFace::Listener::ringRead() {
+    io_uring_sqe *sqe = _ring->getSqe();
+    if (!sqe) {
+        _ring->submit();
+        sqe = _ring->getSqe();
+    }
+    if (!sqe) {
+        // the kernel refused the submission, the receive is retried on the next completion or sweep
+        if (!_ring_read_pending) {
+            std::stringstream ss;
+            ss << "io_uring submission queue full, receive postponed on udp://" << _socket.local_endpoint();
+            logger::log(logger::ERROR, ss.str());
+        }
+        _ring_read_pending = true;
+        return;
+    }
+    _ring_read_pending = false;
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = _socket.native_handle();
+    sqe->addr = (uint64_t)&_ring_msg;
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->user_data = RING_RECV;
 }
 
-void UdpMasterFace::close() {
+void UdpMasterFace::Listener::ringWait() {
+    _ring_event.async_read_some(boost::asio::buffer(&_ring_event_value, sizeof(_ring_event_value)),
+                                _strand.wrap(boost::bind(&Listener::ringHandler, shared_from_this(), _1, _2)));
+}
+
+void UdpMasterFace::Listener::ringHandler(const boost::system::error_code &err, size_t bytes_transferred) {
+    if (err) {
+        return;
+    }
+    bool rearm = false;
+    bool buffers_returned = false;
+    _ring->reap([&](const io_uring_cqe &cqe) {
+        if (cqe.user_data != RING_RECV) {
+            if (cqe.res < 0) {
+                std::cerr << std::strerror(-cqe.res) << std::endl;
+            }
+            _free_send_slots.push_back(cqe.user_data - 1);
+            return;
+        }
+        if (cqe.flags & IORING_CQE_F_BUFFER) {
+            uint16_t buffer_id = cqe.flags >> IORING_CQE_BUFFER_SHIFT;
+            char *buffer = _ring_buffers.get() + buffer_id * RING_BUFFER_SIZE;
+            auto *out = (io_uring_recvmsg_out*)buffer;
+            size_t header = sizeof(io_uring_recvmsg_out) + _ring_msg.msg_namelen + _ring_msg.msg_controllen;
+            if (cqe.res >= (int)header && !(out->flags & MSG_TRUNC) && out->namelen <= _ring_msg.msg_namelen) {
+                std::memcpy(_remote_endpoint.data(), buffer + sizeof(io_uring_recvmsg_out), out->namelen);
+                _remote_endpoint.resize(out->namelen);
+                onDatagram(buffer + header, out->payloadlen);
+            }
+            _ring->getBufferRing().add(buffer, RING_BUFFER_SIZE, buffer_id);
+            buffers_returned = true;
+        }
+        if (!(cqe.flags & IORING_CQE_F_MORE)) {
+            // the kernel stops a multishot receive when it runs out of buffers, on shutdown or on error
+            if (cqe.res >= 0 || cqe.res == -ENOBUFS) {
+                rearm = true;
+            } else {
+                std::cerr << "[ERROR] " << std::strerror(-cqe.res) << std::endl;
+            }
+        }
+    });
+    if (buffers_returned) {
+        _ring->getBufferRing().advance();
+    }
+    if (!_is_open) {
+        return;
+    }
+    if (rearm || _ring_read_pending) {
+        ringRead();
+    }
+    ringSend();
+    ringWait();
+}
+
+void UdpMasterFace::Listener::ringSend() {
+    _ring_send_pending = false;
+    if (!_is_open) {
+        for (const auto &face : _ready) {
+            face->_queue.clear();
+        }
+        _ready.clear();
+        return;
+    }
+    while (!_ready.empty() && !_free_send_slots.empty()) {
+        if (_ready.front()->_queue.empty()) {
+            _ready.pop_front();
+            continue;
+        }
+        io_uring_sqe *sqe = _ring->getSqe();
+        if (!sqe) {
+            break;
+        }
+        std::shared_ptr<UdpSubFace> face = _ready.front();
+        _ready.pop_front();
+        size_t index = _free_send_slots.back();
+        _free_send_slots.pop_back();
+        SendSlot &slot = _send_slots[index];
+        // the packets are copied in the slot, so they leave the queue of the face right away
+        slot.data.clear();
+        size_t count = gather(*face, [&slot](const std::vector<char> &data) {
+            slot.data.insert(slot.data.end(), data.begin(), data.end());
+        });
+        slot.endpoint = face->_endpoint;
+        slot.iov.iov_base = slot.data.data();
+        slot.iov.iov_len = slot.data.size();
+        std::memset(&slot.msg, 0, sizeof(slot.msg));
+        slot.msg.msg_name = slot.endpoint.data();
+        slot.msg.msg_namelen = slot.endpoint.size();
+        slot.msg.msg_iov = &slot.iov;
+        slot.msg.msg_iovlen = 1;
+        sqe->opcode = IORING_OP_SENDMSG;
+        sqe->fd = _socket.native_handle();
+        sqe->addr = (uint64_t)&slot.msg;
+        sqe->len = 1;
+        sqe->user_data = index + 1;
+        for (size_t i = 0; i < count; ++i) {
+            face->_queue.pop();
+        }
+        face->updateCongestion(face, face->_queue.isCongested());
+        if (!face->_queue.empty()) {
+            _ready.push_back(face);
+        }
+    }
+    _ring->submit();
+}
+
+template<typename Sink>
+size_t UdpMasterFace::Listener::gather(UdpSubFace &face, Sink &&sink) {
+    size_t datagram_size = face._fragmenter.getDatagramSize();
+    size_t bytes = 0;
+    size_t count = 0;
+    face._queue.forEach(_master_face._aggregation ? MAX_AGGREGATED_PACKETS : 1, [&](const NdnPacket &packet) -> bool {
+        const std::vector<char> &data = packet.getData();
+        bool can_aggregate = LpFragmenter::canAggregate(data.data(), data.size());
+        if (count > 0 && (!can_aggregate || bytes + data.size() > datagram_size)) {
+            return false;
+        }
+        sink(data);
+        // a packet that can't be aggregated fills the datagram on its own
+        bytes += can_aggregate ? data.size() : datagram_size;
+        ++count;
+        return true;
+    });
+    return count;
+}
+
+void UdpMasterFace::Listener::closeImpl() {
+    _is_open = false;
+    _sweep_timer.cancel();
+    if (_ring) {
+        // the ring holds its own reference on the socket, a shutdown ends the multishot receive
+        ::shutdown(_socket.native_handle(), SHUT_RDWR);
+        _ring_event.cancel();
+    }
     _socket.close();
-    for(const auto &face : _faces) {
+    // faces remove themselves from the table when closed
+    auto faces = _faces;
+    for(const auto &face : faces) {
         face.second->close();
     }
 }
 
-void UdpMasterFace::sendToAllFaces(const NdnPacket &packet) {
+void UdpMasterFace::Listener::sendToAllFacesImpl(const NdnPacket &packet) {
     for(const auto &face : _faces) {
-        face.second->send(packet);
+        face.second->touch();
+        face.second->sendImpl(packet);
     }
 }
 
-void UdpMasterFace::read() {
-    _socket.async_receive_from(boost::asio::buffer(_buffer, BUFFER_SIZE), _remote_endpoint,
-                               boost::bind(&UdpMasterFace::readHandler, shared_from_this(), _1, _2));
+void UdpMasterFace::Listener::handOff(Outgoing &&outgoing) {
+#ifdef NDN_SEND_RINGS
+    if (_send_ring.push(std::move(outgoing))) {
+        _strand.post(boost::bind(&Listener::drainSendRing, shared_from_this()));
+    }
+#else
+    _strand.post(boost::bind(&Listener::deliver, shared_from_this(), outgoing));
+#endif
 }
 
-void UdpMasterFace::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
-    if(!err) {
-        std::shared_ptr<UdpSubFace> face;
-        auto it = _faces.find(_remote_endpoint);
-        if (it != _faces.end()) {
-            face = it->second;
-            face->proceedPacket(_buffer, bytes_transferred);
-        } else {
-            std::stringstream ss;
-            ss << "new connection from udp://" << _remote_endpoint;
-            logger::log(logger::INFO, ss.str());
-            face = std::make_shared<UdpSubFace>(*this, _remote_endpoint);
-            face->open(_face_callback, boost::bind(&UdpMasterFace::onFaceError, shared_from_this(), _1));
-            _notification_callback(shared_from_this(), face);
-            _faces.emplace(_remote_endpoint, face);
-            face->proceedPacket(_buffer, bytes_transferred);
-        }
-        read();
+void UdpMasterFace::Listener::drainSendRing() {
+    // the rest waits for a later turn of the strand, so the datagrams received aren't held back
+    if (_send_ring.drain([this](Outgoing &&outgoing) {
+        deliver(std::move(outgoing));
+    }, SEND_RING_SIZE)) {
+        _strand.post(boost::bind(&Listener::drainSendRing, shared_from_this()));
+    }
+}
+
+void UdpMasterFace::Listener::deliver(Outgoing outgoing) {
+    if (outgoing.face) {
+        outgoing.face->sendImpl(std::move(outgoing.packet));
     } else {
-        std::cerr << "[ERROR] " << err.message() << std::endl;
+        sendToAllFacesImpl(outgoing.packet);
     }
 }
 
-void UdpMasterFace::sendImpl(const NdnPacket &packet, const boost::asio::ip::udp::endpoint &endpoint) {
-    _queue.emplace_back(packet, endpoint);
-    if (_queue.size() == 1) {
+void UdpMasterFace::Listener::schedule(const std::shared_ptr<UdpSubFace> &face) {
+    _ready.push_back(face);
+    if (_ring) {
+        // everything sent until the end of the current strand turn is submitted at once
+        if (!_ring_send_pending) {
+            _ring_send_pending = true;
+            _strand.post(boost::bind(&Listener::ringSend, shared_from_this()));
+        }
+    } else if (!_is_writing) {
         write();
     }
 }
 
-void UdpMasterFace::write() {
-    auto &message = _queue.front();
-    _socket.async_send_to(boost::asio::buffer(message.first.getData()), message.second,
-                          _strand.wrap(boost::bind(&UdpMasterFace::writeHandler, shared_from_this(), _1, _2)));
+void UdpMasterFace::Listener::write() {
+    // skip the faces left without packets
+    while (!_ready.empty() && _ready.front()->_queue.empty()) {
+        _ready.pop_front();
+    }
+    _is_writing = !_ready.empty();
+    if (!_is_writing) {
+        return;
+    }
+    auto &face = _ready.front();
+    _write_buffers.clear();
+    gather(*face, [this](const std::vector<char> &data) {
+        _write_buffers.emplace_back(data.data(), data.size());
+    });
+    face->_queue.markInFlight(_write_buffers.size());
+    _socket.async_send_to(_write_buffers, face->_endpoint,
+                          _strand.wrap(boost::bind(&Listener::writeHandler, shared_from_this(), _1, _2)));
 }
 
-void UdpMasterFace::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
+void UdpMasterFace::Listener::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
     if(!err) {
-        _queue.pop_front();
-        if (!_queue.empty()) {
-            write();
+        std::shared_ptr<UdpSubFace> face = _ready.front();
+        _ready.pop_front();
+        for (size_t i = 0; i < _write_buffers.size(); ++i) {
+            face->_queue.pop();
+        }
+        face->updateCongestion(face, face->_queue.isCongested());
+        if (!face->_queue.empty()) {
+            _ready.push_back(face);
         }
+        write();
     } else {
         std::cerr << err.message() << std::endl;
     }
 }
 
-void UdpMasterFace::onFaceError(const std::shared_ptr<Face> &face) {
-    _faces.erase(((UdpSubFace*)face.get())->getEndpoint());
-    _error_callback(shared_from_this(), face);
+void UdpMasterFace::Listener::onFaceError(const std::shared_ptr<Face> &face) {
+    _strand.dispatch([this, face]() {
+        if (_last_face == face) {
+            _last_face.reset();
+        }
+        _faces.erase(((UdpSubFace*)face.get())->getEndpoint());
+        _master_face._error_callback(_master_face.shared_from_this(), face);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+
+size_t UdpMasterFace::EndpointHash::operator()(const boost::asio::ip::udp::endpoint &endpoint) const {
+    boost::asio::ip::address address = endpoint.address();
+    uint64_t key = endpoint.port();
+    if (address.is_v4()) {
+        key |= (uint64_t)address.to_v4().to_uint() << 16;
+    } else {
+        for (uint8_t byte : address.to_v6().to_bytes()) {
+            key = key * 31 + byte;
+        }
+    }
+    return std::hash<uint64_t>()(key);
+}
+
+UdpMasterFace::UdpMasterFace(boost::asio::io_service &ios, uint16_t port, size_t listeners, IoBackend backend,
+                             const CoreAssigner &core_assigner)
+        : MasterFace(ios, core_assigner)
+        , _local_endpoint(boost::asio::ip::udp::v4(), port) {
+#ifndef SO_REUSEPORT
+    listeners = 1;
+#endif
+    for (size_t i = 0; i < std::max<size_t>(listeners, 1); ++i) {
+        _listeners.emplace_back(std::make_shared<Listener>(*this, assignCore(), _local_endpoint, listeners > 1, backend));
+    }
+}
+
+std::string UdpMasterFace::getUnderlyingProtocol() const {
+    return "UDP";
+}
+
+void UdpMasterFace::setMtu(size_t mtu) {
+    _mtu.store(mtu, std::memory_order_relaxed);
 }
 
+void UdpMasterFace::setAggregation(bool enabled, const boost::posix_time::time_duration &delay) {
+    _aggregation = enabled;
+    _aggregation_delay = delay;
+}
+
+void UdpMasterFace::listen(const MasterFace::NotificationCallback &notification_callback, const Face::Callback &face_callback,
+                           const MasterFace::ErrorCallback &error_callback) {
+    _notification_callback = notification_callback;
+    _face_callback = face_callback;
+    _error_callback = error_callback;
+    std::stringstream ss;
+    ss << "master face with ID = " << _master_face_id << " listening on udp://" << _local_endpoint
+       << " with " << _listeners.size() << " sockets";
+    logger::log(logger::INFO, ss.str());
+    for (const auto &listener : _listeners) {
+        listener->read();
+        listener->sweep();
+    }
+}
 
+void UdpMasterFace::close() {
+    for (const auto &listener : _listeners) {
+        listener->close();
+    }
+}
+
+void UdpMasterFace::sendToAllFaces(const NdnPacket &packet) {
+    for (const auto &listener : _listeners) {
+        listener->sendToAllFaces(packet);
+    }
+}
@@ -1,29 +1,69 @@
 #pragma once
 
-#include <map>
 #include <deque>
+#include <unordered_map>
+#include <vector>
 
 #include "master_face.h"
 #include "face.h"
+#include "io_uring.h"
+#include "lp_fragmenter.h"
+#include "lp_reassembler.h"
+#include "send_ring.h"
 
 class UdpSubFace;
 
+// Listens with one SO_REUSEPORT socket per listener, the kernel spreads the remote endpoints over the sockets
+// by hashing their 4-tuple so a given endpoint always reaches the same listener. Each listener owns its strand,
+// its sub-faces and its send queue, so listeners read and write in parallel without sharing any state.
+// Each sub-face has its own bounded transmit queue and a listener sends one datagram of each sub-face with packets
+// waiting in turn, so a slow or flooded remote endpoint doesn't delay the others.
+// The sub-faces don't arm a timer per packet, they note the sweep tick of their last activity and a sweep of the
+// sub-faces of each listener every second sends the keepalives and closes the idle ones.
+// The packets sent on the sub-faces or to all of them, from any thread, are posted to the listener. Built with
+// NDN_SEND_RINGS they are handed over through a SendRing instead, a handler is then only posted when none is pending.
+// With the io_uring backend a listener also owns a ring: one multishot recvmsg keeps receiving into buffers the
+// kernel picks from a provided buffer ring, and the datagrams sent during a strand turn go out with one syscall.
 class UdpMasterFace : public MasterFace, public std::enable_shared_from_this<UdpMasterFace> {
 public:
     static const size_t BUFFER_SIZE = 1 << 16;
+    static const size_t MAX_AGGREGATED_PACKETS = 64;
+    static const size_t SEND_RING_SIZE = 1024;
+    // in sweeps, a face idle for longer is sent a keepalive, then closed
+    static const uint64_t KEEPALIVE_TICKS = 3;
+    static const uint64_t IDLE_TIMEOUT_TICKS = 5;
+
+    struct EndpointHash {
+        size_t operator()(const boost::asio::ip::udp::endpoint &endpoint) const;
+    };
+
+    class Listener;
 
     class UdpSubFace : public Face, public std::enable_shared_from_this<UdpSubFace> {
     private:
-        UdpMasterFace &_master_face;
+        Listener &_listener;
 
         boost::asio::ip::udp::endpoint _endpoint;
-        boost::asio::deadline_timer _timer;
+        // sweep tick of the last packet received or sent, set from any thread
+        std::atomic<uint64_t> _last_activity;
+        bool _is_keepalive_sent = false;
+        TxQueue<NdnPacket> _queue;
+        LpFragmenter _fragmenter;
+        LpReassembler _reassembler;
+        bool _is_flush_pending = false;
+        boost::asio::deadline_timer _flush_timer;
+
+        friend class Listener;
 
     public:
-        UdpSubFace(UdpMasterFace &master_face, const boost::asio::ip::udp::endpoint &endpoint);
+        UdpSubFace(Listener &listener, const boost::asio::ip::udp::endpoint &endpoint);
 
         ~UdpSubFace() override = default;
 
+        void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+        TxQueueStats getTxQueueStats() const override;
+
         std::string getUnderlyingProtocol() const override;
 
         std::string getUnderlyingEndpoint() const override;
@@ -36,45 +76,153 @@ public:
 
         void send(const NdnPacket &packet) override;
 
+        // must be called from the strand of the listener
         void proceedPacket(const char* buffer, size_t size);
 
     private:
-        void timerHandler(const boost::system::error_code &err, bool last_chance);
+        void sendImpl(NdnPacket packet);
+
+        void flushHandler(const boost::system::error_code &err);
+
+        void touch();
     };
 
-private:
-    boost::asio::ip::udp::endpoint _local_endpoint;
-    boost::asio::ip::udp::endpoint _remote_endpoint;
-    boost::asio::ip::udp::socket _socket;
-    boost::asio::strand _strand;
-    char _buffer[BUFFER_SIZE];
+    class Listener : public std::enable_shared_from_this<Listener> {
+    private:
+        static const uint16_t RING_BUFFERS = 256;
+        static const size_t RING_BUFFER_SIZE = 9216;
+        static const size_t RING_SEND_SLOTS = 128;
+        static const uint64_t RING_RECV = 0;
+
+        struct SendSlot {
+            std::vector<char> data;
+            boost::asio::ip::udp::endpoint endpoint;
+            iovec iov;
+            msghdr msg;
+        };
+
+        // a packet for one of the sub-faces, or for all of them without a face
+        struct Outgoing {
+            std::shared_ptr<UdpSubFace> face;
+            NdnPacket packet;
+        };
 
-    std::map<boost::asio::ip::udp::endpoint, std::shared_ptr<UdpSubFace>> _faces;
-    std::deque<std::pair<const NdnPacket, const boost::asio::ip::udp::endpoint>> _queue;
+        UdpMasterFace &_master_face;
+        boost::asio::io_service &_ios;
+
+        boost::asio::ip::udp::endpoint _remote_endpoint;
+        boost::asio::ip::udp::socket _socket;
+        boost::asio::strand _strand;
+        char _buffer[BUFFER_SIZE];
+
+        std::unordered_map<boost::asio::ip::udp::endpoint, std::shared_ptr<UdpSubFace>, EndpointHash> _faces;
+        // the sub-face of the last datagram, a burst from the same endpoint skips the lookup
+        std::shared_ptr<UdpSubFace> _last_face;
+        // the sub-faces with packets waiting, in the order they are served
+        std::deque<std::shared_ptr<UdpSubFace>> _ready;
+        SendRing<Outgoing> _send_ring {SEND_RING_SIZE};
+        bool _is_writing = false;
+        std::vector<boost::asio::const_buffer> _write_buffers;
+        boost::asio::deadline_timer _sweep_timer;
+        // coarse clock of the sub-faces, counts the sweeps
+        std::atomic<uint64_t> _ticks {0};
+
+        bool _is_open = true;
+        std::unique_ptr<char[]> _ring_buffers;
+        msghdr _ring_msg;
+        std::vector<SendSlot> _send_slots;
+        std::vector<size_t> _free_send_slots;
+        bool _ring_send_pending = false;
+        // the multishot receive could not be queued and must be re-armed
+        bool _ring_read_pending = false;
+        uint64_t _ring_event_value;
+        boost::asio::posix::stream_descriptor _ring_event;
+        // declared last so it is torn down before the buffers it points to
+        std::unique_ptr<IoUring> _ring;
+
+        friend class UdpSubFace;
 
-public:
-    UdpMasterFace(boost::asio::io_service &ios, uint16_t port);
+    public:
+        Listener(UdpMasterFace &master_face, boost::asio::io_service &ios, const boost::asio::ip::udp::endpoint &local_endpoint,
+                 bool reuse, IoBackend backend);
 
-    ~UdpMasterFace() override = default;
+        ~Listener() = default;
 
-    std::string getUnderlyingProtocol() const override;
+        void read();
 
-    void listen(const NotificationCallback &notification_callback, const Face::Callback &face_callback, const ErrorCallback &error_callback) override;
+        void sweep();
 
-    void close() override;
+        void close();
 
-    void sendToAllFaces(const NdnPacket &packet) override;
+        void sendToAllFaces(const NdnPacket &packet);
+
+    private:
+        void readHandler(const boost::system::error_code &err, size_t bytes_transferred);
+
+        void onDatagram(const char *buffer, size_t size);
+
+        void sweepHandler(const boost::system::error_code &err);
+
+        void ringOpen();
+
+        void ringRead();
+
+        void ringWait();
+
+        void ringHandler(const boost::system::error_code &err, size_t bytes_transferred);
+
+        void ringSend();
+
+        // calls sink(packet) on the first packets of the face that fit a datagram, returns how many
+        template<typename Sink>
+        size_t gather(UdpSubFace &face, Sink &&sink);
+
+        void closeImpl();
+
+        void sendToAllFacesImpl(const NdnPacket &packet);
+
+        void handOff(Outgoing &&outgoing);
+
+        void drainSendRing();
+
+        void deliver(Outgoing outgoing);
+
+        void schedule(const std::shared_ptr<UdpSubFace> &face);
+
+        void write();
+
+        void writeHandler(const boost::system::error_code &err, size_t bytesTransferred);
+
+        void onFaceError(const std::shared_ptr<Face> &face);
+    };
 
 private:
-    void read();
+    boost::asio::ip::udp::endpoint _local_endpoint;
+    std::vector<std::shared_ptr<Listener>> _listeners;
+    // read by the listeners when they accept a face
+    std::atomic<size_t> _mtu {LpFragmenter::DEFAULT_MTU};
+    bool _aggregation = false;
+    boost::posix_time::time_duration _aggregation_delay;
+
+public:
+    // listeners > 1 requires SO_REUSEPORT, usually one listener per io thread, each listener and its sub-faces run on
+    // the io_service the core assigner gives when the listener is created
+    UdpMasterFace(boost::asio::io_service &ios, uint16_t port, size_t listeners = 1, IoBackend backend = IoBackend::ASIO,
+                  const CoreAssigner &core_assigner = CoreAssigner());
+
+    ~UdpMasterFace() override = default;
+
+    std::string getUnderlyingProtocol() const override;
 
-    void readHandler(const boost::system::error_code &err, size_t bytes_transferred);
+    // applies to the faces accepted from then on, see UdpFace::setMtu
+    void setMtu(size_t mtu);
 
-    void sendImpl(const NdnPacket &packet, const boost::asio::ip::udp::endpoint &endpoint);
+    // applies to all the faces of the master face, must be called before it listens, see UdpFace::setAggregation
+    void setAggregation(bool enabled, const boost::posix_time::time_duration &delay = boost::posix_time::time_duration());
 
-    void write();
+    void listen(const NotificationCallback &notification_callback, const Face::Callback &face_callback, const ErrorCallback &error_callback) override;
 
-    void writeHandler(const boost::system::error_code &err, size_t bytesTransferred);
+    void close() override;
 
-    void onFaceError(const std::shared_ptr<Face> &face);
+    void sendToAllFaces(const NdnPacket &packet) override;
 };
\ No newline at end of file
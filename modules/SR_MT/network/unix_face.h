@@ -0,0 +1,83 @@
+#pragma once
+
+#include "face.h"
+#include "send_ring.h"
+#include "tlv_framer.h"
+
+#include <boost/asio.hpp>
+
+#include <iostream>
+#include <string>
+#include <deque>
+#include <vector>
+
+// Stream face over a Unix domain socket for modules running on the same host, framed like TCP but without
+// the checksums and the loopback interface on the path.
+class UnixFace : public Face, public std::enable_shared_from_this<UnixFace> {
+public:
+    static const size_t NDN_MAX_PACKET_SIZE = 8800;
+    static const size_t BUFFER_SIZE = 1 << 15;
+    static const size_t SEND_RING_SIZE = 256;
+
+private:
+    bool _skip_connect;
+
+    boost::asio::local::stream_protocol::endpoint _endpoint;
+    boost::asio::local::stream_protocol::socket _socket;
+    TlvFramer _framer;
+    bool is_writing = false;
+    TxQueue<NdnPacket> _queue;
+    // packets handed over by the threads sending on the face, drained from the strand
+    SendRing<NdnPacket> _send_ring {SEND_RING_SIZE};
+
+    boost::asio::strand _strand;
+    boost::asio::deadline_timer _timer;
+
+public:
+    // use this when creating a face yourself, path is the socket of a UnixMasterFace
+    UnixFace(boost::asio::io_service &ios, const std::string &path);
+
+    // specific constructor for MasterFace, not recommended to use it yourself
+    explicit UnixFace(boost::asio::local::stream_protocol::socket &&socket);
+
+    ~UnixFace() override = default;
+
+    void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+    TxQueueStats getTxQueueStats() const override;
+
+    std::string getUnderlyingProtocol() const override;
+
+    std::string getUnderlyingEndpoint() const override;
+
+    void open(const Callback &callback, const ErrorCallback &error_callback) override;
+
+    void close() override;
+
+    void send(const NdnPacket &packet) override;
+
+private:
+    void connect();
+
+    void connectHandler(const boost::system::error_code &err);
+
+    void reconnect(size_t remaining_attempt);
+
+    void reconnectHandler(const boost::system::error_code &err, size_t remaining_attempt);
+
+    void read();
+
+    void readHandler(const boost::system::error_code &err, size_t bytes_transferred);
+
+    std::vector<NdnPacket> findPackets();
+
+    void sendImpl(NdnPacket packet);
+
+    void drainSendRing();
+
+    void write();
+
+    void writeHandler(const boost::system::error_code &err, size_t bytesTransferred);
+
+    void timerHandler(const boost::system::error_code &err);
+};
\ No newline at end of file
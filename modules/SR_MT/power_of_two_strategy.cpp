@@ -0,0 +1,25 @@
+#include "power_of_two_strategy.h"
+
+#include <random>
+
+size_t PowerOfTwoStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
+    if (faces.empty()) {
+        return 0;
+    }
+    if (faces.size() == 1) {
+        selected[0] = 0;
+        return 1;
+    }
+    static thread_local std::minstd_rand random(std::random_device{}());
+    size_t first = random() % faces.size();
+    size_t second = random() % (faces.size() - 1);
+    if (second >= first) {
+        ++second;
+    }
+    selected[0] = faces[second]->getOutstandingInterests() < faces[first]->getOutstandingInterests() ? second : first;
+    return 1;
+}
+
+bool PowerOfTwoStrategy::needsMeasurements() const {
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "strategy.h"
+
+// Draws two distinct faces at random and sends to the one with the fewest outstanding Interests,
+// a slow face builds up outstanding Interests and stops being chosen until it catches up.
+class PowerOfTwoStrategy : public Strategy {
+private:
+
+public:
+    PowerOfTwoStrategy() = default;
+
+    ~PowerOfTwoStrategy() override = default;
+
+    size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) override;
+
+    bool needsMeasurements() const override;
+};
\ No newline at end of file
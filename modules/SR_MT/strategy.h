@@ -13,5 +13,15 @@ public:
 
     virtual ~Strategy() = default;
 
-    virtual std::vector<std::shared_ptr<Face>> selectFaces(const std::vector<std::shared_ptr<Face>> &faces) = 0;
+    // also the most egress faces a router accepts, so that a strategy can select any of them
+    static const size_t MAX_SELECTED_FACES = 64;
+
+    // called concurrently by the io threads, writes the indices in faces of the chosen faces to selected, which
+    // holds MAX_SELECTED_FACES indices, and returns how many were chosen
+    virtual size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) = 0;
+
+    // the router only tracks pending Interests, and so the outstanding Interests of the faces, when asked to
+    virtual bool needsMeasurements() const {
+        return false;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "strategy_choice.h"
+
+#include <cctype>
+#include <cstring>
+#include <sstream>
+
+StrategyChoice::StrategyChoice(const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy) {
+    insert("/", strategy_name, strategy);
+}
+
+const StrategyChoice::Entry* StrategyChoice::find(const std::string &prefix) const {
+    std::string encoded_prefix;
+    size_t components;
+    if (!encodePrefix(prefix, encoded_prefix, components)) {
+        return nullptr;
+    }
+    auto it = findEntry(encoded_prefix);
+    return it != _entries.end() ? &it->second : nullptr;
+}
+
+const StrategyChoice::Entry& StrategyChoice::findLongestPrefixMatch(const NdnPacket &packet) const {
+    uint64_t hashes[MAX_COMPONENTS + 1];
+    size_t sizes[MAX_COMPONENTS + 1];
+    size_t components = packet.hashNamePrefixes(hashes, sizes, _max_components);
+    const char *name = nullptr;
+    size_t size;
+    packet.getName(name, size);
+    for (size_t i = components; i > 0; --i) {
+        auto range = _entries.equal_range(hashes[i]);
+        for (auto it = range.first; it != range.second; ++it) {
+            const auto &encoded_prefix = it->second.encoded_prefix;
+            if (encoded_prefix.size() == sizes[i] && std::memcmp(encoded_prefix.data(), name, sizes[i]) == 0) {
+                return it->second;
+            }
+        }
+    }
+    // hashes[0] is the hash of the root prefix
+    return _entries.find(hashes[0])->second;
+}
+
+bool StrategyChoice::insert(const std::string &prefix, const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy) {
+    std::string encoded_prefix;
+    size_t components;
+    if (!encodePrefix(prefix, encoded_prefix, components) || components > MAX_COMPONENTS) {
+        return false;
+    }
+    auto it = findEntry(encoded_prefix);
+    if (it != _entries.end()) {
+        _entries.erase(it);
+    }
+    uint64_t hash = NdnPacket::hashBytes(NdnPacket::HASH_OFFSET_BASIS, encoded_prefix.data(),
+                                         encoded_prefix.data() + encoded_prefix.size());
+    _entries.emplace(hash, Entry{prefix, encoded_prefix, strategy_name, strategy});
+    _max_components = std::max(_max_components, components);
+    return true;
+}
+
+bool StrategyChoice::remove(const std::string &prefix) {
+    std::string encoded_prefix;
+    size_t components;
+    if (!encodePrefix(prefix, encoded_prefix, components) || encoded_prefix.empty()) {
+        return false;
+    }
+    auto it = findEntry(encoded_prefix);
+    if (it == _entries.end()) {
+        return false;
+    }
+    _entries.erase(it);
+    _max_components = 0;
+    for (const auto &entry : _entries) {
+        encodePrefix(entry.second.prefix, encoded_prefix, components);
+        _max_components = std::max(_max_components, components);
+    }
+    return true;
+}
+
+std::string StrategyChoice::toJSON() const {
+    std::stringstream ss;
+    ss << "[";
+    bool first = true;
+    for (const auto &entry : _entries) {
+        if (first) {
+            first = false;
+        } else {
+            ss << ", ";
+        }
+        ss << R"({"prefix":")" << entry.second.prefix << R"(", "strategy":")" << entry.second.strategy_name << R"("})";
+    }
+    ss << "]";
+    return ss.str();
+}
+
+bool StrategyChoice::encodePrefix(const std::string &prefix, std::string &encoded_prefix, size_t &components) {
+    encoded_prefix.clear();
+    components = 0;
+    if (prefix.empty() || prefix[0] != '/') {
+        return false;
+    }
+    size_t begin = 1;
+    while (begin < prefix.size()) {
+        size_t end = std::min(prefix.find('/', begin), prefix.size());
+        std::string component;
+        for (size_t i = begin; i < end; ++i) {
+            if (prefix[i] == '%') {
+                if (i + 2 >= end || !std::isxdigit(prefix[i + 1]) || !std::isxdigit(prefix[i + 2])) {
+                    return false;
+                }
+                component.push_back((char)std::stoi(prefix.substr(i + 1, 2), nullptr, 16));
+                i += 2;
+            } else {
+                component.push_back(prefix[i]);
+            }
+        }
+        if (!component.empty()) {
+            encoded_prefix.push_back(0x08);
+            if (component.size() < 253) {
+                encoded_prefix.push_back((char)component.size());
+            } else {
+                encoded_prefix.push_back((char)253);
+                encoded_prefix.push_back((char)(component.size() >> 8));
+                encoded_prefix.push_back((char)component.size());
+            }
+            encoded_prefix += component;
+            ++components;
+        }
+        begin = end + 1;
+    }
+    return true;
+}
+
+std::unordered_multimap<uint64_t, StrategyChoice::Entry>::const_iterator StrategyChoice::findEntry(const std::string &encoded_prefix) const {
+    uint64_t hash = NdnPacket::hashBytes(NdnPacket::HASH_OFFSET_BASIS, encoded_prefix.data(),
+                                         encoded_prefix.data() + encoded_prefix.size());
+    auto range = _entries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second.encoded_prefix == encoded_prefix) {
+            return it;
+        }
+    }
+    return _entries.end();
+}
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "strategy.h"
+#include "network/ndn_packet.h"
+
+// Strategy applied to each name prefix, a packet is forwarded by the strategy of its longest matching prefix.
+// Packets are not decoded in SR_MT so prefixes are stored by the hash of their encoded components, and the lookup
+// hashes the name of the packet once and probes its prefixes from the longest one able to match. Each prefix owns
+// its strategy instance. The table is copied with the forwarding snapshot, the copies share the strategies.
+class StrategyChoice {
+public:
+    static const size_t MAX_COMPONENTS = 64;
+
+    struct Entry {
+        std::string prefix;
+        std::string encoded_prefix;
+        std::string strategy_name;
+        std::shared_ptr<Strategy> strategy;
+    };
+
+private:
+    std::unordered_multimap<uint64_t, Entry> _entries;
+    size_t _max_components = 0;
+
+public:
+    StrategyChoice(const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy);
+
+    ~StrategyChoice() = default;
+
+    const Entry* find(const std::string &prefix) const;
+
+    const Entry& findLongestPrefixMatch(const NdnPacket &packet) const;
+
+    // false if the prefix is not a valid URI
+    bool insert(const std::string &prefix, const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy);
+
+    // the root prefix can't be removed
+    bool remove(const std::string &prefix);
+
+    std::string toJSON() const;
+
+private:
+    // TLV encoding of the components of an URI, as GenericNameComponents
+    static bool encodePrefix(const std::string &prefix, std::string &encoded_prefix, size_t &components);
+
+    std::unordered_multimap<uint64_t, Entry>::const_iterator findEntry(const std::string &encoded_prefix) const;
+};
\ No newline at end of file
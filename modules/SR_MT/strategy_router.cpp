@@ -7,44 +7,85 @@
 #include "multicast_strategy.h"
 #include "failover_strategy.h"
 #include "loadbalancing_strategy.h"
+#include "power_of_two_strategy.h"
 #include "network/tcp_master_face.h"
 #include "network/tcp_face.h"
 #include "network/udp_master_face.h"
 #include "network/udp_face.h"
+#include "network/unix_master_face.h"
+#include "network/unix_face.h"
+#include "network/shm_master_face.h"
+#include "network/shm_face.h"
 #include "log/logger.h"
 
-StrategyRouter::StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port)
-        : Module(4)
+StrategyRouter::StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port, IoBackend backend,
+                               Runtime runtime)
+        : Module(4, runtime)
         , _name(name)
+        , _measurement_timer(_ios)
         , _command_socket(_ios, {{}, local_command_port}) {
-    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, local_port);
-    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, local_port);
+    // with Runtime::PER_CORE each face is given a core of its own, the UDP listeners included
+    MasterFace::CoreAssigner core_assigner = [this]() -> boost::asio::io_service& { return assignCore(); };
+    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, local_port, backend, core_assigner);
+    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, local_port, _concurrency, backend, core_assigner);
+    _unix_ingress_master_face = std::make_shared<UnixMasterFace>(_ios, UnixMasterFace::getSocketPath(name), core_assigner);
+    _shm_ingress_master_face = std::make_shared<ShmMasterFace>(_ios, ShmMasterFace::getSocketPath(name), core_assigner);
+    _snapshot = new ForwardingSnapshot{{}, StrategyChoice("multicast", std::make_shared<MulticastStrategy>())};
+}
+
+StrategyRouter::~StrategyRouter() {
+    // io threads are stopped at this point
+    delete _snapshot.load();
 }
 
 void StrategyRouter::run() {
-    _strategy = std::make_shared<MulticastStrategy>();
-    _strategy_name = "multicast";
     commandRead();
+    _measurement_timer.expires_from_now(boost::posix_time::milliseconds(100));
+    _measurement_timer.async_wait(boost::bind(&StrategyRouter::measurementTimerHandler, this, _1));
+    _tcp_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
     _tcp_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&StrategyRouter::onIngressPacket, this, _1),
                                      boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
+    _udp_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
     _udp_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&StrategyRouter::onIngressPacket, this, _1),
                                      boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
+    _unix_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
+    _unix_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
+                                      boost::bind(&StrategyRouter::onIngressPacket, this, _1),
+                                      boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
+    _shm_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
+    _shm_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
+                                     boost::bind(&StrategyRouter::onIngressPacket, this, _1),
+                                     boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
 }
 
 void StrategyRouter::onIngressPacket(const NdnPacket &packet) {
-    tbb::speculative_spin_rw_mutex::scoped_lock lock(_egress_faces_mutex, false);
-    auto egress_faces = _strategy->selectFaces(_egress_faces);
-    lock.release();
-    for (auto& egress_face : egress_faces) {
+    size_t selected[Strategy::MAX_SELECTED_FACES];
+    // the faces are used from the snapshot while it is protected, without copying their shared_ptr
+    EpochManager::Guard guard(_epoch_manager);
+    const ForwardingSnapshot *snapshot = _snapshot.load();
+    const auto &strategy = snapshot->strategy_choice.findLongestPrefixMatch(packet).strategy;
+    size_t count = strategy->selectFaces(snapshot->egress_faces, selected);
+    bool measure = strategy->needsMeasurements() && packet.getType() == NdnPacket::INTEREST;
+    auto now = MeasurementTable::Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        const auto &egress_face = snapshot->egress_faces[selected[i]];
+        if (measure) {
+            _measurements.insert(packet, egress_face, now);
+        }
         egress_face->send(packet);
     }
 }
 
-void StrategyRouter::onEgressPacket(const NdnPacket &packet) {
+void StrategyRouter::onEgressPacket(size_t face_id, const NdnPacket &packet) {
+    if (_measurements.size() > 0 && packet.getType() == NdnPacket::DATA) {
+        _measurements.satisfy(packet, face_id);
+    }
     _tcp_ingress_master_face->sendToAllFaces(packet);
     _udp_ingress_master_face->sendToAllFaces(packet);
+    _unix_ingress_master_face->sendToAllFaces(packet);
+    _shm_ingress_master_face->sendToAllFaces(packet);
 }
 
 void StrategyRouter::onMasterFaceNotification(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face> &face) {
@@ -63,14 +104,45 @@ void StrategyRouter::onFaceError(const std::shared_ptr<Face> &face) {
     std::stringstream ss;
     ss << "face with ID = " << face->getFaceId() << " can't process normally";
     logger::log(logger::ERROR, ss.str());
-    tbb::speculative_spin_rw_mutex::scoped_lock lock(_egress_faces_mutex, true);
-    for (auto& egress_face : _egress_faces) {
+    std::lock_guard<std::mutex> lock(_snapshot_mutex);
+    auto snapshot = new ForwardingSnapshot(*_snapshot.load());
+    for (auto& egress_face : snapshot->egress_faces) {
         if(egress_face == face) {
-            std::swap(egress_face, _egress_faces.back());
-            _egress_faces.pop_back();
+            std::swap(egress_face, snapshot->egress_faces.back());
+            snapshot->egress_faces.pop_back();
             break;
         }
     }
+    publish(snapshot);
+    _measurements.removeFace(face);
+}
+
+void StrategyRouter::onFaceCongestion(const std::shared_ptr<Face> &face, bool congested) {
+    // only reported to a manager, the sender of the last command may be long gone
+    boost::asio::ip::udp::endpoint manager_endpoint = getManagerEndpoint();
+    if (manager_endpoint.address() == boost::asio::ip::address_v4::any() || manager_endpoint.port() == 0) {
+        return;
+    }
+    TxQueueStats stats = face->getTxQueueStats();
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"report", "action":"face_congestion", "face_id":)" << face->getFaceId()
+       << R"(, "congested":)" << (congested ? "true" : "false") << R"(, "queued_packets":)" << stats.packets
+       << R"(, "queued_bytes":)" << stats.bytes << R"(, "dropped_packets":)" << stats.dropped_packets
+       << R"(, "dropped_bytes":)" << stats.dropped_bytes << "}";
+    // the command socket belongs to the first core, a failed report must not throw out of the packet path
+    std::string report = ss.str();
+    sendToCore(0, [this, report, manager_endpoint]() {
+        boost::system::error_code err;
+        _command_socket.send_to(boost::asio::buffer(report), manager_endpoint, 0, err);
+    });
+}
+
+void StrategyRouter::measurementTimerHandler(const boost::system::error_code &err) {
+    if (!err) {
+        _measurements.expire(MeasurementTable::Clock::now());
+        _measurement_timer.expires_from_now(boost::posix_time::milliseconds(100));
+        _measurement_timer.async_wait(boost::bind(&StrategyRouter::measurementTimerHandler, this, _1));
+    }
 }
 
 void StrategyRouter::commandRead() {
@@ -83,6 +155,8 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
         EDIT_CONFIG,
         ADD_FACE,
         DEL_FACE,
+        ADD_STRATEGIES,
+        DEL_STRATEGIES,
         LIST
     };
 
@@ -90,6 +164,8 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
             {"edit_config", EDIT_CONFIG},
             {"add_face", ADD_FACE},
             {"del_face", DEL_FACE},
+            {"add_strategies", ADD_STRATEGIES},
+            {"del_strategies", DEL_STRATEGIES},
             {"list", LIST}
     };
 
@@ -111,6 +187,12 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
                             case DEL_FACE:
                                 commandDelFace(document);
                                 break;
+                            case ADD_STRATEGIES:
+                                commandAddStrategies(document);
+                                break;
+                            case DEL_STRATEGIES:
+                                commandDelStrategies(document);
+                                break;
                             case LIST:
                                 commandList(document);
                                 break;
@@ -137,45 +219,31 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
 void StrategyRouter::commandEditConfig(const rapidjson::Document &document) {
     std::vector<std::string> changes;
     if (document.HasMember("strategy") && document["strategy"].IsString()) {
-        enum StrategyType {
-            MULTICAST,
-            LOADBALANCING,
-            FAILOVER
-        };
-
-        static const std::unordered_map<std::string, StrategyType> STRATEGIES = {
-                {"multicast", MULTICAST},
-                {"loadbalancing", LOADBALANCING},
-                {"failover", FAILOVER}
-        };
-
-        bool has_change = false;
-        if (document["strategy"].GetString() != _strategy_name) {
-            auto it = STRATEGIES.find(document["strategy"].GetString());
-            tbb::speculative_spin_rw_mutex::scoped_lock lock(_egress_faces_mutex, true);
-            if (it != STRATEGIES.end()) {
-                switch (it->second) {
-                    case MULTICAST:
-                        _strategy = std::make_shared<MulticastStrategy>();
-                        _strategy_name = "multicast";
-                        break;
-                    case LOADBALANCING:
-                        _strategy = std::make_shared<LoadbalancingStrategy>();
-                        _strategy_name = "loadbalancing";
-                        break;
-                    case FAILOVER:
-                        _strategy = std::make_shared<FailoverStrategy>();
-                        _strategy_name = "failover";
-                        break;
-                }
-                has_change = true;
-            }
-            if (has_change) {
+        // the strategy of the root prefix, used by the names without a more specific strategy
+        std::lock_guard<std::mutex> lock(_snapshot_mutex);
+        if (document["strategy"].GetString() != _snapshot.load()->strategy_choice.find("/")->strategy_name) {
+            if (auto strategy = createStrategy(document["strategy"].GetString())) {
+                auto snapshot = new ForwardingSnapshot(*_snapshot.load());
+                snapshot->strategy_choice.insert("/", document["strategy"].GetString(), strategy);
+                publish(snapshot);
                 changes.emplace_back("strategy");
             }
         }
     }
 
+    if (document.HasMember("manager_address") && document.HasMember("manager_port") && document["manager_address"].IsString() && document["manager_port"].IsUint()) {
+        bool has_change = false;
+        boost::asio::ip::udp::endpoint new_endpoint(boost::asio::ip::address::from_string(document["manager_address"].GetString()), document["manager_port"].GetUint());
+        std::lock_guard<std::mutex> lock(_manager_mutex);
+        if (new_endpoint != _manager_endpoint) {
+            _manager_endpoint = new_endpoint;
+            has_change = true;
+        }
+        if (has_change) {
+            changes.emplace_back("manager_endpoint");
+        }
+    }
+
     std::stringstream ss;
     ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"edit_config", "changes":[)";
     bool first = true;
@@ -195,31 +263,88 @@ void StrategyRouter::commandAddFace(const rapidjson::Document &document) {
     enum layer_type {
         TCP,
         UDP,
+        UNIX,
+        SHM,
     };
 
     static const std::unordered_map<std::string, layer_type> LAYERS = {
             {"tcp", TCP},
             {"udp", UDP},
+            {"unix", UNIX},
+            {"shm", SHM},
+    };
+
+    static const std::unordered_map<std::string, DropPolicy> DROP_POLICIES = {
+            {"tail_drop", DropPolicy::TAIL_DROP},
+            {"head_drop", DropPolicy::HEAD_DROP},
+            {"priority_drop", DropPolicy::PRIORITY_DROP},
     };
 
-    if (document.HasMember("layer") && document.HasMember("address") && document.HasMember("port")
-        && document["layer"].IsString() && document["address"].IsString() && document["port"].IsUint()) {
+    if (document.HasMember("layer") && document.HasMember("address") && document["layer"].IsString() && document["address"].IsString()) {
+        // the address of a unix or shm face is the socket path of the module, only tcp and udp need a port
+        bool has_port = document.HasMember("port") && document["port"].IsUint();
         auto it = LAYERS.find(document["layer"].GetString());
-        if (it != LAYERS.end()) {
+        if (it != LAYERS.end() && (has_port || it->second == UNIX || it->second == SHM)) {
+            // the strategies select among the first MAX_SELECTED_FACES faces only, a face past them would never be used
+            std::unique_lock<std::mutex> count_lock(_snapshot_mutex);
+            size_t face_count = _snapshot.load()->egress_faces.size();
+            count_lock.unlock();
+            if (face_count >= Strategy::MAX_SELECTED_FACES) {
+                std::stringstream ss;
+                ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint()
+                   << R"(, "action":"add_face", "status":"fail", "reason":"too many faces"})";
+                _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+                return;
+            }
             std::shared_ptr<Face> face;
             switch (it->second) {
                 case TCP:
-                    face = std::make_shared<TcpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                    face = std::make_shared<TcpFace>(assignCore(), document["address"].GetString(), document["port"].GetUint());
+                    break;
+                case UDP: {
+                    auto udp_face = std::make_shared<UdpFace>(assignCore(), document["address"].GetString(), document["port"].GetUint());
+                    if (document.HasMember("mtu") && document["mtu"].IsUint()) {
+                        udp_face->setMtu(document["mtu"].GetUint());
+                    }
+                    if (document.HasMember("aggregation") && document["aggregation"].IsBool()) {
+                        // the delay is given in microseconds
+                        uint32_t delay = document.HasMember("aggregation_delay") && document["aggregation_delay"].IsUint()
+                                         ? document["aggregation_delay"].GetUint() : 0;
+                        udp_face->setAggregation(document["aggregation"].GetBool(), boost::posix_time::microseconds(delay));
+                    }
+                    face = udp_face;
                     break;
-                case UDP:
-                    face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                }
+                case UNIX:
+                    face = std::make_shared<UnixFace>(assignCore(), document["address"].GetString());
+                    break;
+                case SHM:
+                    face = std::make_shared<ShmFace>(assignCore(), document["address"].GetString());
                     break;
             }
-            tbb::speculative_spin_rw_mutex::scoped_lock lock(_egress_faces_mutex, true);
-            _egress_faces.push_back(face);
-            face->open(boost::bind(&StrategyRouter::onEgressPacket, this, _1),
+            // optional bounds of the transmit queue of the face
+            TxQueueLimits limits;
+            if (document.HasMember("queue_packets") && document["queue_packets"].IsUint()) {
+                limits.packets = document["queue_packets"].GetUint();
+            }
+            if (document.HasMember("queue_bytes") && document["queue_bytes"].IsUint()) {
+                limits.bytes = document["queue_bytes"].GetUint();
+            }
+            if (document.HasMember("drop_policy") && document["drop_policy"].IsString()) {
+                auto policy = DROP_POLICIES.find(document["drop_policy"].GetString());
+                if (policy != DROP_POLICIES.end()) {
+                    limits.policy = policy->second;
+                }
+            }
+            face->setTxQueueLimits(limits);
+            face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
+            face->open(boost::bind(&StrategyRouter::onEgressPacket, this, face->getFaceId(), _1),
                        boost::bind(&StrategyRouter::onFaceError, this, _1));
-            lock.release();
+            std::unique_lock<std::mutex> lock(_snapshot_mutex);
+            auto snapshot = new ForwardingSnapshot(*_snapshot.load());
+            snapshot->egress_faces.push_back(face);
+            publish(snapshot);
+            lock.unlock();
             std::stringstream ss;
             ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"add_face", "face_id":)" << face->getFaceId() << "}";
             _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
@@ -231,23 +356,179 @@ void StrategyRouter::commandDelFace(const rapidjson::Document &document) {
     if (document.HasMember("face_id") && document["face_id"].IsUint()) {
         size_t face_id = document["face_id"].GetUint();
         bool ok = false;
-        for (auto& egress_face : _egress_faces) {
+        std::shared_ptr<Face> removed_face;
+        std::unique_lock<std::mutex> lock(_snapshot_mutex);
+        auto snapshot = new ForwardingSnapshot(*_snapshot.load());
+        for (auto& egress_face : snapshot->egress_faces) {
             if (egress_face->getFaceId() == face_id) {
                 egress_face->close();
-                std::swap(egress_face, _egress_faces.back());
-                _egress_faces.pop_back();
+                removed_face = egress_face;
+                std::swap(egress_face, snapshot->egress_faces.back());
+                snapshot->egress_faces.pop_back();
                 ok = true;
                 break;
             }
         }
+        if (ok) {
+            publish(snapshot);
+            _measurements.removeFace(removed_face);
+        } else {
+            delete snapshot;
+        }
+        lock.unlock();
         std::stringstream ss;
         ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"del_face", "face_id":)" << face_id << R"(, "status":)" << ok << "}";
         _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
     }
 }
 
+void StrategyRouter::commandAddStrategies(const rapidjson::Document &document) {
+    if (document.HasMember("strategies") && document["strategies"].IsArray()) {
+        std::stringstream ss;
+        ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"add_strategies", )";
+        auto &&strategies = document["strategies"].GetArray();
+        if (strategies.Empty()) {
+            ss << R"("status":"fail", "reason":"empty prefix list"})";
+        } else {
+            std::vector<std::string> status;
+            // the whole list is applied with a single snapshot
+            std::unique_lock<std::mutex> lock(_snapshot_mutex);
+            auto snapshot = new ForwardingSnapshot(*_snapshot.load());
+            bool has_change = false;
+            for (auto &choice : strategies) {
+                if (choice.IsArray() && choice.Size() == 2 && choice[0].IsString() && choice[1].IsString()) {
+                    auto entry = snapshot->strategy_choice.find(choice[0].GetString());
+                    std::shared_ptr<Strategy> strategy;
+                    // an unchanged strategy keeps its state
+                    if (entry && entry->strategy_name == choice[1].GetString()) {
+                        status.emplace_back("success");
+                    } else if ((strategy = createStrategy(choice[1].GetString()))
+                               && snapshot->strategy_choice.insert(choice[0].GetString(), choice[1].GetString(), strategy)) {
+                        status.emplace_back("success");
+                        has_change = true;
+                    } else {
+                        status.emplace_back("fail");
+                    }
+                } else {
+                    status.emplace_back("fail");
+                }
+            }
+            if (has_change) {
+                publish(snapshot);
+            } else {
+                delete snapshot;
+            }
+            lock.unlock();
+            ss << R"("status":[)";
+            bool first = true;
+            for(const auto& s : status) {
+                if (first) {
+                    first = false;
+                } else {
+                    ss << ",";
+                }
+                ss << '"' << s << '"';
+            }
+            ss << "]}";
+        }
+        _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+    }
+}
+
+void StrategyRouter::commandDelStrategies(const rapidjson::Document &document) {
+    if (document.HasMember("prefixes") && document["prefixes"].IsArray()) {
+        std::stringstream ss;
+        ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"del_strategies", )";
+        auto &&prefixes = document["prefixes"].GetArray();
+        if (prefixes.Empty()) {
+            ss << R"("status":"fail", "reason":"empty prefix list"})";
+        } else {
+            std::vector<std::string> status;
+            std::unique_lock<std::mutex> lock(_snapshot_mutex);
+            auto snapshot = new ForwardingSnapshot(*_snapshot.load());
+            bool has_change = false;
+            for (auto &prefix : prefixes) {
+                if (prefix.IsString() && snapshot->strategy_choice.remove(prefix.GetString())) {
+                    status.emplace_back("success");
+                    has_change = true;
+                } else {
+                    status.emplace_back("fail");
+                }
+            }
+            if (has_change) {
+                publish(snapshot);
+            } else {
+                delete snapshot;
+            }
+            lock.unlock();
+            ss << R"("status":[)";
+            bool first = true;
+            for(const auto& s : status) {
+                if (first) {
+                    first = false;
+                } else {
+                    ss << ",";
+                }
+                ss << '"' << s << '"';
+            }
+            ss << "]}";
+        }
+        _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+    }
+}
+
 void StrategyRouter::commandList(const rapidjson::Document &document) {
     std::stringstream ss;
-    ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"list", "strategy":")" << _strategy_name << "\"}";
+    ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"list", "strategy":")";
+    {
+        std::lock_guard<std::mutex> lock(_snapshot_mutex);
+        const auto &strategy_choice = _snapshot.load()->strategy_choice;
+        ss << strategy_choice.find("/")->strategy_name << R"(", "strategies":)" << strategy_choice.toJSON();
+    }
+    ss << "}";
     _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
 }
+
+std::shared_ptr<Strategy> StrategyRouter::createStrategy(const std::string &strategy_name) {
+    enum StrategyType {
+        MULTICAST,
+        LOADBALANCING,
+        FAILOVER,
+        POWER_OF_TWO
+    };
+
+    static const std::unordered_map<std::string, StrategyType> STRATEGIES = {
+            {"multicast", MULTICAST},
+            {"loadbalancing", LOADBALANCING},
+            {"failover", FAILOVER},
+            {"power_of_two", POWER_OF_TWO}
+    };
+
+    auto it = STRATEGIES.find(strategy_name);
+    if (it == STRATEGIES.end()) {
+        return nullptr;
+    }
+    switch (it->second) {
+        case MULTICAST:
+            return std::make_shared<MulticastStrategy>();
+        case LOADBALANCING:
+            return std::make_shared<LoadbalancingStrategy>();
+        case FAILOVER:
+            return std::make_shared<FailoverStrategy>();
+        case POWER_OF_TWO:
+            return std::make_shared<PowerOfTwoStrategy>();
+    }
+    return nullptr;
+}
+
+void StrategyRouter::publish(ForwardingSnapshot *snapshot) {
+    const ForwardingSnapshot *old_snapshot = _snapshot.exchange(snapshot);
+    _epoch_manager.retire([old_snapshot]() {
+        delete old_snapshot;
+    });
+}
+
+boost::asio::ip::udp::endpoint StrategyRouter::getManagerEndpoint() {
+    std::lock_guard<std::mutex> lock(_manager_mutex);
+    return _manager_endpoint;
+}
@@ -2,44 +2,63 @@
 
 #include <boost/asio.hpp>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 
-#include <tbb/spin_rw_mutex.h>
-
 #include "rapidjson/document.h"
 
 #include "module.h"
+#include "epoch_manager.h"
+#include "measurement_table.h"
 #include "strategy.h"
+#include "strategy_choice.h"
 #include "network/face.h"
 #include "network/master_face.h"
+#include "network/io_uring.h"
 
 class StrategyRouter : public Module {
 private:
+    // immutable once published, replaced as a whole when the faces or the strategy change
+    struct ForwardingSnapshot {
+        std::vector<std::shared_ptr<Face>> egress_faces;
+        StrategyChoice strategy_choice;
+    };
+
     const std::string _name;
 
-    std::string _strategy_name;
-    std::shared_ptr<Strategy> _strategy;
+    EpochManager _epoch_manager;
+    std::atomic<const ForwardingSnapshot*> _snapshot;
+    // only serializes the writers, packet processing reads the snapshot without locking
+    std::mutex _snapshot_mutex;
+
+    MeasurementTable _measurements;
+    boost::asio::deadline_timer _measurement_timer;
 
     char _command_buffer[65536];
     boost::asio::ip::udp::socket _command_socket;
     boost::asio::ip::udp::endpoint _remote_command_endpoint;
+    // set by the commands, read by the congestion reports of every core
+    std::mutex _manager_mutex;
+    boost::asio::ip::udp::endpoint _manager_endpoint;
 
-    tbb::speculative_spin_rw_mutex _egress_faces_mutex;
-    std::vector<std::shared_ptr<Face>> _egress_faces;
     std::shared_ptr<MasterFace> _tcp_ingress_master_face;
     std::shared_ptr<MasterFace> _udp_ingress_master_face;
+    std::shared_ptr<MasterFace> _unix_ingress_master_face;
+    std::shared_ptr<MasterFace> _shm_ingress_master_face;
 
 public:
-    StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port);
+    StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port, IoBackend backend = IoBackend::ASIO,
+                   Runtime runtime = Runtime::SHARED);
 
-    ~StrategyRouter() override = default;
+    ~StrategyRouter() override;
 
     void run() override;
 
     void onIngressPacket(const NdnPacket &packet);
 
-    void onEgressPacket(const NdnPacket &packet);
+    void onEgressPacket(size_t face_id, const NdnPacket &packet);
 
     void onMasterFaceNotification(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face> &face);
 
@@ -47,6 +66,10 @@ public:
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
+    void measurementTimerHandler(const boost::system::error_code &err);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
@@ -57,5 +80,18 @@ public:
 
     void commandDelFace(const rapidjson::Document &document);
 
+    void commandAddStrategies(const rapidjson::Document &document);
+
+    void commandDelStrategies(const rapidjson::Document &document);
+
     void commandList(const rapidjson::Document &document);
+
+private:
+    // nullptr if the strategy does not exist
+    static std::shared_ptr<Strategy> createStrategy(const std::string &strategy_name);
+
+    // must be called with _snapshot_mutex held
+    void publish(ForwardingSnapshot *snapshot);
+
+    boost::asio::ip::udp::endpoint getManagerEndpoint();
 };
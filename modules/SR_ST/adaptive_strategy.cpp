@@ -0,0 +1,66 @@
+#include "adaptive_strategy.h"
+
+constexpr std::chrono::steady_clock::duration AdaptiveStrategy::PROBE_INTERVAL;
+
+AdaptiveStrategy::AdaptiveStrategy() : Strategy() {
+
+}
+
+size_t AdaptiveStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
+    if (faces.empty()) {
+        return 0;
+    }
+    if (_probe_index >= faces.size()) {
+        _probe_index = 0;
+    }
+
+    size_t best = faces.size();
+    std::chrono::steady_clock::duration best_srtt;
+    for (size_t i = 0; i < faces.size(); ++i) {
+        auto it = _faces.find(faces[i]->getFaceId());
+        // faces without measurement are only reached by the probes
+        if (it == _faces.end() || !it->second.rtt.hasMeasurement() || it->second.timeouts >= MAX_TIMEOUTS) {
+            continue;
+        }
+        if (best == faces.size() || it->second.rtt.getSrtt() < best_srtt) {
+            best = i;
+            best_srtt = it->second.rtt.getSrtt();
+        }
+    }
+    if (best == faces.size()) {
+        selected[0] = _probe_index++;
+        return 1;
+    }
+
+    selected[0] = best;
+    auto now = std::chrono::steady_clock::now();
+    if (faces.size() > 1 && now >= _next_probe) {
+        _next_probe = now + PROBE_INTERVAL;
+        size_t probe = _probe_index++;
+        if (probe != best) {
+            selected[1] = probe;
+            return 2;
+        }
+    }
+    return 1;
+}
+
+bool AdaptiveStrategy::needsMeasurements() const {
+    return true;
+}
+
+void AdaptiveStrategy::onDataReceived(const std::shared_ptr<Face> &face, const std::chrono::steady_clock::duration &rtt) {
+    auto &info = _faces[face->getFaceId()];
+    info.rtt.addMeasurement(rtt);
+    info.timeouts = 0;
+}
+
+void AdaptiveStrategy::onTimeout(const std::shared_ptr<Face> &face) {
+    auto &info = _faces[face->getFaceId()];
+    info.rtt.backoff();
+    ++info.timeouts;
+}
+
+void AdaptiveStrategy::onFaceRemoved(const std::shared_ptr<Face> &face) {
+    _faces.erase(face->getFaceId());
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <unordered_map>
+
+#include "strategy.h"
+#include "rtt_estimator.h"
+
+// Sends each Interest to the healthy face with the lowest smoothed RTT, and from time to time probes another face
+// so the measurements of the other faces stay fresh. A face is unhealthy after MAX_TIMEOUTS consecutive timeouts,
+// when all faces are unhealthy the Interests are spread over them in round robin until one answers again.
+class AdaptiveStrategy : public Strategy {
+public:
+    static const size_t MAX_TIMEOUTS = 3;
+    static constexpr std::chrono::steady_clock::duration PROBE_INTERVAL = std::chrono::seconds(1);
+
+private:
+    struct FaceInfo {
+        RttEstimator rtt;
+        size_t timeouts = 0;
+    };
+
+    std::unordered_map<size_t, FaceInfo> _faces;
+    std::chrono::steady_clock::time_point _next_probe;
+    size_t _probe_index = 0;
+
+public:
+    AdaptiveStrategy();
+
+    ~AdaptiveStrategy() = default;
+
+    size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) override;
+
+    bool needsMeasurements() const override;
+
+    void onDataReceived(const std::shared_ptr<Face> &face, const std::chrono::steady_clock::duration &rtt) override;
+
+    void onTimeout(const std::shared_ptr<Face> &face) override;
+
+    void onFaceRemoved(const std::shared_ptr<Face> &face) override;
+};
\ No newline at end of file
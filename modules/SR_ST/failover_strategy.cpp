@@ -4,6 +4,10 @@ FailoverStrategy::FailoverStrategy() : Strategy() {
 
 }
 
-std::vector<std::shared_ptr<Face>> FailoverStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces) {
-    return !faces.empty() ? std::vector<std::shared_ptr<Face>>{faces[0]} : std::vector<std::shared_ptr<Face>>();
+size_t FailoverStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
+    if (faces.empty()) {
+        return 0;
+    }
+    selected[0] = 0;
+    return 1;
 }
\ No newline at end of file
@@ -10,5 +10,5 @@ public:
 
     ~FailoverStrategy() override = default;
 
-    std::vector<std::shared_ptr<Face>> selectFaces(const std::vector<std::shared_ptr<Face>> &faces);
+    size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected);
 };
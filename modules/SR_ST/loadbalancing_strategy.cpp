@@ -5,13 +5,14 @@ LoadbalancingStrategy::LoadbalancingStrategy() : Strategy() {
 
 }
 
-std::vector<std::shared_ptr<Face>> LoadbalancingStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces) {
+size_t LoadbalancingStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
     if (faces.empty()) {
-        return std::vector<std::shared_ptr<Face>>();
+        return 0;
     } else {
         if (_index >= faces.size()) {
             _index = 0;
         }
-        return {faces[_index++]};
+        selected[0] = _index++;
+        return 1;
     }
 }
\ No newline at end of file
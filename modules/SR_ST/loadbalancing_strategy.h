@@ -11,5 +11,5 @@ public:
 
     ~LoadbalancingStrategy() = default;
 
-    std::vector<std::shared_ptr<Face>> selectFaces(const std::vector<std::shared_ptr<Face>> &faces) override;
+    size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) override;
 };
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "measurement_table.h"
+
+#include <algorithm>
+
+size_t MeasurementTable::size() const {
+    return _pending.size();
+}
+
+void MeasurementTable::clear() {
+    _pending.clear();
+    _expiries.clear();
+}
+
+bool MeasurementTable::insert(const ndn::Name &name, const std::shared_ptr<Face> &face, const std::shared_ptr<Strategy> &strategy,
+                              const Clock::time_point &now, const Clock::duration &lifetime) {
+    auto &pending_interests = _pending[name];
+    auto it = std::find_if(pending_interests.begin(), pending_interests.end(), [&face](const PendingInterest &pending_interest) {
+        return pending_interest.face == face;
+    });
+    bool inserted = it == pending_interests.end();
+    if (inserted) {
+        pending_interests.push_back({face, strategy, now, now + lifetime});
+    } else {
+        it->sent = now;
+        it->expiry = now + lifetime;
+    }
+    _expiries.emplace(now + lifetime, name);
+    return inserted;
+}
+
+bool MeasurementTable::satisfy(const ndn::Name &data_name, const std::shared_ptr<Face> &face, const Clock::time_point &now,
+                               Clock::duration &rtt, std::shared_ptr<Strategy> &strategy) {
+    auto it = _pending.find(data_name);
+    for (ssize_t i = data_name.size() - 1; it == _pending.end() && i >= 0; --i) {
+        it = _pending.find(data_name.getPrefix(i));
+    }
+    if (it == _pending.end()) {
+        return false;
+    }
+    auto &pending_interests = it->second;
+    auto pending_it = std::find_if(pending_interests.begin(), pending_interests.end(), [&face](const PendingInterest &pending_interest) {
+        return pending_interest.face == face;
+    });
+    if (pending_it == pending_interests.end()) {
+        return false;
+    }
+    rtt = now - pending_it->sent;
+    strategy = pending_it->strategy.lock();
+    std::swap(*pending_it, pending_interests.back());
+    pending_interests.pop_back();
+    if (pending_interests.empty()) {
+        // the remaining expiry entries of this name are skipped when they fire
+        _pending.erase(it);
+    }
+    return strategy != nullptr;
+}
+
+void MeasurementTable::expire(const Clock::time_point &now, const TimeoutCallback &callback) {
+    while (!_expiries.empty() && _expiries.begin()->first <= now) {
+        auto it = _pending.find(_expiries.begin()->second);
+        if (it != _pending.end()) {
+            auto &pending_interests = it->second;
+            for (size_t i = 0; i < pending_interests.size();) {
+                if (pending_interests[i].expiry <= now) {
+                    if (auto strategy = pending_interests[i].strategy.lock()) {
+                        callback(pending_interests[i].face, strategy);
+                    }
+                    std::swap(pending_interests[i], pending_interests.back());
+                    pending_interests.pop_back();
+                } else {
+                    ++i;
+                }
+            }
+            if (pending_interests.empty()) {
+                _pending.erase(it);
+            }
+        }
+        _expiries.erase(_expiries.begin());
+    }
+}
+
+void MeasurementTable::removeFace(const std::shared_ptr<Face> &face) {
+    for (auto it = _pending.begin(); it != _pending.end();) {
+        auto &pending_interests = it->second;
+        pending_interests.erase(std::remove_if(pending_interests.begin(), pending_interests.end(), [&face](const PendingInterest &pending_interest) {
+            return pending_interest.face == face;
+        }), pending_interests.end());
+        it = pending_interests.empty() ? _pending.erase(it) : std::next(it);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <ndn-cxx/name.hpp>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "network/face.h"
+#include "strategy.h"
+
+// Interests forwarded to the egress faces and still waiting for their Data, used to measure the RTT of each
+// face and to detect the Interests that expired without Data. The measurements go back to the strategy which
+// forwarded the Interest, as long as it is still in use.
+class MeasurementTable {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimeoutCallback = std::function<void(const std::shared_ptr<Face>&, const std::shared_ptr<Strategy>&)>;
+
+private:
+    struct PendingInterest {
+        std::shared_ptr<Face> face;
+        std::weak_ptr<Strategy> strategy;
+        Clock::time_point sent;
+        Clock::time_point expiry;
+    };
+
+    std::map<ndn::Name, std::vector<PendingInterest>> _pending;
+    std::multimap<Clock::time_point, ndn::Name> _expiries;
+
+public:
+    MeasurementTable() = default;
+
+    ~MeasurementTable() = default;
+
+    size_t size() const;
+
+    void clear();
+
+    // false if the Interest was already pending on this face, the retransmission restarts its measurement
+    bool insert(const ndn::Name &name, const std::shared_ptr<Face> &face, const std::shared_ptr<Strategy> &strategy,
+                const Clock::time_point &now, const Clock::duration &lifetime);
+
+    // matches the Data with the longest pending Interest name it can satisfy, true if it came from a face the
+    // Interest was sent to and the strategy which sent it is still in use
+    bool satisfy(const ndn::Name &data_name, const std::shared_ptr<Face> &face, const Clock::time_point &now,
+                 Clock::duration &rtt, std::shared_ptr<Strategy> &strategy);
+
+    void expire(const Clock::time_point &now, const TimeoutCallback &callback);
+
+    void removeFace(const std::shared_ptr<Face> &face);
+};
@@ -1,9 +1,15 @@
 #include "multicast_strategy.h"
 
+#include <algorithm>
+
 MulticastStrategy::MulticastStrategy() : Strategy() {
 
 }
 
-std::vector<std::shared_ptr<Face>> MulticastStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces) {
-    return faces;
+size_t MulticastStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
+    size_t count = std::min(faces.size(), (size_t)MAX_SELECTED_FACES);
+    for (size_t i = 0; i < count; ++i) {
+        selected[i] = i;
+    }
+    return count;
 }
\ No newline at end of file
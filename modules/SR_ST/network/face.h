@@ -11,11 +11,16 @@
 #include <memory>
 #include <string>
 
+#include "concurrency.h"
+#include "tx_queue.h"
+
 class Face {
 public:
     using InterestCallback = std::function<void(const std::shared_ptr<Face>&, const ndn::Interest&)>;
     using DataCallback = std::function<void(const std::shared_ptr<Face>&, const ndn::Data&)>;
     using ErrorCallback = std::function<void(const std::shared_ptr<Face>&)>;
+    // called from the strand of the face when its transmit queue starts or stops dropping packets
+    using CongestionCallback = std::function<void(const std::shared_ptr<Face>&, bool congested)>;
 
 private:
     static size_t counter;
@@ -24,12 +29,14 @@ protected:
     const size_t _face_id;
 
     bool _is_connected = false;
+    Atomic<bool> _is_congested {false};
 
     boost::asio::io_service &_ios;
 
     InterestCallback _interest_callback;
     DataCallback _data_callback;
     ErrorCallback _error_callback;
+    CongestionCallback _congestion_callback;
 
 public:
     explicit Face(boost::asio::io_service &ios) : _face_id(++counter), _ios(ios) {
@@ -46,6 +53,19 @@ public:
         return _is_connected;
     }
 
+    bool isCongested() const {
+        return _is_congested.load(std::memory_order_relaxed);
+    }
+
+    // must be set before the face is opened
+    void setCongestionCallback(const CongestionCallback &congestion_callback) {
+        _congestion_callback = congestion_callback;
+    }
+
+    virtual void setTxQueueLimits(const TxQueueLimits &limits) = 0;
+
+    virtual TxQueueStats getTxQueueStats() const = 0;
+
     virtual std::string getUnderlyingProtocol() const = 0;
 
     virtual std::string getUnderlyingEndpoint() const = 0;
@@ -59,4 +79,7 @@ public:
     virtual void send(const ndn::Interest &interest) = 0;
 
     virtual void send(const ndn::Data &data) = 0;
+
+protected:
+    void updateCongestion(const std::shared_ptr<Face> &face, bool congested);
 };
\ No newline at end of file
@@ -65,6 +65,7 @@ void TcpMasterFace::acceptHandler(const boost::system::error_code &err) {
             ss << "new connection from tcp://" << _socket.remote_endpoint();
             logger::log(logger::INFO, ss.str());
             auto face = std::make_shared<TcpFace>(std::move(_socket));
+            prepareFace(face);
             _faces.emplace(face);
             _notification_callback(shared_from_this(), face);
             face->open(_interest_callback, _data_callback, boost::bind(&TcpMasterFace::onFaceError, shared_from_this(), _1));
@@ -8,10 +8,20 @@ UdpMasterFace::UdpSubFace::UdpSubFace(UdpMasterFace &master_face, const boost::a
         : Face(master_face.get_io_service())
         , _master_face(master_face)
         , _endpoint(endpoint)
-        , _timer(master_face.get_io_service()) {
+        , _last_activity(master_face._ticks)
+        , _fragmenter(master_face._mtu)
+        , _flush_timer(master_face.get_io_service()) {
 
 }
 
+void UdpMasterFace::UdpSubFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats UdpMasterFace::UdpSubFace::getTxQueueStats() const {
+    return _queue.getStats();
+}
+
 std::string UdpMasterFace::UdpSubFace::getUnderlyingProtocol() const {
     return "UDP";
 }
@@ -32,8 +42,6 @@ void UdpMasterFace::UdpSubFace::open(const InterestCallback &interest_callback,
     _interest_callback = interest_callback;
     _data_callback = data_callback;
     _error_callback = error_callback;
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    _timer.async_wait(boost::bind(&UdpSubFace::timerHandler, shared_from_this(), _1, false));
 }
 
 void UdpMasterFace::UdpSubFace::close() {
@@ -41,63 +49,100 @@ void UdpMasterFace::UdpSubFace::close() {
 }
 
 void UdpMasterFace::UdpSubFace::send(const std::string &message) {
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    _master_face._strand.post(boost::bind(&UdpMasterFace::sendImpl, _master_face.shared_from_this(), message, _endpoint));
+    _last_activity = _master_face._ticks;
+    _master_face._strand.post(boost::bind(&UdpSubFace::sendImpl, shared_from_this(), message));
 }
 
 void UdpMasterFace::UdpSubFace::send(const ndn::Interest &interest) {
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    _master_face._strand.post(boost::bind(&UdpMasterFace::sendImpl, _master_face.shared_from_this(), std::string((const char *)interest.wireEncode().wire(), interest.wireEncode().size()), _endpoint));
+    _last_activity = _master_face._ticks;
+    _master_face._strand.post(boost::bind(&UdpSubFace::sendImpl, shared_from_this(), std::string((const char *)interest.wireEncode().wire(), interest.wireEncode().size())));
 }
 
 void UdpMasterFace::UdpSubFace::send(const ndn::Data &data) {
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    _master_face._strand.post(boost::bind(&UdpMasterFace::sendImpl, _master_face.shared_from_this(), std::string((const char *)data.wireEncode().wire(), data.wireEncode().size()), _endpoint));
+    _last_activity = _master_face._ticks;
+    _master_face._strand.post(boost::bind(&UdpSubFace::sendImpl, shared_from_this(), std::string((const char *)data.wireEncode().wire(), data.wireEncode().size())));
 }
 
 void UdpMasterFace::UdpSubFace::proceedPacket(const char *buffer, size_t size) {
-    _timer.expires_from_now(boost::posix_time::seconds(3));
-    try {
-        switch (buffer[0]) {
-            case 0x05:
-                _interest_callback(shared_from_this(), ndn::Interest(ndn::Block((uint8_t *) buffer, size)));
-                break;
-            case 0x06:
-                _data_callback(shared_from_this(), ndn::Data(ndn::Block((uint8_t *) buffer, size)));
-                break;
-            default:
-                break;
+    _last_activity = _master_face._ticks;
+    const char *it = buffer;
+    const char *packet;
+    size_t packet_size;
+    // a datagram may carry several packets, and a fragment only yields a packet once the others arrived
+    while (_reassembler.unpack(it, buffer + size, packet, packet_size)) {
+        try {
+            switch (packet[0]) {
+                case 0x05:
+                    _interest_callback(shared_from_this(), ndn::Interest(ndn::Block((uint8_t *) packet, packet_size)));
+                    break;
+                case 0x06:
+                    _data_callback(shared_from_this(), ndn::Data(ndn::Block((uint8_t *) packet, packet_size)));
+                    break;
+                default:
+                    break;
+            }
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
         }
-    } catch (const std::exception &e) {
-        std::cerr << e.what() << std::endl;
     }
 }
 
-void UdpMasterFace::UdpSubFace::timerHandler(const boost::system::error_code &err, bool last_chance) {
-    if (_timer.expires_at() <= boost::asio::deadline_timer::traits_type::now()) {
-        if (!last_chance) {
-            // endpoint must manifest itself in the given time, else the socket will close (icmp or timeout)
-            _master_face._strand.post(boost::bind(&UdpMasterFace::sendImpl, _master_face.shared_from_this(), "0", _endpoint));
-            _timer.expires_from_now(boost::posix_time::seconds(2));
-            _timer.async_wait(boost::bind(&UdpSubFace::timerHandler, shared_from_this(), _1, true));
+void UdpMasterFace::UdpSubFace::sendImpl(const std::string &message) {
+    bool was_empty = _queue.empty();
+    bool is_data = !message.empty() && message[0] == 0x06;
+    // the fragments of a packet larger than the MTU are queued in its place
+    if (!_fragmenter.fragment(message.data(), message.size(), [this, is_data](const char *fragment, size_t size) {
+        _queue.push(std::string(fragment, size), size, is_data);
+    })) {
+        _queue.push(message, message.size(), is_data);
+    }
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    size_t queued_bytes = _queue.getStats().bytes;
+    if (_is_flush_pending) {
+        // a full datagram doesn't wait
+        if (queued_bytes >= _fragmenter.getDatagramSize()) {
+            _flush_timer.cancel();
+        }
+    } else if (was_empty && !_queue.empty()) {
+        if (_master_face._aggregation && _master_face._aggregation_delay > boost::posix_time::time_duration()
+            && queued_bytes < _fragmenter.getDatagramSize()) {
+            _is_flush_pending = true;
+            _flush_timer.expires_from_now(_master_face._aggregation_delay);
+            _flush_timer.async_wait(_master_face._strand.wrap(boost::bind(&UdpSubFace::flushHandler, shared_from_this(), _1)));
         } else {
-            std::stringstream ss;
-            ss << "no activity from/to " << _endpoint << " since 5s" << std::endl;
-            logger::log(logger::INFO, ss.str());
-            _error_callback(shared_from_this());
+            _master_face.schedule(shared_from_this());
         }
-    } else {
-        _timer.async_wait(boost::bind(&UdpSubFace::timerHandler, shared_from_this(), _1, false));
+    }
+}
+
+void UdpMasterFace::UdpSubFace::flushHandler(const boost::system::error_code &err) {
+    _is_flush_pending = false;
+    if (!_queue.empty()) {
+        _master_face.schedule(shared_from_this());
     }
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 
+size_t UdpMasterFace::EndpointHash::operator()(const boost::asio::ip::udp::endpoint &endpoint) const {
+    boost::asio::ip::address address = endpoint.address();
+    uint64_t key = endpoint.port();
+    if (address.is_v4()) {
+        key |= (uint64_t)address.to_v4().to_uint() << 16;
+    } else {
+        for (uint8_t byte : address.to_v6().to_bytes()) {
+            key = key * 31 + byte;
+        }
+    }
+    return std::hash<uint64_t>()(key);
+}
+
 UdpMasterFace::UdpMasterFace(boost::asio::io_service &ios, size_t max_connection, uint16_t port)
         : MasterFace(ios, max_connection)
         , _local_endpoint(boost::asio::ip::udp::v4(), port)
         , _socket(_ios, boost::asio::ip::udp::endpoint(boost::asio::ip::udp::v4(), port))
-        , _strand(_ios) {
+        , _strand(_ios)
+        , _sweep_timer(_ios) {
 
 }
 
@@ -105,6 +150,15 @@ std::string UdpMasterFace::getUnderlyingProtocol() const {
     return "UDP";
 }
 
+void UdpMasterFace::setMtu(size_t mtu) {
+    _mtu = mtu;
+}
+
+void UdpMasterFace::setAggregation(bool enabled, const boost::posix_time::time_duration &delay) {
+    _aggregation = enabled;
+    _aggregation_delay = delay;
+}
+
 void UdpMasterFace::listen(const MasterFace::NotificationCallback &notification_callback, const Face::InterestCallback &interest_callback,
                            const Face::DataCallback &data_callback, const MasterFace::ErrorCallback &error_callback) {
     _notification_callback = notification_callback;
@@ -115,10 +169,12 @@ void UdpMasterFace::listen(const MasterFace::NotificationCallback &notification_
     ss << "master face with ID = " << _master_face_id << " listening on udp://" << _local_endpoint;
     logger::log(logger::INFO, ss.str());
     read();
+    sweep();
 }
 
 void UdpMasterFace::close() {
     _socket.close();
+    _sweep_timer.cancel();
     for(const auto &face : _faces) {
         face.second->close();
     }
@@ -150,18 +206,24 @@ void UdpMasterFace::read() {
 void UdpMasterFace::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
     if(!err) {
         std::shared_ptr<UdpSubFace> face;
-        auto it = _faces.find(_remote_endpoint);
-        if (it != _faces.end()) {
+        auto it = _faces.end();
+        if (_last_face && _last_face->_endpoint == _remote_endpoint) {
+            face = _last_face;
+            face->proceedPacket(_buffer, bytes_transferred);
+        } else if ((it = _faces.find(_remote_endpoint)) != _faces.end()) {
             face = it->second;
+            _last_face = face;
             face->proceedPacket(_buffer, bytes_transferred);
         } else if (_faces.size() < _max_connection) {
             std::stringstream ss;
             ss << "new connection from udp://" << _remote_endpoint;
             logger::log(logger::INFO, ss.str());
             face = std::make_shared<UdpSubFace>(*this, _remote_endpoint);
+            prepareFace(face);
             face->open(_interest_callback, _data_callback, boost::bind(&UdpMasterFace::onFaceError, shared_from_this(), _1));
             _notification_callback(shared_from_this(), face);
             _faces.emplace(_remote_endpoint, face);
+            _last_face = face;
             face->proceedPacket(_buffer, bytes_transferred);
         }
         read();
@@ -170,31 +232,95 @@ void UdpMasterFace::readHandler(const boost::system::error_code &err, size_t byt
     }
 }
 
-void UdpMasterFace::sendImpl(const std::string &message, const boost::asio::ip::udp::endpoint &endpoint) {
-    _queue.emplace_back(message, endpoint);
-    if (_queue.size() == 1) {
+void UdpMasterFace::sweep() {
+    _sweep_timer.expires_from_now(boost::posix_time::seconds(1));
+    _sweep_timer.async_wait(_strand.wrap(boost::bind(&UdpMasterFace::sweepHandler, shared_from_this(), _1)));
+}
+
+void UdpMasterFace::sweepHandler(const boost::system::error_code &err) {
+    if (err) {
+        return;
+    }
+    ++_ticks;
+    std::vector<std::shared_ptr<UdpSubFace>> idle_faces;
+    for (const auto &face : _faces) {
+        uint64_t idle = _ticks - face.second->_last_activity;
+        if (idle > IDLE_TIMEOUT_TICKS) {
+            idle_faces.push_back(face.second);
+        } else if (idle <= KEEPALIVE_TICKS) {
+            face.second->_is_keepalive_sent = false;
+        } else if (!face.second->_is_keepalive_sent) {
+            // endpoint must manifest itself in the given time, else the socket will close (icmp or timeout)
+            face.second->_is_keepalive_sent = true;
+            face.second->sendImpl("0");
+        }
+    }
+    // the faces remove themselves from the table
+    for (const auto &face : idle_faces) {
+        std::stringstream ss;
+        ss << "no activity from/to " << face->_endpoint << " since " << IDLE_TIMEOUT_TICKS << "s" << std::endl;
+        logger::log(logger::INFO, ss.str());
+        face->_error_callback(face);
+    }
+    sweep();
+}
+
+void UdpMasterFace::schedule(const std::shared_ptr<UdpSubFace> &face) {
+    _ready.push_back(face);
+    if (!_is_writing) {
         write();
     }
 }
 
 void UdpMasterFace::write() {
-    auto &message = _queue.front();
-    _socket.async_send_to(boost::asio::buffer(message.first), message.second,
+    // skip the faces left without packets
+    while (!_ready.empty() && _ready.front()->_queue.empty()) {
+        _ready.pop_front();
+    }
+    _is_writing = !_ready.empty();
+    if (!_is_writing) {
+        return;
+    }
+    auto &face = _ready.front();
+    size_t datagram_size = face->_fragmenter.getDatagramSize();
+    size_t bytes = 0;
+    _write_buffers.clear();
+    face->_queue.forEach(_aggregation ? MAX_AGGREGATED_PACKETS : 1, [this, datagram_size, &bytes](const std::string &message) {
+        bool can_aggregate = LpFragmenter::canAggregate(message.data(), message.size());
+        if (!_write_buffers.empty() && (!can_aggregate || bytes + message.size() > datagram_size)) {
+            return false;
+        }
+        _write_buffers.emplace_back(message.data(), message.size());
+        // a packet that can't be aggregated fills the datagram on its own
+        bytes += can_aggregate ? message.size() : datagram_size;
+        return true;
+    });
+    face->_queue.markInFlight(_write_buffers.size());
+    _socket.async_send_to(_write_buffers, face->_endpoint,
                           _strand.wrap(boost::bind(&UdpMasterFace::writeHandler, shared_from_this(), _1, _2)));
 }
 
 void UdpMasterFace::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
     if(!err) {
-        _queue.pop_front();
-        if (!_queue.empty()) {
-            write();
+        std::shared_ptr<UdpSubFace> face = _ready.front();
+        _ready.pop_front();
+        for (size_t i = 0; i < _write_buffers.size(); ++i) {
+            face->_queue.pop();
+        }
+        face->updateCongestion(face, face->_queue.isCongested());
+        if (!face->_queue.empty()) {
+            _ready.push_back(face);
         }
+        write();
     } else {
         std::cerr << err.message() << std::endl;
     }
 }
 
 void UdpMasterFace::onFaceError(const std::shared_ptr<Face> &face) {
+    if (_last_face == face) {
+        _last_face.reset();
+    }
     _faces.erase(((UdpSubFace*)face.get())->getEndpoint());
     _error_callback(shared_from_this(), face);
 }
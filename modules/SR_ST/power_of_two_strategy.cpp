@@ -0,0 +1,54 @@
+#include "power_of_two_strategy.h"
+
+PowerOfTwoStrategy::PowerOfTwoStrategy() : Strategy(), _random(std::random_device{}()) {
+
+}
+
+size_t PowerOfTwoStrategy::selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) {
+    if (faces.empty()) {
+        return 0;
+    }
+    if (faces.size() == 1) {
+        selected[0] = 0;
+        return 1;
+    }
+    size_t first = _random() % faces.size();
+    size_t second = _random() % (faces.size() - 1);
+    if (second >= first) {
+        ++second;
+    }
+    selected[0] = getOutstandingInterests(faces[second]) < getOutstandingInterests(faces[first]) ? second : first;
+    return 1;
+}
+
+bool PowerOfTwoStrategy::needsMeasurements() const {
+    return true;
+}
+
+void PowerOfTwoStrategy::onInterestSent(const std::shared_ptr<Face> &face) {
+    ++_outstanding_interests[face->getFaceId()];
+}
+
+void PowerOfTwoStrategy::onDataReceived(const std::shared_ptr<Face> &face, const std::chrono::steady_clock::duration &rtt) {
+    decrementOutstandingInterests(face);
+}
+
+void PowerOfTwoStrategy::onTimeout(const std::shared_ptr<Face> &face) {
+    decrementOutstandingInterests(face);
+}
+
+void PowerOfTwoStrategy::onFaceRemoved(const std::shared_ptr<Face> &face) {
+    _outstanding_interests.erase(face->getFaceId());
+}
+
+size_t PowerOfTwoStrategy::getOutstandingInterests(const std::shared_ptr<Face> &face) const {
+    auto it = _outstanding_interests.find(face->getFaceId());
+    return it != _outstanding_interests.end() ? it->second : 0;
+}
+
+void PowerOfTwoStrategy::decrementOutstandingInterests(const std::shared_ptr<Face> &face) {
+    auto it = _outstanding_interests.find(face->getFaceId());
+    if (it != _outstanding_interests.end() && it->second > 0) {
+        --it->second;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <random>
+#include <unordered_map>
+
+#include "strategy.h"
+
+// Draws two distinct faces at random and sends to the one with the fewest outstanding Interests,
+// a slow face builds up outstanding Interests and stops being chosen until it catches up.
+class PowerOfTwoStrategy : public Strategy {
+private:
+    std::unordered_map<size_t, size_t> _outstanding_interests;
+    std::minstd_rand _random;
+
+public:
+    PowerOfTwoStrategy();
+
+    ~PowerOfTwoStrategy() = default;
+
+    size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) override;
+
+    bool needsMeasurements() const override;
+
+    void onInterestSent(const std::shared_ptr<Face> &face) override;
+
+    void onDataReceived(const std::shared_ptr<Face> &face, const std::chrono::steady_clock::duration &rtt) override;
+
+    void onTimeout(const std::shared_ptr<Face> &face) override;
+
+    void onFaceRemoved(const std::shared_ptr<Face> &face) override;
+
+private:
+    size_t getOutstandingInterests(const std::shared_ptr<Face> &face) const;
+
+    void decrementOutstandingInterests(const std::shared_ptr<Face> &face);
+};
\ No newline at end of file
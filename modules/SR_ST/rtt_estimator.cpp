@@ -0,0 +1,48 @@
+#include "rtt_estimator.h"
+
+#include <algorithm>
+
+constexpr double RttEstimator::ALPHA;
+constexpr double RttEstimator::BETA;
+
+RttEstimator::RttEstimator(const Duration &initial_rto, const Duration &min_rto, const Duration &max_rto)
+        : _srtt(0)
+        , _rttvar(0)
+        , _rto(initial_rto)
+        , _min_rto(min_rto)
+        , _max_rto(max_rto) {
+
+}
+
+bool RttEstimator::hasMeasurement() const {
+    return _has_measurement;
+}
+
+const RttEstimator::Duration& RttEstimator::getSrtt() const {
+    return _srtt;
+}
+
+const RttEstimator::Duration& RttEstimator::getRttVar() const {
+    return _rttvar;
+}
+
+const RttEstimator::Duration& RttEstimator::getRto() const {
+    return _rto;
+}
+
+void RttEstimator::addMeasurement(const Duration &rtt) {
+    if (!_has_measurement) {
+        _srtt = rtt;
+        _rttvar = rtt / 2;
+        _has_measurement = true;
+    } else {
+        auto delta = _srtt > rtt ? _srtt - rtt : rtt - _srtt;
+        _rttvar = std::chrono::duration_cast<Duration>((1 - BETA) * _rttvar + BETA * delta);
+        _srtt = std::chrono::duration_cast<Duration>((1 - ALPHA) * _srtt + ALPHA * rtt);
+    }
+    _rto = std::min(std::max(_srtt + 4 * _rttvar, _min_rto), _max_rto);
+}
+
+void RttEstimator::backoff() {
+    _rto = std::min(_rto * 2, _max_rto);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <chrono>
+
+// Smoothed RTT and RTT variation of a face as in RFC 6298, the retransmission timeout doubles on each timeout.
+class RttEstimator {
+public:
+    using Duration = std::chrono::steady_clock::duration;
+
+    static constexpr double ALPHA = 0.125;
+    static constexpr double BETA = 0.25;
+
+private:
+    bool _has_measurement = false;
+    Duration _srtt;
+    Duration _rttvar;
+    Duration _rto;
+    Duration _min_rto;
+    Duration _max_rto;
+
+public:
+    explicit RttEstimator(const Duration &initial_rto = std::chrono::seconds(1),
+                          const Duration &min_rto = std::chrono::milliseconds(200),
+                          const Duration &max_rto = std::chrono::seconds(60));
+
+    ~RttEstimator() = default;
+
+    bool hasMeasurement() const;
+
+    const Duration& getSrtt() const;
+
+    const Duration& getRttVar() const;
+
+    const Duration& getRto() const;
+
+    void addMeasurement(const Duration &rtt);
+
+    void backoff();
+};
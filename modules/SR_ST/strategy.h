@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -15,5 +16,31 @@ public:
 
     virtual ~Strategy() = default;
 
-    virtual std::vector<std::shared_ptr<Face>> selectFaces(const std::vector<std::shared_ptr<Face>> &faces) = 0;
+    // also the most egress faces a router accepts, so that a strategy can select any of them
+    static const size_t MAX_SELECTED_FACES = 64;
+
+    // writes the indices in faces of the chosen faces to selected, which holds MAX_SELECTED_FACES indices,
+    // and returns how many were chosen
+    virtual size_t selectFaces(const std::vector<std::shared_ptr<Face>> &faces, size_t *selected) = 0;
+
+    // the router only tracks pending Interests for the strategies asking for measurements
+    virtual bool needsMeasurements() const {
+        return false;
+    }
+
+    virtual void onInterestSent(const std::shared_ptr<Face> &face) {
+
+    }
+
+    virtual void onDataReceived(const std::shared_ptr<Face> &face, const std::chrono::steady_clock::duration &rtt) {
+
+    }
+
+    virtual void onTimeout(const std::shared_ptr<Face> &face) {
+
+    }
+
+    virtual void onFaceRemoved(const std::shared_ptr<Face> &face) {
+
+    }
 };
\ No newline at end of file
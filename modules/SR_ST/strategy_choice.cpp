@@ -0,0 +1,54 @@
+#include "strategy_choice.h"
+
+std::string StrategyChoice::Entry::toJSON() const {
+    return R"({"strategy":")" + strategy_name + R"("})";
+}
+
+StrategyChoice::StrategyChoice(const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy) {
+    insert("/", strategy_name, strategy);
+}
+
+std::shared_ptr<StrategyChoice::Entry> StrategyChoice::find(const ndn::Name &prefix) const {
+    auto it = _entries.find(prefix);
+    return it != _entries.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<StrategyChoice::Entry> StrategyChoice::findLongestPrefixMatch(const ndn::Name &name) const {
+    return _tree.findLastUntil(name).second;
+}
+
+void StrategyChoice::insert(const ndn::Name &prefix, const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy) {
+    auto entry = std::make_shared<Entry>(Entry{strategy_name, strategy});
+    _tree.insert(prefix, entry, true);
+    _entries[prefix] = entry;
+}
+
+bool StrategyChoice::remove(const ndn::Name &prefix) {
+    if (prefix.empty() || _entries.erase(prefix) == 0) {
+        return false;
+    }
+    _tree.remove(prefix);
+    return true;
+}
+
+void StrategyChoice::onFaceRemoved(const std::shared_ptr<Face> &face) {
+    for (const auto &entry : _entries) {
+        entry.second->strategy->onFaceRemoved(face);
+    }
+}
+
+std::string StrategyChoice::toJSON() const {
+    std::stringstream ss;
+    ss << "[";
+    bool first = true;
+    for (const auto &entry : _entries) {
+        if (first) {
+            first = false;
+        } else {
+            ss << ", ";
+        }
+        ss << R"({"prefix":")" << entry.first.toUri() << R"(", "strategy":")" << entry.second->strategy_name << R"("})";
+    }
+    ss << "]";
+    return ss.str();
+}
\ No newline at end of file
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <ndn-cxx/name.hpp>
+
+#include <map>
+#include <sstream>
+#include <memory>
+#include <string>
+
+#include "tree/named_tree.h"
+#include "strategy.h"
+
+// Strategy applied to each name prefix, a packet is forwarded by the strategy of its longest matching prefix.
+// Each prefix owns its strategy instance so the state of a strategy only reflects the traffic of its prefix.
+// The root prefix always has a strategy.
+class StrategyChoice {
+public:
+    struct Entry {
+        std::string strategy_name;
+        std::shared_ptr<Strategy> strategy;
+
+        std::string toJSON() const;
+    };
+
+private:
+    NamedTree<Entry> _tree;
+    std::map<ndn::Name, std::shared_ptr<Entry>> _entries;
+
+public:
+    StrategyChoice(const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy);
+
+    ~StrategyChoice() = default;
+
+    std::shared_ptr<Entry> find(const ndn::Name &prefix) const;
+
+    // a single lookup in the tree
+    std::shared_ptr<Entry> findLongestPrefixMatch(const ndn::Name &name) const;
+
+    void insert(const ndn::Name &prefix, const std::string &strategy_name, const std::shared_ptr<Strategy> &strategy);
+
+    // the root prefix can't be removed
+    bool remove(const ndn::Name &prefix);
+
+    void onFaceRemoved(const std::shared_ptr<Face> &face);
+
+    std::string toJSON() const;
+};
\ No newline at end of file
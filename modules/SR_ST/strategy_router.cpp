@@ -8,53 +8,96 @@
 #include "network/tcp_face.h"
 #include "network/udp_master_face.h"
 #include "network/udp_face.h"
+#include "network/unix_master_face.h"
+#include "network/unix_face.h"
+#include "network/shm_master_face.h"
+#include "network/shm_face.h"
 #include "multicast_strategy.h"
 #include "failover_strategy.h"
 #include "log/logger.h"
 #include "loadbalancing_strategy.h"
+#include "adaptive_strategy.h"
+#include "power_of_two_strategy.h"
 
-StrategyRouter::StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port)
+StrategyRouter::StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port, size_t max_connection)
         : Module(1)
         , _name(name)
+        , _strategy_choice("multicast", std::make_shared<MulticastStrategy>())
+        , _measurement_timer(_ios)
         , _command_socket(_ios, {{}, local_command_port}){
-    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, 16, local_port);
-    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, 16, local_port);
+    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, max_connection, local_port);
+    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, max_connection, local_port);
+    _unix_ingress_master_face = std::make_shared<UnixMasterFace>(_ios, max_connection, UnixMasterFace::getSocketPath(name));
+    _shm_ingress_master_face = std::make_shared<ShmMasterFace>(_ios, max_connection, ShmMasterFace::getSocketPath(name));
 }
 
 void StrategyRouter::run() {
-    _strategy = std::unique_ptr<Strategy>(new MulticastStrategy());
-    _strategy_name = "multicast";
     commandRead();
+    _measurement_timer.expires_from_now(boost::posix_time::milliseconds(100));
+    _measurement_timer.async_wait(boost::bind(&StrategyRouter::measurementTimerHandler, this, _1));
+    _tcp_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
     _tcp_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&StrategyRouter::onIngressInterest, this, _1, _2),
                                      boost::bind(&StrategyRouter::onIngressData, this, _1, _2),
                                      boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
+    _udp_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
     _udp_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&StrategyRouter::onIngressInterest, this, _1, _2),
                                      boost::bind(&StrategyRouter::onIngressData, this, _1, _2),
                                      boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
+    _unix_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
+    _unix_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
+                                      boost::bind(&StrategyRouter::onIngressInterest, this, _1, _2),
+                                      boost::bind(&StrategyRouter::onIngressData, this, _1, _2),
+                                      boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
+    _shm_ingress_master_face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
+    _shm_ingress_master_face->listen(boost::bind(&StrategyRouter::onMasterFaceNotification, this, _1, _2),
+                                     boost::bind(&StrategyRouter::onIngressInterest, this, _1, _2),
+                                     boost::bind(&StrategyRouter::onIngressData, this, _1, _2),
+                                     boost::bind(&StrategyRouter::onMasterFaceError, this, _1, _2));
 }
 
 void StrategyRouter::onIngressInterest(const std::shared_ptr<Face> &ingress_face, const ndn::Interest &interest) {
-    for (const auto& egress_face : _strategy->selectFaces(_egress_faces)) {
+    auto strategy = _strategy_choice.findLongestPrefixMatch(interest.getName())->strategy;
+    bool measure = strategy->needsMeasurements();
+    auto now = MeasurementTable::Clock::now();
+    size_t selected[Strategy::MAX_SELECTED_FACES];
+    size_t count = strategy->selectFaces(_egress_faces, selected);
+    for (size_t i = 0; i < count; ++i) {
+        const auto& egress_face = _egress_faces[selected[i]];
         egress_face->send(interest);
+        if (measure && _measurements.insert(interest.getName(), egress_face, strategy, now,
+                                            std::chrono::milliseconds(interest.getInterestLifetime().count()))) {
+            strategy->onInterestSent(egress_face);
+        }
     }
 }
 
 void StrategyRouter::onIngressData(const std::shared_ptr<Face> &ingress_face, const ndn::Data &data) {
-    for (const auto& egress_face : _strategy->selectFaces(_egress_faces)) {
-        egress_face->send(data);
+    size_t selected[Strategy::MAX_SELECTED_FACES];
+    size_t count = _strategy_choice.findLongestPrefixMatch(data.getName())->strategy->selectFaces(_egress_faces, selected);
+    for (size_t i = 0; i < count; ++i) {
+        _egress_faces[selected[i]]->send(data);
     }
 }
 
 void StrategyRouter::onEgressInterest(const std::shared_ptr<Face> &egress_face, const ndn::Interest &interest) {
     _tcp_ingress_master_face->sendToAllFaces(interest);
     _udp_ingress_master_face->sendToAllFaces(interest);
+    _unix_ingress_master_face->sendToAllFaces(interest);
+    _shm_ingress_master_face->sendToAllFaces(interest);
 }
 
 void StrategyRouter::onEgressData(const std::shared_ptr<Face> &egress_face, const ndn::Data &data) {
+    MeasurementTable::Clock::duration rtt;
+    std::shared_ptr<Strategy> strategy;
+    if (_measurements.size() > 0 && _measurements.satisfy(data.getName(), egress_face, MeasurementTable::Clock::now(), rtt, strategy)) {
+        strategy->onDataReceived(egress_face, rtt);
+    }
     _tcp_ingress_master_face->sendToAllFaces(data);
     _udp_ingress_master_face->sendToAllFaces(data);
+    _unix_ingress_master_face->sendToAllFaces(data);
+    _shm_ingress_master_face->sendToAllFaces(data);
 }
 
 void StrategyRouter::onMasterFaceNotification(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face> &face) {
@@ -77,11 +120,39 @@ void StrategyRouter::onFaceError(const std::shared_ptr<Face> &face) {
         if(egress_face == face) {
             std::swap(egress_face, _egress_faces.back());
             _egress_faces.pop_back();
+            _measurements.removeFace(face);
+            _strategy_choice.onFaceRemoved(face);
             break;
         }
     }
 }
 
+void StrategyRouter::onFaceCongestion(const std::shared_ptr<Face> &face, bool congested) {
+    // only reported to a manager, the sender of the last command may be long gone
+    if (_manager_endpoint.address() == boost::asio::ip::address_v4::any() || _manager_endpoint.port() == 0) {
+        return;
+    }
+    TxQueueStats stats = face->getTxQueueStats();
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"report", "action":"face_congestion", "face_id":)" << face->getFaceId()
+       << R"(, "congested":)" << (congested ? "true" : "false") << R"(, "queued_packets":)" << stats.packets
+       << R"(, "queued_bytes":)" << stats.bytes << R"(, "dropped_packets":)" << stats.dropped_packets
+       << R"(, "dropped_bytes":)" << stats.dropped_bytes << "}";
+    // from the packet path, a failed report must not throw out of the handler
+    boost::system::error_code err;
+    _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint, 0, err);
+}
+
+void StrategyRouter::measurementTimerHandler(const boost::system::error_code &err) {
+    if (!err) {
+        _measurements.expire(MeasurementTable::Clock::now(), [](const std::shared_ptr<Face> &face, const std::shared_ptr<Strategy> &strategy) {
+            strategy->onTimeout(face);
+        });
+        _measurement_timer.expires_from_now(boost::posix_time::milliseconds(100));
+        _measurement_timer.async_wait(boost::bind(&StrategyRouter::measurementTimerHandler, this, _1));
+    }
+}
+
 void StrategyRouter::commandRead() {
     _command_socket.async_receive_from(boost::asio::buffer(_command_buffer, 65536), _remote_command_endpoint,
                                        boost::bind(&StrategyRouter::commandReadHandler, this, _1, _2));
@@ -92,6 +163,8 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
         EDIT_CONFIG,
         ADD_FACE,
         DEL_FACE,
+        ADD_STRATEGIES,
+        DEL_STRATEGIES,
         LIST
     };
 
@@ -99,6 +172,8 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
             {"edit_config", EDIT_CONFIG},
             {"add_face", ADD_FACE},
             {"del_face", DEL_FACE},
+            {"add_strategies", ADD_STRATEGIES},
+            {"del_strategies", DEL_STRATEGIES},
             {"list", LIST}
     };
 
@@ -120,6 +195,12 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
                             case DEL_FACE:
                                 commandDelFace(document);
                                 break;
+                            case ADD_STRATEGIES:
+                                commandAddStrategies(document);
+                                break;
+                            case DEL_STRATEGIES:
+                                commandDelStrategies(document);
+                                break;
                             case LIST:
                                 commandList(document);
                                 break;
@@ -146,44 +227,27 @@ void StrategyRouter::commandReadHandler(const boost::system::error_code &err, si
 void StrategyRouter::commandEditConfig(const rapidjson::Document &document) {
     std::vector<std::string> changes;
     if (document.HasMember("strategy") && document["strategy"].IsString()) {
-        enum strategy_type {
-            MULTICAST,
-            LOADBALANCING,
-            FAILOVER
-        };
-
-        static const std::unordered_map<std::string, strategy_type> STRATEGIES = {
-                {"multicast", MULTICAST},
-                {"loadbalancing", LOADBALANCING},
-                {"failover", FAILOVER}
-        };
-
-        bool has_change = false;
-        if (document["strategy"].GetString() != _strategy_name) {
-            auto it = STRATEGIES.find(document["strategy"].GetString());
-            if (it != STRATEGIES.end()) {
-                switch (it->second) {
-                    case MULTICAST:
-                        _strategy = std::unique_ptr<Strategy>(new MulticastStrategy());
-                        _strategy_name = "multicast";
-                        break;
-                    case LOADBALANCING:
-                        _strategy = std::unique_ptr<Strategy>(new LoadbalancingStrategy());
-                        _strategy_name = "loadbalancing";
-                        break;
-                    case FAILOVER:
-                        _strategy = std::unique_ptr<Strategy>(new FailoverStrategy());
-                        _strategy_name = "failover";
-                        break;
-                }
-                has_change = true;
-            }
-            if (has_change) {
+        // the strategy of the root prefix, used by the names without a more specific strategy
+        if (document["strategy"].GetString() != _strategy_choice.find("/")->strategy_name) {
+            if (auto strategy = createStrategy(document["strategy"].GetString())) {
+                _strategy_choice.insert("/", document["strategy"].GetString(), strategy);
                 changes.emplace_back("strategy");
             }
         }
     }
 
+    if (document.HasMember("manager_address") && document.HasMember("manager_port") && document["manager_address"].IsString() && document["manager_port"].IsUint()) {
+        bool has_change = false;
+        boost::asio::ip::udp::endpoint new_endpoint(boost::asio::ip::address::from_string(document["manager_address"].GetString()), document["manager_port"].GetUint());
+        if (new_endpoint != _manager_endpoint) {
+            _manager_endpoint = new_endpoint;
+            has_change = true;
+        }
+        if (has_change) {
+            changes.emplace_back("manager_endpoint");
+        }
+    }
+
     std::stringstream ss;
     ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"edit_config", "changes":[)";
     bool first = true;
@@ -203,27 +267,79 @@ void StrategyRouter::commandAddFace(const rapidjson::Document &document) {
     enum layer_type {
         TCP,
         UDP,
+        UNIX,
+        SHM,
     };
 
     static const std::unordered_map<std::string, layer_type> LAYERS = {
             {"tcp", TCP},
             {"udp", UDP},
+            {"unix", UNIX},
+            {"shm", SHM},
+    };
+
+    static const std::unordered_map<std::string, DropPolicy> DROP_POLICIES = {
+            {"tail_drop", DropPolicy::TAIL_DROP},
+            {"head_drop", DropPolicy::HEAD_DROP},
+            {"priority_drop", DropPolicy::PRIORITY_DROP},
     };
 
-    if (document.HasMember("layer") && document.HasMember("address") && document.HasMember("port")
-        && document["layer"].IsString() && document["address"].IsString() && document["port"].IsUint()) {
+    if (document.HasMember("layer") && document.HasMember("address") && document["layer"].IsString() && document["address"].IsString()) {
+        // the address of a unix or shm face is the socket path of the module, only tcp and udp need a port
+        bool has_port = document.HasMember("port") && document["port"].IsUint();
         auto it = LAYERS.find(document["layer"].GetString());
-        if (it != LAYERS.end()) {
+        if (it != LAYERS.end() && (has_port || it->second == UNIX || it->second == SHM)) {
+            // the strategies select among the first MAX_SELECTED_FACES faces only, a face past them would never be used
+            if (_egress_faces.size() >= Strategy::MAX_SELECTED_FACES) {
+                std::stringstream ss;
+                ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint()
+                   << R"(, "action":"add_face", "status":"fail", "reason":"too many faces"})";
+                _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+                return;
+            }
             std::shared_ptr<Face> face;
             switch (it->second) {
                 case TCP:
                     face = std::make_shared<TcpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
                     break;
-                case UDP:
-                    face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                case UDP: {
+                    auto udp_face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                    if (document.HasMember("mtu") && document["mtu"].IsUint()) {
+                        udp_face->setMtu(document["mtu"].GetUint());
+                    }
+                    if (document.HasMember("aggregation") && document["aggregation"].IsBool()) {
+                        // the delay is given in microseconds
+                        uint32_t delay = document.HasMember("aggregation_delay") && document["aggregation_delay"].IsUint()
+                                         ? document["aggregation_delay"].GetUint() : 0;
+                        udp_face->setAggregation(document["aggregation"].GetBool(), boost::posix_time::microseconds(delay));
+                    }
+                    face = udp_face;
+                    break;
+                }
+                case UNIX:
+                    face = std::make_shared<UnixFace>(_ios, document["address"].GetString());
+                    break;
+                case SHM:
+                    face = std::make_shared<ShmFace>(_ios, document["address"].GetString());
                     break;
             }
             _egress_faces.push_back(face);
+            // optional bounds of the transmit queue of the face
+            TxQueueLimits limits;
+            if (document.HasMember("queue_packets") && document["queue_packets"].IsUint()) {
+                limits.packets = document["queue_packets"].GetUint();
+            }
+            if (document.HasMember("queue_bytes") && document["queue_bytes"].IsUint()) {
+                limits.bytes = document["queue_bytes"].GetUint();
+            }
+            if (document.HasMember("drop_policy") && document["drop_policy"].IsString()) {
+                auto policy = DROP_POLICIES.find(document["drop_policy"].GetString());
+                if (policy != DROP_POLICIES.end()) {
+                    limits.policy = policy->second;
+                }
+            }
+            face->setTxQueueLimits(limits);
+            face->setCongestionCallback(boost::bind(&StrategyRouter::onFaceCongestion, this, _1, _2));
             face->open(boost::bind(&StrategyRouter::onEgressInterest, this, _1, _2),
                        boost::bind(&StrategyRouter::onEgressData, this, _1, _2),
                        boost::bind(&StrategyRouter::onFaceError, this, _1));
@@ -241,6 +357,8 @@ void StrategyRouter::commandDelFace(const rapidjson::Document &document) {
         for (auto& egress_face : _egress_faces) {
             if (egress_face->getFaceId() == face_id) {
                 egress_face->close();
+                _measurements.removeFace(egress_face);
+                _strategy_choice.onFaceRemoved(egress_face);
                 std::swap(egress_face, _egress_faces[_egress_faces.size() - 1]);
                 _egress_faces.pop_back();
                 ok = true;
@@ -253,8 +371,115 @@ void StrategyRouter::commandDelFace(const rapidjson::Document &document) {
     }
 }
 
+void StrategyRouter::commandAddStrategies(const rapidjson::Document &document) {
+    if (document.HasMember("strategies") && document["strategies"].IsArray()) {
+        std::stringstream ss;
+        ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"add_strategies", )";
+        auto &&strategies = document["strategies"].GetArray();
+        if (strategies.Empty()) {
+            ss << R"("status":"fail", "reason":"empty prefix list"})";
+        } else {
+            std::vector<std::string> status;
+            for (auto &choice : strategies) {
+                if (choice.IsArray() && choice.Size() == 2 && choice[0].IsString() && choice[1].IsString()) {
+                    ndn::Name prefix(choice[0].GetString());
+                    auto entry = _strategy_choice.find(prefix);
+                    // an unchanged strategy keeps its state
+                    if (entry && entry->strategy_name == choice[1].GetString()) {
+                        status.emplace_back("success");
+                    } else if (auto strategy = createStrategy(choice[1].GetString())) {
+                        _strategy_choice.insert(prefix, choice[1].GetString(), strategy);
+                        status.emplace_back("success");
+                    } else {
+                        status.emplace_back("fail");
+                    }
+                } else {
+                    status.emplace_back("fail");
+                }
+            }
+            ss << R"("status":[)";
+            bool first = true;
+            for(const auto& s : status) {
+                if (first) {
+                    first = false;
+                } else {
+                    ss << ",";
+                }
+                ss << '"' << s << '"';
+            }
+            ss << "]}";
+        }
+        _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+    }
+}
+
+void StrategyRouter::commandDelStrategies(const rapidjson::Document &document) {
+    if (document.HasMember("prefixes") && document["prefixes"].IsArray()) {
+        std::stringstream ss;
+        ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"del_strategies", )";
+        auto &&prefixes = document["prefixes"].GetArray();
+        if (prefixes.Empty()) {
+            ss << R"("status":"fail", "reason":"empty prefix list"})";
+        } else {
+            std::vector<std::string> status;
+            for (auto &prefix : prefixes) {
+                status.emplace_back(prefix.IsString() && _strategy_choice.remove(ndn::Name(prefix.GetString())) ? "success" : "fail");
+            }
+            ss << R"("status":[)";
+            bool first = true;
+            for(const auto& s : status) {
+                if (first) {
+                    first = false;
+                } else {
+                    ss << ",";
+                }
+                ss << '"' << s << '"';
+            }
+            ss << "]}";
+        }
+        _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+    }
+}
+
 void StrategyRouter::commandList(const rapidjson::Document &document) {
     std::stringstream ss;
-    ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"list", "strategy":")" << _strategy_name << "\"}";
+    ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"list", "strategy":")"
+       << _strategy_choice.find("/")->strategy_name << R"(", "strategies":)" << _strategy_choice.toJSON() << "}";
     _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
 }
+
+std::shared_ptr<Strategy> StrategyRouter::createStrategy(const std::string &strategy_name) {
+    enum strategy_type {
+        MULTICAST,
+        LOADBALANCING,
+        FAILOVER,
+        ADAPTIVE,
+        POWER_OF_TWO
+    };
+
+    static const std::unordered_map<std::string, strategy_type> STRATEGIES = {
+            {"multicast", MULTICAST},
+            {"loadbalancing", LOADBALANCING},
+            {"failover", FAILOVER},
+            {"adaptive", ADAPTIVE},
+            {"power_of_two", POWER_OF_TWO}
+    };
+
+    auto it = STRATEGIES.find(strategy_name);
+    if (it == STRATEGIES.end()) {
+        return nullptr;
+    }
+    switch (it->second) {
+        case MULTICAST:
+            return std::make_shared<MulticastStrategy>();
+        case LOADBALANCING:
+            return std::make_shared<LoadbalancingStrategy>();
+        case FAILOVER:
+            return std::make_shared<FailoverStrategy>();
+        case ADAPTIVE:
+            return std::make_shared<AdaptiveStrategy>();
+        case POWER_OF_TWO:
+            return std::make_shared<PowerOfTwoStrategy>();
+    }
+    return nullptr;
+}
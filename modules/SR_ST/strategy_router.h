@@ -15,24 +15,30 @@
 #include "network/face.h"
 #include "network/master_face.h"
 #include "strategy.h"
+#include "strategy_choice.h"
+#include "measurement_table.h"
 
 class StrategyRouter : public Module {
 private:
     const std::string _name;
 
-    std::string _strategy_name;
-    std::unique_ptr<Strategy> _strategy;
+    StrategyChoice _strategy_choice;
+    MeasurementTable _measurements;
+    boost::asio::deadline_timer _measurement_timer;
 
     char _command_buffer[65536];
     boost::asio::ip::udp::socket _command_socket;
     boost::asio::ip::udp::endpoint _remote_command_endpoint;
+    boost::asio::ip::udp::endpoint _manager_endpoint;
 
     std::vector<std::shared_ptr<Face>> _egress_faces;
     std::shared_ptr<MasterFace> _tcp_ingress_master_face;
     std::shared_ptr<MasterFace> _udp_ingress_master_face;
+    std::shared_ptr<MasterFace> _unix_ingress_master_face;
+    std::shared_ptr<MasterFace> _shm_ingress_master_face;
 
 public:
-    StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port);
+    StrategyRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port, size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION);
 
     ~StrategyRouter() override = default;
 
@@ -52,6 +58,10 @@ public:
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
+    void measurementTimerHandler(const boost::system::error_code &err);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
@@ -62,5 +72,13 @@ public:
 
     void commandDelFace(const rapidjson::Document &document);
 
+    void commandAddStrategies(const rapidjson::Document &document);
+
+    void commandDelStrategies(const rapidjson::Document &document);
+
     void commandList(const rapidjson::Document &document);
+
+private:
+    // nullptr if the strategy does not exist
+    static std::shared_ptr<Strategy> createStrategy(const std::string &strategy_name);
 };
\ No newline at end of file
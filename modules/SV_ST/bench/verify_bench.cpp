@@ -0,0 +1,112 @@
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/pem.h>
+#include <openssl/rsa.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../key_verifier.h"
+#include "../verification_pool.h"
+
+// Measures verified Data/s through the verification pool for a growing number of workers,
+// with RSA-2048 and ECDSA P-256 signatures over Data-sized payloads and completions handled by a single thread like the module.
+static const size_t PACKETS = 20000;
+static const size_t PAYLOAD_SIZE = 1200;
+
+struct SignedPacket {
+    std::vector<unsigned char> payload;
+    std::vector<unsigned char> signature;
+};
+
+static EVP_PKEY* generateKey(int type) {
+    EVP_PKEY *pkey = nullptr;
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(type, nullptr);
+    EVP_PKEY_keygen_init(ctx);
+    if (type == EVP_PKEY_RSA) {
+        EVP_PKEY_CTX_set_rsa_keygen_bits(ctx, 2048);
+    } else {
+        EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1);
+    }
+    EVP_PKEY_keygen(ctx, &pkey);
+    EVP_PKEY_CTX_free(ctx);
+    return pkey;
+}
+
+static std::string publicPem(EVP_PKEY *pkey) {
+    BIO *bio = BIO_new(BIO_s_mem());
+    PEM_write_bio_PUBKEY(bio, pkey);
+    char *data;
+    long size = BIO_get_mem_data(bio, &data);
+    std::string pem(data, size);
+    BIO_free(bio);
+    return pem;
+}
+
+static std::vector<SignedPacket> makePackets(EVP_PKEY *pkey, size_t count) {
+    std::vector<SignedPacket> packets(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto &packet = packets[i];
+        packet.payload.resize(PAYLOAD_SIZE);
+        for (size_t j = 0; j < PAYLOAD_SIZE; ++j) {
+            packet.payload[j] = (unsigned char)(i * 31 + j);
+        }
+        size_t size = EVP_PKEY_size(pkey);
+        packet.signature.resize(size);
+        EVP_MD_CTX *ctx = EVP_MD_CTX_create();
+        EVP_DigestSignInit(ctx, nullptr, EVP_sha256(), nullptr, pkey);
+        EVP_DigestSignUpdate(ctx, packet.payload.data(), packet.payload.size());
+        EVP_DigestSignFinal(ctx, packet.signature.data(), &size);
+        EVP_MD_CTX_destroy(ctx);
+        packet.signature.resize(size);
+    }
+    return packets;
+}
+
+static void run(const std::string &label, const std::shared_ptr<KeyVerifier> &key, const std::vector<SignedPacket> &packets,
+                size_t workers) {
+    boost::asio::io_service completion_ios;
+    boost::asio::io_service::work completion_work(completion_ios);
+    size_t completed = 0;
+    size_t invalid = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        VerificationPool pool(completion_ios, workers);
+        for (size_t i = 0; i < PACKETS; ++i) {
+            const auto &packet = packets[i % packets.size()];
+            pool.submit([&key, &packet](size_t worker_index) {
+                            return key->verify(key->getType(), packet.payload.data(), packet.payload.size(),
+                                               packet.signature.data(), packet.signature.size(), worker_index);
+                        },
+                        [&completed, &invalid](int result) {
+                            ++completed;
+                            invalid += result != 0;
+                        });
+        }
+        while (completed < PACKETS) {
+            completion_ios.run_one();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    std::cout << label << ", " << workers << " workers: " << (uint64_t)(PACKETS * 1e6 / elapsed) << " Data/s ("
+              << invalid << " invalid)" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    size_t max_workers = argc > 1 ? std::atoi(argv[1]) : std::max(boost::thread::hardware_concurrency(), 1u);
+    for (int type : {EVP_PKEY_RSA, EVP_PKEY_EC}) {
+        EVP_PKEY *pkey = generateKey(type);
+        auto key = KeyVerifier::fromPem(publicPem(pkey), max_workers);
+        auto packets = makePackets(pkey, 256);
+        EVP_PKEY_free(pkey);
+
+        for (size_t workers = 1; workers <= max_workers; workers *= 2) {
+            run(type == EVP_PKEY_RSA ? "RSA-2048" : "ECDSA P-256", key, packets, workers);
+        }
+    }
+    return 0;
+}
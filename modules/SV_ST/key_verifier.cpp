@@ -0,0 +1,113 @@
+#include "key_verifier.h"
+
+#include <openssl/core_names.h>
+#include <openssl/crypto.h>
+#include <openssl/params.h>
+#include <openssl/pem.h>
+#include <openssl/sha.h>
+
+KeyVerifier::KeyVerifier(EVP_PKEY *pkey, SignatureType type, size_t contexts) : _type(type), _pkey(pkey, EVP_PKEY_free) {
+    _contexts.reserve(contexts);
+    for (size_t i = 0; i < contexts; ++i) {
+        ContextPtr ctx(EVP_PKEY_CTX_new(pkey, NULL), EVP_PKEY_CTX_free);
+        if (!ctx || EVP_PKEY_verify_init(ctx.get()) != 1 || EVP_PKEY_CTX_set_signature_md(ctx.get(), EVP_sha256()) != 1) {
+            ctx.reset();
+        }
+        _contexts.emplace_back(std::move(ctx));
+    }
+}
+
+KeyVerifier::KeyVerifier(const std::string &secret, size_t contexts) : _type(HMAC_WITH_SHA256) {
+    EVP_MAC *mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+    OSSL_PARAM params[] = {
+        OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, (char *)"SHA256", 0),
+        OSSL_PARAM_construct_end(),
+    };
+    _mac_contexts.reserve(contexts);
+    for (size_t i = 0; i < contexts; ++i) {
+        MacContextPtr ctx(mac ? EVP_MAC_CTX_new(mac) : NULL, EVP_MAC_CTX_free);
+        if (!ctx || EVP_MAC_init(ctx.get(), (const unsigned char *)secret.data(), secret.size(), params) != 1) {
+            ctx.reset();
+        }
+        _mac_contexts.emplace_back(std::move(ctx));
+    }
+    // the contexts keep their own reference
+    EVP_MAC_free(mac);
+}
+
+std::shared_ptr<KeyVerifier> KeyVerifier::fromPem(const std::string &pem, size_t contexts) {
+    BIO *bio = BIO_new_mem_buf(pem.c_str(), pem.size());
+    EVP_PKEY *pkey = PEM_read_bio_PUBKEY(bio, NULL, NULL, NULL);
+    BIO_free(bio);
+    if (pkey == nullptr) {
+        return nullptr;
+    }
+    switch (EVP_PKEY_base_id(pkey)) {
+        case EVP_PKEY_RSA:
+            return std::make_shared<KeyVerifier>(pkey, SHA256_WITH_RSA, contexts);
+        case EVP_PKEY_EC:
+            return std::make_shared<KeyVerifier>(pkey, SHA256_WITH_ECDSA, contexts);
+        default:
+            EVP_PKEY_free(pkey);
+            return nullptr;
+    }
+}
+
+std::shared_ptr<KeyVerifier> KeyVerifier::fromHmacSecret(const std::string &base64, size_t contexts) {
+    if (base64.empty() || base64.size() % 4 != 0) {
+        return nullptr;
+    }
+    std::string secret(base64.size() / 4 * 3, '\0');
+    int size = EVP_DecodeBlock((unsigned char *)&secret[0], (const unsigned char *)base64.data(), base64.size());
+    if (size < 0) {
+        return nullptr;
+    }
+    // EVP_DecodeBlock keeps the bytes of the padding
+    size -= (base64[base64.size() - 1] == '=') + (base64[base64.size() - 2] == '=');
+    secret.resize(size);
+    return std::make_shared<KeyVerifier>(secret, contexts);
+}
+
+int KeyVerifier::verifyDigest(const unsigned char *msg, size_t mlen, const unsigned char *sig, size_t slen) {
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    if (!msg || slen != SHA256_DIGEST_LENGTH) {
+        return 1;
+    }
+    SHA256(msg, mlen, digest);
+    return CRYPTO_memcmp(digest, sig, SHA256_DIGEST_LENGTH) != 0;
+}
+
+KeyVerifier::SignatureType KeyVerifier::getType() const {
+    return _type;
+}
+
+size_t KeyVerifier::getContexts() const {
+    return _type == HMAC_WITH_SHA256 ? _mac_contexts.size() : _contexts.size();
+}
+
+int KeyVerifier::verify(uint32_t type, const unsigned char *msg, size_t mlen, const unsigned char *sig, size_t slen,
+                        size_t context_index) const {
+    if (!msg || !mlen || !sig || !slen || type != _type) {
+        return 1;
+    }
+    if (_type == HMAC_WITH_SHA256) {
+        if (context_index >= _mac_contexts.size() || !_mac_contexts[context_index]) {
+            return 1;
+        }
+        EVP_MAC_CTX *ctx = _mac_contexts[context_index].get();
+        unsigned char mac[EVP_MAX_MD_SIZE];
+        size_t mac_size = 0;
+        // without a key, the init restores the keyed state instead of hashing the secret again
+        if (EVP_MAC_init(ctx, NULL, 0, NULL) != 1 || EVP_MAC_update(ctx, msg, mlen) != 1 ||
+            EVP_MAC_final(ctx, mac, &mac_size, sizeof(mac)) != 1) {
+            return 1;
+        }
+        return mac_size != slen || CRYPTO_memcmp(mac, sig, slen) != 0;
+    }
+    if (context_index >= _contexts.size() || !_contexts[context_index]) {
+        return 1;
+    }
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256(msg, mlen, digest);
+    return EVP_PKEY_verify(_contexts[context_index].get(), sig, slen, digest, sizeof(digest)) != 1;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <openssl/evp.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Trusted key shared between the packet thread and the verification workers. Each context index owns an
+// EVP_PKEY_CTX initialized once for verification, or for an HMAC secret an EVP_MAC_CTX keyed once, so a packet costs
+// one SHA-256 and one public key operation, or one HMAC from the precomputed pads, without any per-packet context setup.
+// A context index must only be used by one thread at a time.
+class KeyVerifier {
+public:
+    // values of the NDN SignatureType field
+    enum SignatureType {
+        DIGEST_SHA256 = 0,
+        SHA256_WITH_RSA = 1,
+        SHA256_WITH_ECDSA = 3,
+        HMAC_WITH_SHA256 = 4,
+    };
+
+private:
+    using ContextPtr = std::unique_ptr<EVP_PKEY_CTX, void (*)(EVP_PKEY_CTX *)>;
+    using MacContextPtr = std::unique_ptr<EVP_MAC_CTX, void (*)(EVP_MAC_CTX *)>;
+
+    SignatureType _type;
+    std::shared_ptr<EVP_PKEY> _pkey;
+    std::vector<ContextPtr> _contexts;
+    std::vector<MacContextPtr> _mac_contexts;
+
+public:
+    KeyVerifier(EVP_PKEY *pkey, SignatureType type, size_t contexts);
+
+    KeyVerifier(const std::string &secret, size_t contexts);
+
+    ~KeyVerifier() = default;
+
+    // RSA or EC public key, one context per index in [0, contexts)
+    static std::shared_ptr<KeyVerifier> fromPem(const std::string &pem, size_t contexts);
+
+    // base64 encoded HMAC secret, one context per index in [0, contexts)
+    static std::shared_ptr<KeyVerifier> fromHmacSecret(const std::string &base64, size_t contexts);
+
+    // checks a DigestSha256 signature, which needs no key
+    static int verifyDigest(const unsigned char *msg, size_t mlen, const unsigned char *sig, size_t slen);
+
+    SignatureType getType() const;
+
+    size_t getContexts() const;
+
+    // returns 0 when the signature is valid and made with the type of this key
+    int verify(uint32_t type, const unsigned char *msg, size_t mlen, const unsigned char *sig, size_t slen,
+               size_t context_index) const;
+};
@@ -0,0 +1,138 @@
+#include "manifest_store.h"
+
+#include <cstring>
+
+static bool readVarNumber(const uint8_t *&it, const uint8_t *end, uint64_t &number) {
+    if (it >= end) {
+        return false;
+    }
+    size_t size;
+    switch (*it) {
+        case 253:
+            size = 2;
+            break;
+        case 254:
+            size = 4;
+            break;
+        case 255:
+            size = 8;
+            break;
+        default:
+            number = *it++;
+            return true;
+    }
+    if (end - it < (ptrdiff_t)size + 1) {
+        return false;
+    }
+    ++it;
+    number = 0;
+    for (size_t i = 0; i < size; ++i) {
+        number = (number << 8) | *it++;
+    }
+    return true;
+}
+
+size_t ManifestStore::DigestHash::operator()(const Digest &digest) const {
+    size_t hash;
+    std::memcpy(&hash, digest.data(), sizeof(hash));
+    return hash;
+}
+
+ManifestStore::ManifestStore(size_t max_digests) : _max_digests(max_digests) {
+
+}
+
+bool ManifestStore::isManifest(const ndn::Data &data) {
+    return data.getContentType() == CONTENT_TYPE_MANIFEST;
+}
+
+bool ManifestStore::getDigest(const ndn::Data &data, Digest &digest) {
+    const auto &component = data.getFullName().get(-1);
+    if (!component.isImplicitSha256Digest() || component.value_size() != digest.size()) {
+        return false;
+    }
+    std::memcpy(digest.data(), component.value(), digest.size());
+    return true;
+}
+
+size_t ManifestStore::getSize() const {
+    return _max_digests;
+}
+
+void ManifestStore::setSize(size_t max_digests) {
+    _max_digests = max_digests;
+    if (_max_digests == 0) {
+        clear();
+    }
+    evict();
+}
+
+size_t ManifestStore::getManifests() const {
+    return _manifests.size();
+}
+
+size_t ManifestStore::getDigests() const {
+    return _digests.size();
+}
+
+size_t ManifestStore::getCovered() const {
+    return _covered;
+}
+
+void ManifestStore::resetCounters() {
+    _covered = 0;
+}
+
+void ManifestStore::clear() {
+    _manifests.clear();
+    _manifest_digests.clear();
+    _digests.clear();
+}
+
+void ManifestStore::insert(const ndn::Data &manifest) {
+    Manifest entry;
+    if (_max_digests == 0 || !getDigest(manifest, entry.digest) || !_manifest_digests.emplace(entry.digest).second) {
+        return;
+    }
+    const ndn::Block &content = manifest.getContent();
+    const uint8_t *it = content.value();
+    const uint8_t *end = it + content.value_size();
+    while (it < end) {
+        uint64_t type, length;
+        if (!readVarNumber(it, end, type) || !readVarNumber(it, end, length) || (uint64_t)(end - it) < length) {
+            break;
+        }
+        // ImplicitSha256DigestComponent, other elements are ignored
+        if (type == 1 && length == entry.digest.size()) {
+            Digest digest;
+            std::memcpy(digest.data(), it, digest.size());
+            ++_digests[digest];
+            entry.digests.emplace_back(digest);
+        }
+        it += length;
+    }
+    _manifests.emplace_back(std::move(entry));
+    evict();
+}
+
+bool ManifestStore::covers(const ndn::Data &data) {
+    Digest digest;
+    if (!_digests.empty() && getDigest(data, digest) && _digests.count(digest) > 0) {
+        ++_covered;
+        return true;
+    }
+    return false;
+}
+
+void ManifestStore::evict() {
+    while (!_manifests.empty() && _digests.size() > _max_digests) {
+        for (const auto &digest : _manifests.front().digests) {
+            auto it = _digests.find(digest);
+            if (it != _digests.end() && --it->second == 0) {
+                _digests.erase(it);
+            }
+        }
+        _manifest_digests.erase(_manifests.front().digest);
+        _manifests.pop_front();
+    }
+}
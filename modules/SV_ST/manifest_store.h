@@ -0,0 +1,68 @@
+#pragma once
+
+#include <ndn-cxx/data.hpp>
+
+#include <array>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Implicit digests listed by verified manifests. A manifest is a Data with ContentType 4 whose content is a
+// sequence of ImplicitSha256DigestComponent TLVs, once its signature is verified every listed Data is
+// authenticated by its implicit digest alone. Oldest manifests are evicted first when too many digests are held.
+class ManifestStore {
+public:
+    static const uint32_t CONTENT_TYPE_MANIFEST = 4;
+
+    using Digest = std::array<uint8_t, 32>;
+
+private:
+    struct DigestHash {
+        size_t operator()(const Digest &digest) const;
+    };
+
+    struct Manifest {
+        Digest digest;
+        std::vector<Digest> digests;
+    };
+
+    size_t _max_digests;
+    std::deque<Manifest> _manifests;
+    std::unordered_set<Digest, DigestHash> _manifest_digests;
+    // a segment may be listed by several manifests
+    std::unordered_map<Digest, size_t, DigestHash> _digests;
+    size_t _covered = 0;
+
+public:
+    explicit ManifestStore(size_t max_digests);
+
+    ~ManifestStore() = default;
+
+    static bool isManifest(const ndn::Data &data);
+
+    static bool getDigest(const ndn::Data &data, Digest &digest);
+
+    size_t getSize() const;
+
+    void setSize(size_t max_digests);
+
+    size_t getManifests() const;
+
+    size_t getDigests() const;
+
+    size_t getCovered() const;
+
+    void resetCounters();
+
+    void clear();
+
+    // must only be called with manifests whose signature is valid
+    void insert(const ndn::Data &manifest);
+
+    // true when the Data is listed by a verified manifest, costs the computation of its implicit digest
+    bool covers(const ndn::Data &data);
+
+private:
+    void evict();
+};
@@ -1,29 +1,58 @@
 #pragma once
 
-#include <map>
 #include <deque>
+#include <unordered_map>
+#include <vector>
 
+#include "concurrency.h"
 #include "master_face.h"
 #include "face.h"
+#include "lp_fragmenter.h"
+#include "lp_reassembler.h"
 
 class UdpSubFace;
 
+// Each sub-face queues its own packets, the sub-faces with packets to send take turns on the socket one datagram at a
+// time, so a slow or flooded remote endpoint only fills its own queue.
+// The sub-faces don't arm a timer per packet, they note the sweep tick of their last activity and a sweep of all the
+// sub-faces every second sends the keepalives and closes the idle ones.
 class UdpMasterFace : public MasterFace, public std::enable_shared_from_this<UdpMasterFace> {
 public:
     static const size_t BUFFER_SIZE = 1 << 16;
+    static const size_t MAX_AGGREGATED_PACKETS = 64;
+    // in sweeps, a face idle for longer is sent a keepalive, then closed
+    static const uint64_t KEEPALIVE_TICKS = 3;
+    static const uint64_t IDLE_TIMEOUT_TICKS = 5;
+
+    struct EndpointHash {
+        size_t operator()(const boost::asio::ip::udp::endpoint &endpoint) const;
+    };
 
     class UdpSubFace : public Face, public std::enable_shared_from_this<UdpSubFace> {
     private:
         UdpMasterFace &_master_face;
 
         boost::asio::ip::udp::endpoint _endpoint;
-        boost::asio::deadline_timer _timer;
+        // sweep tick of the last packet received or sent
+        uint64_t _last_activity;
+        bool _is_keepalive_sent = false;
+        TxQueue<std::string> _queue;
+        LpFragmenter _fragmenter;
+        LpReassembler _reassembler;
+        bool _is_flush_pending = false;
+        boost::asio::deadline_timer _flush_timer;
+
+        friend class UdpMasterFace;
 
     public:
         UdpSubFace(UdpMasterFace &master_face, const boost::asio::ip::udp::endpoint &endpoint);
 
         ~UdpSubFace() override = default;
 
+        void setTxQueueLimits(const TxQueueLimits &limits) override;
+
+        TxQueueStats getTxQueueStats() const override;
+
         std::string getUnderlyingProtocol() const override;
 
         std::string getUnderlyingEndpoint() const override;
@@ -43,18 +72,29 @@ public:
         void proceedPacket(const char* buffer, size_t size);
 
     private:
-        void timerHandler(const boost::system::error_code &err, bool last_chance);
+        void sendImpl(const std::string &message);
+
+        void flushHandler(const boost::system::error_code &err);
     };
 
 private:
     boost::asio::ip::udp::endpoint _local_endpoint;
     boost::asio::ip::udp::endpoint _remote_endpoint;
     boost::asio::ip::udp::socket _socket;
-    boost::asio::strand _strand;
+    Strand _strand;
     char _buffer[BUFFER_SIZE];
-    std::map<boost::asio::ip::udp::endpoint, std::shared_ptr<UdpSubFace>> _faces;
-    bool _queue_in_use = false;
-    std::deque<std::pair<const std::string, const boost::asio::ip::udp::endpoint>> _queue;
+    std::unordered_map<boost::asio::ip::udp::endpoint, std::shared_ptr<UdpSubFace>, EndpointHash> _faces;
+    // the sub-face of the last datagram, a burst from the same endpoint skips the lookup
+    std::shared_ptr<UdpSubFace> _last_face;
+    std::deque<std::shared_ptr<UdpSubFace>> _ready;
+    bool _is_writing = false;
+    std::vector<boost::asio::const_buffer> _write_buffers;
+    size_t _mtu = LpFragmenter::DEFAULT_MTU;
+    bool _aggregation = false;
+    boost::posix_time::time_duration _aggregation_delay;
+    boost::asio::deadline_timer _sweep_timer;
+    // coarse clock of the sub-faces, counts the sweeps
+    uint64_t _ticks = 0;
 
 public:
     UdpMasterFace(boost::asio::io_service &ios, size_t max_connection, uint16_t port);
@@ -63,6 +103,12 @@ public:
 
     std::string getUnderlyingProtocol() const override;
 
+    // applies to the faces accepted from then on, see UdpFace::setMtu
+    void setMtu(size_t mtu);
+
+    // applies to all the faces of the master face, must be called before it listens, see UdpFace::setAggregation
+    void setAggregation(bool enabled, const boost::posix_time::time_duration &delay = boost::posix_time::time_duration());
+
     void listen(const NotificationCallback &notification_callback, const Face::InterestCallback &interest_callback,
                 const Face::DataCallback &data_callback, const ErrorCallback &error_callback) override;
 
@@ -79,7 +125,11 @@ private:
 
     void readHandler(const boost::system::error_code &err, size_t bytes_transferred);
 
-    void sendImpl(const std::string &message, const boost::asio::ip::udp::endpoint &endpoint);
+    void sweep();
+
+    void sweepHandler(const boost::system::error_code &err);
+
+    void schedule(const std::shared_ptr<UdpSubFace> &face);
 
     void write();
 
@@ -0,0 +1,110 @@
+#include "sampling_policy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+double SamplingPolicy::getDefaultRate() const {
+    return _default_rate;
+}
+
+void SamplingPolicy::setDefaultRate(double rate) {
+    _default_rate = std::min(std::max(rate, 0.0), 1.0);
+    ++_rates_generation;
+}
+
+const std::chrono::milliseconds& SamplingPolicy::getHalfLife() const {
+    return _half_life;
+}
+
+void SamplingPolicy::setHalfLife(const std::chrono::milliseconds &half_life) {
+    _half_life = half_life;
+}
+
+void SamplingPolicy::setPrefixRate(const ndn::Name &prefix, double rate) {
+    _prefix_rates[prefix] = std::min(std::max(rate, 0.0), 1.0);
+    ++_rates_generation;
+}
+
+bool SamplingPolicy::removePrefixRate(const ndn::Name &prefix) {
+    if (_prefix_rates.erase(prefix) > 0) {
+        ++_rates_generation;
+        return true;
+    }
+    return false;
+}
+
+void SamplingPolicy::removeKey(const ndn::Name &key_name) {
+    _states.erase(key_name);
+}
+
+bool SamplingPolicy::sample(const ndn::Name &key_name, const Clock::time_point &now) {
+    KeyState &state = getState(key_name);
+    double rate = getRate(state, now);
+    if (rate >= 1 || (rate > 0 && _distribution(_generator) < rate)) {
+        ++state.verified;
+        return true;
+    }
+    ++state.skipped;
+    return false;
+}
+
+void SamplingPolicy::onInvalidSignature(const ndn::Name &key_name, const Clock::time_point &now) {
+    KeyState &state = getState(key_name);
+    if (!state.escalated || getRate(state, now) < 1) {
+        ++state.escalations;
+    }
+    state.escalated = true;
+    state.last_invalid = now;
+}
+
+std::string SamplingPolicy::reportToJSON(const Clock::time_point &now) {
+    std::stringstream ss;
+    bool first = true;
+    for (auto &pair : _states) {
+        KeyState &state = pair.second;
+        if (state.verified + state.skipped + state.escalations == 0) {
+            continue;
+        }
+        ss << (first ? "" : ", ") << R"({"key":")" << pair.first.toUri() << R"(", "rate":)" << getRate(state, now)
+           << R"(, "verified":)" << state.verified << R"(, "skipped":)" << state.skipped
+           << R"(, "escalations":)" << state.escalations << "}";
+        first = false;
+        state.verified = 0;
+        state.skipped = 0;
+        state.escalations = 0;
+    }
+    return first ? "" : "[" + ss.str() + "]";
+}
+
+SamplingPolicy::KeyState& SamplingPolicy::getState(const ndn::Name &key_name) {
+    KeyState &state = _states[key_name];
+    if (state.rates_generation != _rates_generation) {
+        state.base_rate = _default_rate;
+        for (ssize_t i = key_name.size(); i >= 0; --i) {
+            auto it = _prefix_rates.find(key_name.getPrefix(i));
+            if (it != _prefix_rates.end()) {
+                state.base_rate = it->second;
+                break;
+            }
+        }
+        state.rates_generation = _rates_generation;
+    }
+    return state;
+}
+
+double SamplingPolicy::getRate(KeyState &state, const Clock::time_point &now) const {
+    if (!state.escalated) {
+        return state.base_rate;
+    }
+    double half_lives = _half_life.count() > 0
+                        ? std::chrono::duration<double, std::milli>(now - state.last_invalid).count() / _half_life.count()
+                        : INFINITY;
+    // the part of the traffic that would have been skipped is brought back to verification, then released
+    double rate = state.base_rate + (1 - state.base_rate) * std::exp2(-half_lives);
+    if (rate - state.base_rate < 0.001) {
+        state.escalated = false;
+        return state.base_rate;
+    }
+    return rate;
+}
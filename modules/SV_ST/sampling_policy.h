@@ -0,0 +1,67 @@
+#pragma once
+
+#include <ndn-cxx/name.hpp>
+
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+
+// Decides which signed Data are verified. Each key is verified at the rate of the longest configured prefix
+// of its name (default rate otherwise). An invalid signature escalates the key to 100% verification,
+// the extra effort then halves every half-life while the key stays clean, down to its configured rate.
+class SamplingPolicy {
+public:
+    using Clock = std::chrono::steady_clock;
+
+private:
+    struct KeyState {
+        size_t rates_generation = 0;
+        double base_rate = 1;
+        bool escalated = false;
+        Clock::time_point last_invalid;
+        size_t verified = 0;
+        size_t skipped = 0;
+        size_t escalations = 0;
+    };
+
+    double _default_rate = 1;
+    std::chrono::milliseconds _half_life {60000};
+    std::map<ndn::Name, double> _prefix_rates;
+    size_t _rates_generation = 1;
+    std::map<ndn::Name, KeyState> _states;
+    std::minstd_rand _generator;
+    std::uniform_real_distribution<double> _distribution {0, 1};
+
+public:
+    SamplingPolicy() = default;
+
+    ~SamplingPolicy() = default;
+
+    double getDefaultRate() const;
+
+    void setDefaultRate(double rate);
+
+    const std::chrono::milliseconds& getHalfLife() const;
+
+    void setHalfLife(const std::chrono::milliseconds &half_life);
+
+    void setPrefixRate(const ndn::Name &prefix, double rate);
+
+    bool removePrefixRate(const ndn::Name &prefix);
+
+    void removeKey(const ndn::Name &key_name);
+
+    // true when the Data signed by this key must be verified
+    bool sample(const ndn::Name &key_name, const Clock::time_point &now);
+
+    void onInvalidSignature(const ndn::Name &key_name, const Clock::time_point &now);
+
+    // per key rates and counters since the last call, an empty string when nothing happened
+    std::string reportToJSON(const Clock::time_point &now);
+
+private:
+    KeyState& getState(const ndn::Name &key_name);
+
+    double getRate(KeyState &state, const Clock::time_point &now) const;
+};
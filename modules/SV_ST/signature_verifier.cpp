@@ -8,6 +8,10 @@
 #include "network/tcp_face.h"
 #include "network/udp_master_face.h"
 #include "network/udp_face.h"
+#include "network/unix_master_face.h"
+#include "network/unix_face.h"
+#include "network/shm_master_face.h"
+#include "network/shm_face.h"
 #include "log/logger.h"
 
 //static BIO *bio = BIO_new_mem_buf(RSA_PUBLIC_KEY.c_str(), RSA_PUBLIC_KEY.length());
@@ -16,26 +20,43 @@
 //static EVP_PKEY* pkey = d2i_PUBKEY_bio(bio, NULL);
 //static EVP_PKEY* pkey = d2i_PUBKEY_fp(fopen("tan.pub", "r"), NULL);
 
-SignatureVerifier::SignatureVerifier(const std::string &name, uint16_t local_port, uint16_t command_local_port)
+SignatureVerifier::SignatureVerifier(const std::string &name, uint16_t local_port, uint16_t command_local_port, size_t workers, size_t max_connection)
         : Module(1)
         , _name(name)
         , _command_socket(_ios, {{}, 10000})
         , _report_timer(_ios)
-        , _delay_between_report(0) {
-    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, 16, local_port);
-    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, 16, local_port);
+        , _delay_between_report(0)
+        , _verify_cache(65536)
+        , _manifest_store(1 << 20)
+        , _verification_pool(_ios, workers) {
+    _tcp_ingress_master_face = std::make_shared<TcpMasterFace>(_ios, max_connection, local_port);
+    _udp_ingress_master_face = std::make_shared<UdpMasterFace>(_ios, max_connection, local_port);
+    _unix_ingress_master_face = std::make_shared<UnixMasterFace>(_ios, max_connection, UnixMasterFace::getSocketPath(name));
+    _shm_ingress_master_face = std::make_shared<ShmMasterFace>(_ios, max_connection, ShmMasterFace::getSocketPath(name));
 }
 
 void SignatureVerifier::run() {
     commandRead();
+    _tcp_ingress_master_face->setCongestionCallback(boost::bind(&SignatureVerifier::onFaceCongestion, this, _1, _2));
     _tcp_ingress_master_face->listen(boost::bind(&SignatureVerifier::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&SignatureVerifier::onIngressInterest, this, _1, _2),
                                      boost::bind(&SignatureVerifier::onIngressData, this, _1, _2),
                                      boost::bind(&SignatureVerifier::onMasterFaceError, this, _1, _2));
+    _udp_ingress_master_face->setCongestionCallback(boost::bind(&SignatureVerifier::onFaceCongestion, this, _1, _2));
     _udp_ingress_master_face->listen(boost::bind(&SignatureVerifier::onMasterFaceNotification, this, _1, _2),
                                      boost::bind(&SignatureVerifier::onIngressInterest, this, _1, _2),
                                      boost::bind(&SignatureVerifier::onIngressData, this, _1, _2),
                                      boost::bind(&SignatureVerifier::onMasterFaceError, this, _1, _2));
+    _unix_ingress_master_face->setCongestionCallback(boost::bind(&SignatureVerifier::onFaceCongestion, this, _1, _2));
+    _unix_ingress_master_face->listen(boost::bind(&SignatureVerifier::onMasterFaceNotification, this, _1, _2),
+                                      boost::bind(&SignatureVerifier::onIngressInterest, this, _1, _2),
+                                      boost::bind(&SignatureVerifier::onIngressData, this, _1, _2),
+                                      boost::bind(&SignatureVerifier::onMasterFaceError, this, _1, _2));
+    _shm_ingress_master_face->setCongestionCallback(boost::bind(&SignatureVerifier::onFaceCongestion, this, _1, _2));
+    _shm_ingress_master_face->listen(boost::bind(&SignatureVerifier::onMasterFaceNotification, this, _1, _2),
+                                     boost::bind(&SignatureVerifier::onIngressInterest, this, _1, _2),
+                                     boost::bind(&SignatureVerifier::onIngressData, this, _1, _2),
+                                     boost::bind(&SignatureVerifier::onMasterFaceError, this, _1, _2));
 }
 
 void SignatureVerifier::onIngressInterest(const std::shared_ptr<Face> &face, const ndn::Interest &interest) {
@@ -45,71 +66,139 @@ void SignatureVerifier::onIngressInterest(const std::shared_ptr<Face> &face, con
 }
 
 void SignatureVerifier::onIngressData(const std::shared_ptr<Face> &face, const ndn::Data &data) {
-    if (data.getSignature().getType() != ndn::tlv::SignatureTypeValue::DigestSha256) {
-        auto it = _pkeys.find(data.getSignature().getKeyLocator().getName());
-        if (it != _pkeys.end()) {
-            int result = verify(data.wireEncode().value(),
-                                data.wireEncode().value_size() - data.getSignature().getValue().size(),
-                                data.getSignature().getValue().value(), data.getSignature().getValue().value_size(),
-                                it->second);
-            if (result > 0) {
-                if (_report_enable) {
-                    _invalid_signature_packet_names.emplace(data.getName().toUri());
-                }
-                if (!_drop) {
-                    for (const auto &egress_face : _egress_faces) {
-                        egress_face->send(data);
-                    }
-                }
-            } else {
-                for (const auto &egress_face : _egress_faces) {
-                    egress_face->send(data);
-                }
-            }
-        } else if (!_no_key_drop) {
-            for (const auto &egress_face : _egress_faces) {
-                egress_face->send(data);
-            }
-        }
-    } else if (!_unsigned_drop) {
-        for (const auto &egress_face : _egress_faces) {
-            egress_face->send(data);
-        }
-    }
+    processData(face, data, true);
 }
 
 void SignatureVerifier::onEgressInterest(const std::shared_ptr<Face> &face, const ndn::Interest &interest) {
     _tcp_ingress_master_face->sendToAllFaces(interest);
     _udp_ingress_master_face->sendToAllFaces(interest);
+    _unix_ingress_master_face->sendToAllFaces(interest);
+    _shm_ingress_master_face->sendToAllFaces(interest);
 }
 
 void SignatureVerifier::onEgressData(const std::shared_ptr<Face> &face, const ndn::Data &data) {
-    if (data.getSignature().getType() != ndn::tlv::SignatureTypeValue::DigestSha256) {
-        auto it = _pkeys.find(data.getSignature().getKeyLocator().getName());
-        if (it != _pkeys.end()) {
-            int result = verify(data.wireEncode().value(),
-                                data.wireEncode().value_size() - data.getSignature().getValue().size(),
-                                data.getSignature().getValue().value(), data.getSignature().getValue().value_size(),
-                                it->second);
-            if (result > 0) {
-                if (_report_enable) {
-                    _invalid_signature_packet_names.emplace(data.getName().toUri());
-                }
-                if (!_drop) {
-                    _tcp_ingress_master_face->sendToAllFaces(data);
-                    _udp_ingress_master_face->sendToAllFaces(data);
-                }
-            } else {
-                _tcp_ingress_master_face->sendToAllFaces(data);
-                _udp_ingress_master_face->sendToAllFaces(data);
-            }
-        } else if (!_no_key_drop) {
-            _tcp_ingress_master_face->sendToAllFaces(data);
-            _udp_ingress_master_face->sendToAllFaces(data);
+    processData(face, data, false);
+}
+
+static int verifyWire(const ndn::Block &wire, size_t signed_size, const ndn::Block &signature_value, uint32_t type,
+                      const std::shared_ptr<KeyVerifier> &key, size_t context_index) {
+    return key->verify(type, wire.value(), signed_size, signature_value.value(), signature_value.value_size(), context_index);
+}
+
+void SignatureVerifier::processData(const std::shared_ptr<Face> &face, const ndn::Data &data, bool from_ingress) {
+    auto &sequence = _sequences[face->getFaceId()];
+    uint32_t type = data.getSignature().getType();
+    if (_manifest_store.covers(data)) {
+        completeData(sequence, data, from_ingress, true);
+        return;
+    }
+    if (type == ndn::tlv::SignatureTypeValue::DigestSha256 && _unsigned_drop) {
+        completeData(sequence, data, from_ingress, false);
+        return;
+    }
+    const ndn::Block &wire = data.wireEncode();
+    const ndn::Block &signature_value = data.getSignature().getValue();
+    size_t signed_size = wire.value_size() - signature_value.size();
+    if (type == ndn::tlv::SignatureTypeValue::DigestSha256) {
+        // no key involved, hashing inline is cheaper than a round trip through the workers
+        int result = KeyVerifier::verifyDigest(wire.value(), signed_size, signature_value.value(), signature_value.value_size());
+        completeData(sequence, data, from_ingress, checkResult(result, data));
+        return;
+    }
+    auto it = _pkeys.find(data.getSignature().getKeyLocator().getName());
+    if (it == _pkeys.end()) {
+        completeData(sequence, data, from_ingress, !_no_key_drop);
+        return;
+    }
+    if (!_sampling_policy.sample(it->first, SamplingPolicy::Clock::now())) {
+        completeData(sequence, data, from_ingress, true);
+        return;
+    }
+    VerifyCache::Key cache_key;
+    bool cacheable = _verify_cache.getSize() > 0 && VerifyCache::makeKey(data.getFullName(), it->first, cache_key);
+    int result;
+    if (cacheable && _verify_cache.get(cache_key, result)) {
+        completeData(sequence, data, from_ingress, checkResult(result, data));
+    } else if (_verification_pool.getWorkers() > 0) {
+        // the Block copies share the packet buffer, so the workers do not need to copy the packet
+        uint64_t sequence_number = sequence.head + sequence.slots.size();
+        sequence.slots.push_back({data, from_ingress, false, false});
+        _verification_pool.submit(boost::bind(&verifyWire, wire, signed_size, signature_value, type, it->second, _1),
+                                  boost::bind(&SignatureVerifier::onDataVerified, this, face->getFaceId(), sequence_number, it->second, _1));
+    } else {
+        // the last context of each key is reserved to the packet thread
+        result = verifyWire(wire, signed_size, signature_value, type, it->second, _verification_pool.getWorkers());
+        if (cacheable) {
+            _verify_cache.insert(cache_key, result);
+        }
+        completeData(sequence, data, from_ingress, checkResult(result, data));
+    }
+}
+
+void SignatureVerifier::completeData(DataSequence &sequence, const ndn::Data &data, bool from_ingress, bool forward) {
+    if (sequence.slots.empty()) {
+        ++sequence.head;
+        if (forward) {
+            forwardData(data, from_ingress);
+        }
+    } else {
+        sequence.slots.push_back({data, from_ingress, true, forward});
+    }
+}
+
+void SignatureVerifier::onDataVerified(size_t face_id, uint64_t sequence_number, const std::shared_ptr<KeyVerifier> &key, int result) {
+    auto it = _sequences.find(face_id);
+    if (it == _sequences.end() || sequence_number < it->second.head) {
+        // face closed while the Data was verified
+        return;
+    }
+    auto &sequence = it->second;
+    auto &slot = sequence.slots[sequence_number - sequence.head];
+    slot.done = true;
+    slot.forward = checkResult(result, slot.data);
+    const auto &key_name = slot.data.getSignature().getKeyLocator().getName();
+    auto key_it = _pkeys.find(key_name);
+    VerifyCache::Key cache_key;
+    // do not cache a result obtained with a key removed or replaced in the meantime
+    if (key_it != _pkeys.end() && key_it->second == key && _verify_cache.getSize() > 0
+        && VerifyCache::makeKey(slot.data.getFullName(), key_name, cache_key)) {
+        _verify_cache.insert(cache_key, result);
+    }
+    while (!sequence.slots.empty() && sequence.slots.front().done) {
+        if (sequence.slots.front().forward) {
+            forwardData(sequence.slots.front().data, sequence.slots.front().from_ingress);
+        }
+        sequence.slots.pop_front();
+        ++sequence.head;
+    }
+}
+
+bool SignatureVerifier::checkResult(int result, const ndn::Data &data) {
+    if (result > 0) {
+        if (_report_enable) {
+            _invalid_signature_packet_names.emplace(data.getName().toUri());
+        }
+        if (data.getSignature().getType() != ndn::tlv::SignatureTypeValue::DigestSha256) {
+            _sampling_policy.onInvalidSignature(data.getSignature().getKeyLocator().getName(), SamplingPolicy::Clock::now());
         }
-    } else if (!_unsigned_drop) {
+        return !_drop;
+    }
+    if (ManifestStore::isManifest(data) && data.getSignature().getType() != ndn::tlv::SignatureTypeValue::DigestSha256) {
+        _manifest_store.insert(data);
+    }
+    return true;
+}
+
+void SignatureVerifier::forwardData(const ndn::Data &data, bool from_ingress) {
+    if (from_ingress) {
+        for (const auto &egress_face : _egress_faces) {
+            egress_face->send(data);
+        }
+    } else {
         _tcp_ingress_master_face->sendToAllFaces(data);
         _udp_ingress_master_face->sendToAllFaces(data);
+        _unix_ingress_master_face->sendToAllFaces(data);
+        _shm_ingress_master_face->sendToAllFaces(data);
     }
 }
 
@@ -126,12 +215,14 @@ void SignatureVerifier::onMasterFaceError(const std::shared_ptr<MasterFace> &mas
        << master_face->getUnderlyingProtocol() << " master face with ID = " << master_face->getMasterFaceId()
        << " can't process normally";
     logger::log(logger::ERROR, ss.str());
+    _sequences.erase(face->getFaceId());
 }
 
 void SignatureVerifier::onFaceError(const std::shared_ptr<Face> &face) {
     std::stringstream ss;
     ss << face->getUnderlyingProtocol() << " face with ID = " << face->getFaceId() << " can't process normally";
     logger::log(logger::ERROR, ss.str());
+    _sequences.erase(face->getFaceId());
     for (auto& egress_face : _egress_faces) {
         if(egress_face == face) {
             std::swap(egress_face, _egress_faces.back());
@@ -141,6 +232,22 @@ void SignatureVerifier::onFaceError(const std::shared_ptr<Face> &face) {
     }
 }
 
+void SignatureVerifier::onFaceCongestion(const std::shared_ptr<Face> &face, bool congested) {
+    // only reported to a manager, the sender of the last command may be long gone
+    if (_manager_endpoint.address() == boost::asio::ip::address_v4::any() || _manager_endpoint.port() == 0) {
+        return;
+    }
+    TxQueueStats stats = face->getTxQueueStats();
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"report", "action":"face_congestion", "face_id":)" << face->getFaceId()
+       << R"(, "congested":)" << (congested ? "true" : "false") << R"(, "queued_packets":)" << stats.packets
+       << R"(, "queued_bytes":)" << stats.bytes << R"(, "dropped_packets":)" << stats.dropped_packets
+       << R"(, "dropped_bytes":)" << stats.dropped_bytes << "}";
+    // from the packet path, a failed report must not throw out of the handler
+    boost::system::error_code err;
+    _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint, 0, err);
+}
+
 void SignatureVerifier::commandRead() {
     _command_socket.async_receive_from(boost::asio::buffer(_command_buffer, 65536), _remote_command_endpoint,
                                        boost::bind(&SignatureVerifier::commandReadHandler, this, _1, _2));
@@ -153,6 +260,8 @@ void SignatureVerifier::commandReadHandler(const boost::system::error_code &err,
         DEL_FACE,
         ADD_KEYS,
         DEL_KEYS,
+        ADD_SAMPLING_RATES,
+        DEL_SAMPLING_RATES,
         LIST
     };
 
@@ -162,6 +271,8 @@ void SignatureVerifier::commandReadHandler(const boost::system::error_code &err,
             {"del_face", DEL_FACE},
             {"add_keys", ADD_KEYS},
             {"del_keys", DEL_KEYS},
+            {"add_sampling_rates", ADD_SAMPLING_RATES},
+            {"del_sampling_rates", DEL_SAMPLING_RATES},
             {"list", LIST},
     };
 
@@ -189,6 +300,12 @@ void SignatureVerifier::commandReadHandler(const boost::system::error_code &err,
                             case DEL_KEYS:
                                 commandDelKeys(document);
                                 break;
+                            case ADD_SAMPLING_RATES:
+                                commandAddSamplingRates(document);
+                                break;
+                            case DEL_SAMPLING_RATES:
+                                commandDelSamplingRates(document);
+                                break;
                             case LIST:
                                 commandList(document);
                         }
@@ -277,6 +394,50 @@ void SignatureVerifier::commandEditConfig(const rapidjson::Document &document) {
             changes.emplace_back("unsigned_drop");
         }
     }
+    if (document.HasMember("verify_cache_size") && document["verify_cache_size"].IsUint()) {
+        bool has_change = false;
+        size_t verify_cache_size = document["verify_cache_size"].GetUint();
+        if (_verify_cache.getSize() != verify_cache_size) {
+            _verify_cache.setSize(verify_cache_size);
+            has_change = true;
+        }
+        if (has_change) {
+            changes.emplace_back("verify_cache_size");
+        }
+    }
+    if (document.HasMember("manifest_store_size") && document["manifest_store_size"].IsUint()) {
+        bool has_change = false;
+        size_t manifest_store_size = document["manifest_store_size"].GetUint();
+        if (_manifest_store.getSize() != manifest_store_size) {
+            _manifest_store.setSize(manifest_store_size);
+            has_change = true;
+        }
+        if (has_change) {
+            changes.emplace_back("manifest_store_size");
+        }
+    }
+    if (document.HasMember("sampling_rate") && document["sampling_rate"].IsNumber()) {
+        bool has_change = false;
+        double sampling_rate = document["sampling_rate"].GetDouble();
+        if (_sampling_policy.getDefaultRate() != sampling_rate) {
+            _sampling_policy.setDefaultRate(sampling_rate);
+            has_change = true;
+        }
+        if (has_change) {
+            changes.emplace_back("sampling_rate");
+        }
+    }
+    if (document.HasMember("sampling_half_life") && document["sampling_half_life"].IsUint()) {
+        bool has_change = false;
+        std::chrono::milliseconds sampling_half_life(document["sampling_half_life"].GetUint());
+        if (_sampling_policy.getHalfLife() != sampling_half_life) {
+            _sampling_policy.setHalfLife(sampling_half_life);
+            has_change = true;
+        }
+        if (has_change) {
+            changes.emplace_back("sampling_half_life");
+        }
+    }
 
     std::stringstream ss;
     ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"edit_config", "changes":[)";
@@ -297,26 +458,70 @@ void SignatureVerifier::commandAddFace(const rapidjson::Document &document) {
     enum layer_type {
         TCP,
         UDP,
+        UNIX,
+        SHM,
     };
 
     static const std::unordered_map<std::string, layer_type> LAYERS = {
             {"tcp", TCP},
             {"udp", UDP},
+            {"unix", UNIX},
+            {"shm", SHM},
+    };
+
+    static const std::unordered_map<std::string, DropPolicy> DROP_POLICIES = {
+            {"tail_drop", DropPolicy::TAIL_DROP},
+            {"head_drop", DropPolicy::HEAD_DROP},
+            {"priority_drop", DropPolicy::PRIORITY_DROP},
     };
 
-    if (document.HasMember("layer") && document.HasMember("address") && document.HasMember("port")
-        && document["layer"].IsString() && document["address"].IsString() && document["port"].IsUint()) {
+    if (document.HasMember("layer") && document.HasMember("address") && document["layer"].IsString() && document["address"].IsString()) {
+        // the address of a unix or shm face is the socket path of the module, only tcp and udp need a port
+        bool has_port = document.HasMember("port") && document["port"].IsUint();
         auto it = LAYERS.find(document["layer"].GetString());
-        if (it != LAYERS.end()) {
+        if (it != LAYERS.end() && (has_port || it->second == UNIX || it->second == SHM)) {
             std::shared_ptr<Face> face;
             switch (it->second) {
                 case TCP:
                     face = std::make_shared<TcpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
                     break;
-                case UDP:
-                    face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                case UDP: {
+                    auto udp_face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                    if (document.HasMember("mtu") && document["mtu"].IsUint()) {
+                        udp_face->setMtu(document["mtu"].GetUint());
+                    }
+                    if (document.HasMember("aggregation") && document["aggregation"].IsBool()) {
+                        // the delay is given in microseconds
+                        uint32_t delay = document.HasMember("aggregation_delay") && document["aggregation_delay"].IsUint()
+                                         ? document["aggregation_delay"].GetUint() : 0;
+                        udp_face->setAggregation(document["aggregation"].GetBool(), boost::posix_time::microseconds(delay));
+                    }
+                    face = udp_face;
+                    break;
+                }
+                case UNIX:
+                    face = std::make_shared<UnixFace>(_ios, document["address"].GetString());
+                    break;
+                case SHM:
+                    face = std::make_shared<ShmFace>(_ios, document["address"].GetString());
                     break;
             }
+            // optional bounds of the transmit queue of the face
+            TxQueueLimits limits;
+            if (document.HasMember("queue_packets") && document["queue_packets"].IsUint()) {
+                limits.packets = document["queue_packets"].GetUint();
+            }
+            if (document.HasMember("queue_bytes") && document["queue_bytes"].IsUint()) {
+                limits.bytes = document["queue_bytes"].GetUint();
+            }
+            if (document.HasMember("drop_policy") && document["drop_policy"].IsString()) {
+                auto policy = DROP_POLICIES.find(document["drop_policy"].GetString());
+                if (policy != DROP_POLICIES.end()) {
+                    limits.policy = policy->second;
+                }
+            }
+            face->setTxQueueLimits(limits);
+            face->setCongestionCallback(boost::bind(&SignatureVerifier::onFaceCongestion, this, _1, _2));
             face->open(boost::bind(&SignatureVerifier::onEgressInterest, this, _1, _2),
                        boost::bind(&SignatureVerifier::onEgressData, this, _1, _2),
                        boost::bind(&SignatureVerifier::onFaceError, this, _1));
@@ -364,10 +569,16 @@ void SignatureVerifier::commandAddKeys(const rapidjson::Document &document) {
                         auto it = _pkeys.find(key_name);
                         if (it == _pkeys.end()) {
                             std::stringstream ss1;
-                            std::string blob = key_info[2].GetString();
-                            EVP_PKEY *pkey = PEM_read_bio_PUBKEY(BIO_new_mem_buf(blob.c_str(), blob.size()), NULL, NULL, NULL);
-                            if (pkey != nullptr) {
-                                _pkeys.emplace(key_name, pkey);
+                            std::string type = key_info[1].GetString();
+                            std::shared_ptr<KeyVerifier> key_verifier;
+                            if (type == "HMAC") {
+                                key_verifier = KeyVerifier::fromHmacSecret(key_info[2].GetString(), _verification_pool.getWorkers() + 1);
+                            } else {
+                                // RSA and ECDSA, the algorithm is taken from the PEM encoded public key
+                                key_verifier = KeyVerifier::fromPem(key_info[2].GetString(), _verification_pool.getWorkers() + 1);
+                            }
+                            if (key_verifier) {
+                                _pkeys.emplace(key_name, key_verifier);
                                 ss1 << "key " << key_name << " added by manager";
                                 status.emplace_back("success");
                             } else {
@@ -408,9 +619,11 @@ void SignatureVerifier::commandDelKeys(const rapidjson::Document &document) {
                     ndn::Name key_name(key.GetString());
                     auto it = _pkeys.find(key_name);
                     if (it != _pkeys.end()) {
-                        EVP_PKEY *pkey = it->second;
-                        _pkeys.erase(key_name);
-                        EVP_PKEY_free(pkey);
+                        // verifications in progress keep their own reference on the key
+                        _pkeys.erase(it);
+                        _verify_cache.clear();
+                        _sampling_policy.removeKey(key_name);
+                        _manifest_store.clear();
                         std::stringstream ss1;
                         ss1 << "key with name " << key_name << " removed by manager";
                         logger::log(logger::INFO, ss1.str());
@@ -423,11 +636,76 @@ void SignatureVerifier::commandDelKeys(const rapidjson::Document &document) {
     }
 }
 
+void SignatureVerifier::commandAddSamplingRates(const rapidjson::Document &document) {
+    if (document.HasMember("rates") && document["rates"].IsArray()) {
+        std::stringstream ss;
+        ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"add_sampling_rates", )";
+        auto &&rates = document["rates"].GetArray();
+        if (rates.Empty()) {
+            ss << R"("status":"fail", "reason":"empty prefix list"})";
+        } else {
+            std::vector<std::string> status;
+            for (auto &rate : rates) {
+                if (rate.IsArray() && rate.Size() == 2 && rate[0].IsString() && rate[1].IsNumber()) {
+                    _sampling_policy.setPrefixRate(ndn::Name(rate[0].GetString()), rate[1].GetDouble());
+                    status.emplace_back("success");
+                } else {
+                    status.emplace_back("fail");
+                }
+            }
+            ss << R"("status":[)";
+            bool first = true;
+            for(const auto& s : status) {
+                if (first) {
+                    first = false;
+                } else {
+                    ss << ",";
+                }
+                ss << '"' << s << '"';
+            }
+            ss << "]}";
+        }
+        _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+    }
+}
+
+void SignatureVerifier::commandDelSamplingRates(const rapidjson::Document &document) {
+    if (document.HasMember("prefixes") && document["prefixes"].IsArray()) {
+        std::stringstream ss;
+        ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint() << R"(, "action":"del_sampling_rates", )";
+        auto &&prefixes = document["prefixes"].GetArray();
+        if (prefixes.Empty()) {
+            ss << R"("status":"fail", "reason":"empty prefix list"})";
+        } else {
+            std::vector<std::string> status;
+            for (auto &prefix : prefixes) {
+                status.emplace_back(prefix.IsString() && _sampling_policy.removePrefixRate(ndn::Name(prefix.GetString())) ? "success" : "fail");
+            }
+            ss << R"("status":[)";
+            bool first = true;
+            for(const auto& s : status) {
+                if (first) {
+                    first = false;
+                } else {
+                    ss << ",";
+                }
+                ss << '"' << s << '"';
+            }
+            ss << "]}";
+        }
+        _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
+    }
+}
+
 void SignatureVerifier::commandList(const rapidjson::Document &document) {
     std::stringstream ss;
     ss << R"({"name":")" << _name << R"(", "type":"reply", "id":)" << document["id"].GetUint()
        << R"(, "action":"list", "manager_address":")" << _manager_endpoint.address() << R"(", "manager_port":)" << _manager_endpoint.port()
-       << R"(, "drop":)" << _drop << R"(, "no_key_drop":)" << _no_key_drop << R"(, "unsigned_drop":)" << _unsigned_drop << "}";
+       << R"(, "drop":)" << _drop << R"(, "no_key_drop":)" << _no_key_drop << R"(, "unsigned_drop":)" << _unsigned_drop
+       << R"(, "workers":)" << _verification_pool.getWorkers() << R"(, "pending_verifications":)" << _verification_pool.getPending()
+       << R"(, "verify_cache_size":)" << _verify_cache.getSize() << R"(, "sampling_rate":)" << _sampling_policy.getDefaultRate()
+       << R"(, "sampling_half_life":)" << _sampling_policy.getHalfLife().count()
+       << R"(, "manifest_store_size":)" << _manifest_store.getSize() << "}";
     _command_socket.send_to(boost::asio::buffer(ss.str()), _remote_command_endpoint);
 }
 
@@ -457,50 +735,32 @@ void SignatureVerifier::commandReport(const boost::system::error_code &err) {
             ss << "]}";
             _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint);
         }
+        size_t lookups = _verify_cache.getHits() + _verify_cache.getMisses();
+        if (lookups > 0 && _manager_endpoint.address() != boost::asio::ip::address_v4::any() && _manager_endpoint.port() != 0) {
+            std::stringstream ss;
+            ss << R"({"type":"report", "name":")" << _name << R"(", "action":"verify_cache", "hits":)" << _verify_cache.getHits()
+               << R"(, "misses":)" << _verify_cache.getMisses() << R"(, "hit_rate":)" << (double)_verify_cache.getHits() / lookups
+               << R"(, "entries":)" << _verify_cache.getEntries() << "}";
+            _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint);
+        }
+        _verify_cache.resetCounters();
+        if ((_manifest_store.getManifests() > 0 || _manifest_store.getCovered() > 0)
+            && _manager_endpoint.address() != boost::asio::ip::address_v4::any() && _manager_endpoint.port() != 0) {
+            std::stringstream ss;
+            ss << R"({"type":"report", "name":")" << _name << R"(", "action":"manifest", "covered":)" << _manifest_store.getCovered()
+               << R"(, "manifests":)" << _manifest_store.getManifests() << R"(, "digests":)" << _manifest_store.getDigests() << "}";
+            _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint);
+        }
+        _manifest_store.resetCounters();
+        std::string sampling = _sampling_policy.reportToJSON(SamplingPolicy::Clock::now());
+        if (!sampling.empty() && _manager_endpoint.address() != boost::asio::ip::address_v4::any() && _manager_endpoint.port() != 0) {
+            std::stringstream ss;
+            ss << R"({"type":"report", "name":")" << _name << R"(", "action":"sampling", "keys":)" << sampling << "}";
+            _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint);
+        }
         if (_report_enable) {
             _report_timer.expires_from_now(_delay_between_report);
             _report_timer.async_wait(boost::bind(&SignatureVerifier::commandReport, this, _1));
         }
     }
 }
-
-// from openssl example
-int SignatureVerifier::verify(const unsigned char* msg, size_t mlen, const unsigned char* sig, size_t slen, EVP_PKEY* pkey) {
-    /* Returned to caller */
-    int result = -1;
-    if (!msg || !mlen || !sig || !slen || !pkey) {
-        //printf("a least one of the parameters is undefined\n");
-        return result;
-    }
-    EVP_MD_CTX *ctx = NULL;
-    do {
-        ctx = EVP_MD_CTX_create();
-        if (ctx == NULL) {
-            break; /* failed */
-        }
-        int rc = EVP_DigestInit_ex(ctx, EVP_sha256(), NULL);
-        if (rc != 1) {
-            break; /* failed */
-        }
-        rc = EVP_DigestVerifyInit(ctx, NULL, EVP_sha256(), NULL, pkey);
-        if (rc != 1) {
-            break; /* failed */
-        }
-        rc = EVP_DigestVerifyUpdate(ctx, msg, mlen);
-        if (rc != 1) {
-            break; /* failed */
-        }
-        /* Clear any errors for the call below */
-        ERR_clear_error();
-        rc = EVP_DigestVerifyFinal(ctx, sig, slen);
-        if (rc != 1) {
-            break; /* failed */
-        }
-        result = 0;
-    } while (0);
-    if (ctx) {
-        EVP_MD_CTX_destroy(ctx);
-        ctx = NULL;
-    }
-    return !!result;
-}
@@ -13,23 +13,45 @@
 #include <memory>
 #include <string>
 #include <queue>
+#include <deque>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "rapidjson/document.h"
 
 #include "module.h"
+#include "key_verifier.h"
+#include "verification_pool.h"
+#include "verify_cache.h"
+#include "sampling_policy.h"
+#include "manifest_store.h"
 #include "network/master_face.h"
 #include "network/face.h"
 #include "rapidjson/document.h"
 
 class SignatureVerifier : public Module {
 private:
+    // Data waiting for its verification or for older Data of the same face, forwarded in arrival order
+    struct PendingData {
+        ndn::Data data;
+        bool from_ingress;
+        bool done;
+        bool forward;
+    };
+
+    struct DataSequence {
+        uint64_t head = 0;
+        std::deque<PendingData> slots;
+    };
+
     const std::string _name;
 
     std::vector<std::shared_ptr<Face>> _egress_faces;
     std::shared_ptr<MasterFace> _tcp_ingress_master_face;
     std::shared_ptr<MasterFace> _udp_ingress_master_face;
+    std::shared_ptr<MasterFace> _unix_ingress_master_face;
+    std::shared_ptr<MasterFace> _shm_ingress_master_face;
 
     char _command_buffer[65536];
     boost::asio::ip::udp::socket _command_socket;
@@ -44,10 +66,16 @@ private:
     bool _no_key_drop = false;
     bool _unsigned_drop = false;
     std::set<std::string> _invalid_signature_packet_names;
-    std::map<ndn::Name, EVP_PKEY*> _pkeys;
+    std::map<ndn::Name, std::shared_ptr<KeyVerifier>> _pkeys;
+    VerifyCache _verify_cache;
+    SamplingPolicy _sampling_policy;
+    ManifestStore _manifest_store;
+
+    VerificationPool _verification_pool;
+    std::unordered_map<size_t, DataSequence> _sequences;
 
 public:
-    SignatureVerifier(const std::string &name, uint16_t local_port, uint16_t local_command_port);
+    SignatureVerifier(const std::string &name, uint16_t local_port, uint16_t local_command_port, size_t workers, size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION);
 
     ~SignatureVerifier() override = default;
 
@@ -62,12 +90,24 @@ private:
 
     void onEgressData(const std::shared_ptr<Face> &face, const ndn::Data &data);
 
+    void processData(const std::shared_ptr<Face> &face, const ndn::Data &data, bool from_ingress);
+
+    void completeData(DataSequence &sequence, const ndn::Data &data, bool from_ingress, bool forward);
+
+    void onDataVerified(size_t face_id, uint64_t sequence_number, const std::shared_ptr<KeyVerifier> &key, int result);
+
+    bool checkResult(int result, const ndn::Data &data);
+
+    void forwardData(const ndn::Data &data, bool from_ingress);
+
     void onMasterFaceNotification(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face> &face);
 
     void onMasterFaceError(const std::shared_ptr<MasterFace> &master_face, const std::shared_ptr<Face> &face);
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
@@ -82,9 +122,11 @@ private:
 
     void commandDelKeys(const rapidjson::Document &document);
 
+    void commandAddSamplingRates(const rapidjson::Document &document);
+
+    void commandDelSamplingRates(const rapidjson::Document &document);
+
     void commandList(const rapidjson::Document &document);
 
     void commandReport(const boost::system::error_code &err);
-
-    int verify(const unsigned char* msg, size_t mlen, const unsigned char* sig, size_t slen, EVP_PKEY* pkey);
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "verification_pool.h"
+
+#include <boost/bind.hpp>
+
+static thread_local size_t current_worker_index = 0;
+
+VerificationPool::VerificationPool(boost::asio::io_service &completion_ios, size_t workers)
+        : _completion_ios(completion_ios)
+        , _workers(workers)
+        , _ios(workers)
+        , _ios_work(_ios) {
+    for (size_t i = 0; i < _workers; ++i) {
+        _thread_pool.create_thread(boost::bind(&VerificationPool::runWorker, this, i));
+    }
+}
+
+VerificationPool::~VerificationPool() {
+    _ios.stop();
+    _thread_pool.join_all();
+}
+
+size_t VerificationPool::getWorkers() const {
+    return _workers;
+}
+
+size_t VerificationPool::getPending() const {
+    return _pending;
+}
+
+void VerificationPool::submit(const Task &task, const Completion &completion) {
+    ++_pending;
+    _ios.post(boost::bind(&VerificationPool::execute, this, task, completion));
+}
+
+void VerificationPool::runWorker(size_t worker_index) {
+    current_worker_index = worker_index;
+    _ios.run();
+}
+
+void VerificationPool::execute(const Task &task, const Completion &completion) {
+    int result = task(current_worker_index);
+    --_pending;
+    _completion_ios.post(boost::bind(completion, result));
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+
+#include <atomic>
+#include <functional>
+
+// Runs verification tasks on dedicated threads and posts their result back to the io_service of the module,
+// so faces and tables are still only touched by the packet processing thread.
+class VerificationPool {
+public:
+    using Task = std::function<int(size_t worker_index)>;
+    using Completion = std::function<void(int result)>;
+
+private:
+    boost::asio::io_service &_completion_ios;
+    size_t _workers;
+    boost::asio::io_service _ios;
+    boost::asio::io_service::work _ios_work;
+    boost::thread_group _thread_pool;
+    std::atomic<size_t> _pending {0};
+
+public:
+    VerificationPool(boost::asio::io_service &completion_ios, size_t workers);
+
+    ~VerificationPool();
+
+    size_t getWorkers() const;
+
+    size_t getPending() const;
+
+    void submit(const Task &task, const Completion &completion);
+
+private:
+    void runWorker(size_t worker_index);
+
+    void execute(const Task &task, const Completion &completion);
+};
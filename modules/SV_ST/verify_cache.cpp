@@ -0,0 +1,91 @@
+#include "verify_cache.h"
+
+#include <cstring>
+
+bool VerifyCache::Key::operator==(const Key &other) const {
+    return digest == other.digest && key_name == other.key_name;
+}
+
+size_t VerifyCache::KeyHash::operator()(const Key &key) const {
+    // the digest is already uniformly distributed, the key name only matters for equality
+    size_t hash;
+    std::memcpy(&hash, key.digest.data(), sizeof(hash));
+    return hash;
+}
+
+VerifyCache::VerifyCache(size_t size) : _max_size(size) {
+
+}
+
+bool VerifyCache::makeKey(const ndn::Name &full_name, const ndn::Name &key_name, Key &key) {
+    const auto &component = full_name.get(-1);
+    if (!component.isImplicitSha256Digest() || component.value_size() != key.digest.size()) {
+        return false;
+    }
+    std::memcpy(key.digest.data(), component.value(), key.digest.size());
+    key.key_name = key_name;
+    return true;
+}
+
+size_t VerifyCache::getSize() const {
+    return _max_size;
+}
+
+void VerifyCache::setSize(size_t size) {
+    _max_size = size;
+    while (_list.size() > _max_size) {
+        _list_index.erase(_list.back().first);
+        _list.pop_back();
+    }
+}
+
+size_t VerifyCache::getEntries() const {
+    return _list.size();
+}
+
+size_t VerifyCache::getHits() const {
+    return _hits;
+}
+
+size_t VerifyCache::getMisses() const {
+    return _misses;
+}
+
+void VerifyCache::resetCounters() {
+    _hits = 0;
+    _misses = 0;
+}
+
+void VerifyCache::clear() {
+    _list_index.clear();
+    _list.clear();
+}
+
+void VerifyCache::insert(const Key &key, int result) {
+    if (_max_size == 0) {
+        return;
+    }
+    auto it = _list_index.find(key);
+    if (it != _list_index.end()) {
+        it->second->second = result;
+        _list.splice(_list.begin(), _list, it->second);
+        return;
+    }
+    _list_index.emplace(key, _list.emplace(_list.begin(), key, result));
+    if (_list.size() > _max_size) {
+        _list_index.erase(_list.back().first);
+        _list.pop_back();
+    }
+}
+
+bool VerifyCache::get(const Key &key, int &result) {
+    auto it = _list_index.find(key);
+    if (it == _list_index.end()) {
+        ++_misses;
+        return false;
+    }
+    ++_hits;
+    _list.splice(_list.begin(), _list, it->second);
+    result = it->second->second;
+    return true;
+}
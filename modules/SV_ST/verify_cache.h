@@ -0,0 +1,58 @@
+#pragma once
+
+#include <ndn-cxx/name.hpp>
+
+#include <array>
+#include <list>
+#include <unordered_map>
+
+// LRU cache of verification results, keyed by the implicit SHA-256 digest of the Data and the name of the key
+// that verified it. A Data seen again costs its digest and one lookup instead of a public key operation.
+class VerifyCache {
+public:
+    struct Key {
+        std::array<uint8_t, 32> digest;
+        ndn::Name key_name;
+
+        bool operator==(const Key &other) const;
+    };
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    using Entry = std::pair<Key, int>;
+
+    size_t _max_size;
+    std::list<Entry> _list;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> _list_index;
+
+    size_t _hits = 0;
+    size_t _misses = 0;
+
+public:
+    explicit VerifyCache(size_t size);
+
+    ~VerifyCache() = default;
+
+    static bool makeKey(const ndn::Name &full_name, const ndn::Name &key_name, Key &key);
+
+    size_t getSize() const;
+
+    void setSize(size_t size);
+
+    size_t getEntries() const;
+
+    size_t getHits() const;
+
+    size_t getMisses() const;
+
+    void resetCounters();
+
+    void clear();
+
+    void insert(const Key &key, int result);
+
+    bool get(const Key &key, int &result);
+};
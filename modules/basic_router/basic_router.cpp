@@ -8,27 +8,45 @@
 #include "network/tcp_face.h"
 #include "network/udp_master_face.h"
 #include "network/udp_face.h"
+#include "network/unix_master_face.h"
+#include "network/unix_face.h"
+#include "network/shm_master_face.h"
+#include "network/shm_face.h"
 #include "log/logger.h"
 
-NameRouter::NameRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port)
+NameRouter::NameRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port, size_t max_connection)
         : Module(1)
         , _name(name)
         , _pit(250)
         , _command_socket(_ios, {{}, local_command_port}) {
-    _tcp_master_face = std::make_shared<TcpMasterFace>(_ios, 16, local_port);
-    _udp_master_face = std::make_shared<UdpMasterFace>(_ios, 16, local_port);
+    _tcp_master_face = std::make_shared<TcpMasterFace>(_ios, max_connection, local_port);
+    _udp_master_face = std::make_shared<UdpMasterFace>(_ios, max_connection, local_port);
+    _unix_master_face = std::make_shared<UnixMasterFace>(_ios, max_connection, UnixMasterFace::getSocketPath(name));
+    _shm_master_face = std::make_shared<ShmMasterFace>(_ios, max_connection, ShmMasterFace::getSocketPath(name));
 }
 
 void NameRouter::run() {
     commandRead();
+    _tcp_master_face->setCongestionCallback(boost::bind(&NameRouter::onFaceCongestion, this, _1, _2));
     _tcp_master_face->listen(boost::bind(&NameRouter::onMasterFaceNotification, this, _1, _2),
                                       boost::bind(&NameRouter::onInterest, this, _1, _2),
                                       boost::bind(&NameRouter::onData, this, _1, _2),
                                       boost::bind(&NameRouter::onMasterFaceError, this, _1, _2));
+    _udp_master_face->setCongestionCallback(boost::bind(&NameRouter::onFaceCongestion, this, _1, _2));
     _udp_master_face->listen(boost::bind(&NameRouter::onMasterFaceNotification, this, _1, _2),
                                       boost::bind(&NameRouter::onInterest, this, _1, _2),
                                       boost::bind(&NameRouter::onData, this, _1, _2),
                                       boost::bind(&NameRouter::onMasterFaceError, this, _1, _2));
+    _unix_master_face->setCongestionCallback(boost::bind(&NameRouter::onFaceCongestion, this, _1, _2));
+    _unix_master_face->listen(boost::bind(&NameRouter::onMasterFaceNotification, this, _1, _2),
+                              boost::bind(&NameRouter::onInterest, this, _1, _2),
+                              boost::bind(&NameRouter::onData, this, _1, _2),
+                              boost::bind(&NameRouter::onMasterFaceError, this, _1, _2));
+    _shm_master_face->setCongestionCallback(boost::bind(&NameRouter::onFaceCongestion, this, _1, _2));
+    _shm_master_face->listen(boost::bind(&NameRouter::onMasterFaceNotification, this, _1, _2),
+                             boost::bind(&NameRouter::onInterest, this, _1, _2),
+                             boost::bind(&NameRouter::onData, this, _1, _2),
+                             boost::bind(&NameRouter::onMasterFaceError, this, _1, _2));
 }
 
 void NameRouter::onInterest(const std::shared_ptr<Face> &consumer_face, const ndn::Interest &interest) {
@@ -143,6 +161,22 @@ void NameRouter::onFaceError(const std::shared_ptr<Face> &face) {
     logger::log(logger::ERROR, ss.str());
 }
 
+void NameRouter::onFaceCongestion(const std::shared_ptr<Face> &face, bool congested) {
+    // only reported to a manager, the sender of the last command may be long gone
+    if (_manager_endpoint.address() == boost::asio::ip::address_v4::any() || _manager_endpoint.port() == 0) {
+        return;
+    }
+    TxQueueStats stats = face->getTxQueueStats();
+    std::stringstream ss;
+    ss << R"({"name":")" << _name << R"(", "type":"report", "action":"face_congestion", "face_id":)" << face->getFaceId()
+       << R"(, "congested":)" << (congested ? "true" : "false") << R"(, "queued_packets":)" << stats.packets
+       << R"(, "queued_bytes":)" << stats.bytes << R"(, "dropped_packets":)" << stats.dropped_packets
+       << R"(, "dropped_bytes":)" << stats.dropped_bytes << "}";
+    // from the packet path, a failed report must not throw out of the handler
+    boost::system::error_code err;
+    _command_socket.send_to(boost::asio::buffer(ss.str()), _manager_endpoint, 0, err);
+}
+
 void NameRouter::commandRead() {
     _command_socket.async_receive_from(boost::asio::buffer(_command_buffer, 65536), _remote_command_endpoint,
                                        boost::bind(&NameRouter::commandReadHandler, this, _1, _2));
@@ -272,26 +306,70 @@ void NameRouter::commandAddFace(const rapidjson::Document &document) {
     enum layer_type {
         TCP,
         UDP,
+        UNIX,
+        SHM,
     };
 
     static const std::unordered_map<std::string, layer_type> LAYERS = {
             {"tcp", TCP},
             {"udp", UDP},
+            {"unix", UNIX},
+            {"shm", SHM},
     };
 
-    if (document.HasMember("layer") && document.HasMember("address") && document.HasMember("port")
-        && document["layer"].IsString() && document["address"].IsString() && document["port"].IsUint()) {
+    static const std::unordered_map<std::string, DropPolicy> DROP_POLICIES = {
+            {"tail_drop", DropPolicy::TAIL_DROP},
+            {"head_drop", DropPolicy::HEAD_DROP},
+            {"priority_drop", DropPolicy::PRIORITY_DROP},
+    };
+
+    if (document.HasMember("layer") && document.HasMember("address") && document["layer"].IsString() && document["address"].IsString()) {
+        // the address of a unix or shm face is the socket path of the module, only tcp and udp need a port
+        bool has_port = document.HasMember("port") && document["port"].IsUint();
         auto it = LAYERS.find(document["layer"].GetString());
-        if (it != LAYERS.end()) {
+        if (it != LAYERS.end() && (has_port || it->second == UNIX || it->second == SHM)) {
             std::shared_ptr<Face> face;
             switch (it->second) {
                 case TCP:
                     face = std::make_shared<TcpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
                     break;
-                case UDP:
-                    face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                case UDP: {
+                    auto udp_face = std::make_shared<UdpFace>(_ios, document["address"].GetString(), document["port"].GetUint());
+                    if (document.HasMember("mtu") && document["mtu"].IsUint()) {
+                        udp_face->setMtu(document["mtu"].GetUint());
+                    }
+                    if (document.HasMember("aggregation") && document["aggregation"].IsBool()) {
+                        // the delay is given in microseconds
+                        uint32_t delay = document.HasMember("aggregation_delay") && document["aggregation_delay"].IsUint()
+                                         ? document["aggregation_delay"].GetUint() : 0;
+                        udp_face->setAggregation(document["aggregation"].GetBool(), boost::posix_time::microseconds(delay));
+                    }
+                    face = udp_face;
                     break;
+                }
+                case UNIX:
+                    face = std::make_shared<UnixFace>(_ios, document["address"].GetString());
+                    break;
+                case SHM:
+                    face = std::make_shared<ShmFace>(_ios, document["address"].GetString());
+                    break;
+            }
+            // optional bounds of the transmit queue of the face
+            TxQueueLimits limits;
+            if (document.HasMember("queue_packets") && document["queue_packets"].IsUint()) {
+                limits.packets = document["queue_packets"].GetUint();
+            }
+            if (document.HasMember("queue_bytes") && document["queue_bytes"].IsUint()) {
+                limits.bytes = document["queue_bytes"].GetUint();
+            }
+            if (document.HasMember("drop_policy") && document["drop_policy"].IsString()) {
+                auto policy = DROP_POLICIES.find(document["drop_policy"].GetString());
+                if (policy != DROP_POLICIES.end()) {
+                    limits.policy = policy->second;
+                }
             }
+            face->setTxQueueLimits(limits);
+            face->setCongestionCallback(boost::bind(&NameRouter::onFaceCongestion, this, _1, _2));
             face->open(boost::bind(&NameRouter::onInterest, this, _1, _2),
                        boost::bind(&NameRouter::onData, this, _1, _2),
                        boost::bind(&NameRouter::onFaceError, this, _1));
@@ -39,9 +39,11 @@ class NameRouter : public Module {
     std::unordered_map<size_t, std::shared_ptr<Face>> _egress_faces;
     std::shared_ptr<MasterFace> _tcp_master_face;
     std::shared_ptr<MasterFace> _udp_master_face;
+    std::shared_ptr<MasterFace> _unix_master_face;
+    std::shared_ptr<MasterFace> _shm_master_face;
 
 public:
-    NameRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port);
+    NameRouter(const std::string &name, uint16_t local_port, uint16_t local_command_port, size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION);
 
     ~NameRouter() override = default;
 
@@ -65,6 +67,8 @@ public:
 
     void onFaceError(const std::shared_ptr<Face> &face);
 
+    void onFaceCongestion(const std::shared_ptr<Face> &face, bool congested);
+
     void commandRead();
 
     void commandReadHandler(const boost::system::error_code &err, size_t bytes_transferred);
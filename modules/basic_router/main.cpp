@@ -13,6 +13,7 @@ int main(int argc, char *argv[]) {
     std::string name = "";
     uint16_t local_port = 0;
     uint16_t local_command_port = 0;
+    size_t max_connection = MasterFace::DEFAULT_MAX_CONNECTION;
 
     char flags = 0;
     for (int i = 1; i < argc; i += 2) {
@@ -29,6 +30,10 @@ int main(int argc, char *argv[]) {
                 local_command_port = std::atoi(argv[i + 1]);
                 flags |= 0x4;
                 break;
+            case 'm':
+                // optional, faces accepted per master face
+                max_connection = std::atoi(argv[i + 1]);
+                break;
             case 'h':
             default:
                 exit(0);
@@ -45,7 +50,7 @@ int main(int argc, char *argv[]) {
     logger::isTee(true);
     logger::setMinimalLogLevel(logger::INFO);
 
-    NameRouter nameRouter(name, local_port, local_command_port);
+    NameRouter nameRouter(name, local_port, local_command_port, max_connection);
     nameRouter.start();
 
     signal(SIGINT, signal_handler);
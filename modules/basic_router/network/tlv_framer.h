@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Cuts the byte stream of a stream face into NDN packets. The stream is read into a buffer that only moves its read
+// offset as packets are extracted: it rewinds for free once drained and the bytes of a partial packet are moved to
+// the front only when the free tail can't hold a whole packet, instead of after every read. Bytes that don't start
+// an Interest or a Data, or a packet larger than max_packet_size, are skipped up to the next candidate type byte.
+// Used from the strand of a single face.
+class TlvFramer {
+private:
+    std::unique_ptr<char[]> _buffer;
+    size_t _capacity;
+    size_t _max_packet_size;
+    size_t _begin = 0;
+    size_t _end = 0;
+
+public:
+    // capacity should be at least twice max_packet_size so that rewinding rarely moves any byte
+    TlvFramer(size_t capacity, size_t max_packet_size);
+
+    // the whole buffer, it never moves so it can be registered with the kernel
+    char* getBuffer();
+
+    size_t getCapacity() const;
+
+    // where the next bytes of the stream go, getFreeSize() bytes at most
+    char* prepare();
+
+    size_t getFreeSize() const;
+
+    void commit(size_t size);
+
+    // calls sink(packet, size) on each complete packet buffered, packet is valid until the next prepare(), and
+    // returns how many there were
+    template<typename Sink>
+    size_t extract(Sink &&sink) {
+        size_t count = 0;
+        const char *it = _buffer.get() + _begin;
+        const char *end = _buffer.get() + _end;
+        while (it < end) {
+            if (!isType(*it)) {
+                it = findType(it + 1, end);
+                continue;
+            }
+            uint64_t size;
+            if (!readSize(it, end, size)) {
+                break;
+            }
+            if (size > _max_packet_size) {
+                ++it;
+                continue;
+            }
+            if (size > (uint64_t)(end - it)) {
+                break;
+            }
+            sink(it, (size_t)size);
+            it += size;
+            ++count;
+        }
+        _begin = it - _buffer.get();
+        if (_begin == _end) {
+            _begin = 0;
+            _end = 0;
+        }
+        return count;
+    }
+
+private:
+    static bool isType(char byte) {
+        return byte == 0x05 || byte == 0x06;
+    }
+
+    // first candidate type byte in [it, end), end if none
+    static const char* findType(const char *it, const char *end);
+
+    // total size of the TLV at it, false if its header isn't complete yet
+    static bool readSize(const char *it, const char *end, uint64_t &size) {
+        if (end - it >= 2 && (uint8_t)it[1] < 0xFD) {
+            size = 2 + (uint8_t)it[1];
+            return true;
+        }
+        return readLongSize(it, end, size);
+    }
+
+    static bool readLongSize(const char *it, const char *end, uint64_t &size);
+};
@@ -9,7 +9,8 @@ UdpFace::UdpFace(boost::asio::io_service &ios, const std::string &host, uint16_t
         , _endpoint(boost::asio::ip::address::from_string(host), port)
         , _socket(ios, boost::asio::ip::udp::v4())
         , _strand(ios)
-        , _timer(ios) {
+        , _timer(ios)
+        , _flush_timer(ios) {
 }
 
 UdpFace::UdpFace(boost::asio::io_service &ios, const boost::asio::ip::udp::endpoint &endpoint)
@@ -17,7 +18,16 @@ UdpFace::UdpFace(boost::asio::io_service &ios, const boost::asio::ip::udp::endpo
         , _endpoint(endpoint)
         , _socket(ios, boost::asio::ip::udp::v4())
         , _strand(ios)
-        , _timer(ios) {
+        , _timer(ios)
+        , _flush_timer(ios) {
+}
+
+void UdpFace::setTxQueueLimits(const TxQueueLimits &limits) {
+    _queue.setLimits(limits);
+}
+
+TxQueueStats UdpFace::getTxQueueStats() const {
+    return _queue.getStats();
 }
 
 std::string UdpFace::getUnderlyingProtocol() const {
@@ -30,6 +40,15 @@ std::string UdpFace::getUnderlyingEndpoint() const {
     return ss.str();
 }
 
+void UdpFace::setMtu(size_t mtu) {
+    _fragmenter.setMtu(mtu);
+}
+
+void UdpFace::setAggregation(bool enabled, const boost::posix_time::time_duration &delay) {
+    _aggregation = enabled;
+    _aggregation_delay = delay;
+}
+
 void UdpFace::open(const InterestCallback &interest_callback, const DataCallback &data_callback, const ErrorCallback &error_callback) {
     _interest_callback = interest_callback;
     _data_callback = data_callback;
@@ -61,23 +80,29 @@ void UdpFace::read() {
 void UdpFace::readHandler(const boost::system::error_code &err, size_t bytes_transferred) {
     if(!err) {
         if (_remote_endpoint == _endpoint) {
-            try {
-                switch (_buffer[0]) {
-                    case 0x00:
-                        // special packet, just echoes it
-                        send("0");
-                        break;
-                    case 0x05:
-                        _interest_callback(shared_from_this(), ndn::Interest(ndn::Block((uint8_t *) _buffer, bytes_transferred)));
-                        break;
-                    case 0x06:
-                        _data_callback(shared_from_this(), ndn::Data(ndn::Block((uint8_t *) _buffer, bytes_transferred)));
-                        break;
-                    default:
-                        break;
+            const char *it = _buffer;
+            const char *packet;
+            size_t size;
+            // a datagram may carry several packets, and a fragment only yields a packet once the others arrived
+            while (_reassembler.unpack(it, _buffer + bytes_transferred, packet, size)) {
+                try {
+                    switch (packet[0]) {
+                        case 0x00:
+                            // special packet, just echoes it
+                            send("0");
+                            break;
+                        case 0x05:
+                            _interest_callback(shared_from_this(), ndn::Interest(ndn::Block((uint8_t *) packet, size)));
+                            break;
+                        case 0x06:
+                            _data_callback(shared_from_this(), ndn::Data(ndn::Block((uint8_t *) packet, size)));
+                            break;
+                        default:
+                            break;
+                    }
+                } catch (const std::exception &e) {
+                    std::cerr << e.what() << std::endl;
                 }
-            } catch (const std::exception &e) {
-                std::cerr << e.what() << std::endl;
             }
         }
         read();
@@ -88,23 +113,72 @@ void UdpFace::readHandler(const boost::system::error_code &err, size_t bytes_tra
 }
 
 void UdpFace::sendImpl(const ndn::Block &block) {
-    _queue.push_back(block);
-    if (_queue.size() == 1) {
+    bool is_data = block.type() == 0x06;
+    // the fragments of a packet larger than the MTU are queued in its place
+    if (!_fragmenter.fragment((const char *)block.wire(), block.size(), [this, is_data](const char *fragment, size_t size) {
+        _queue.push(ndn::Block((const uint8_t *)fragment, size), size, is_data);
+    })) {
+        _queue.push(block, block.size(), is_data);
+    }
+    updateCongestion(shared_from_this(), _queue.isCongested());
+    if (!_is_writing && !_queue.empty()) {
+        flush();
+    }
+}
+
+void UdpFace::flush() {
+    size_t queued_bytes = _queue.getStats().bytes;
+    if (_is_flush_pending) {
+        // a full datagram doesn't wait
+        if (queued_bytes >= _fragmenter.getDatagramSize()) {
+            _flush_timer.cancel();
+        }
+    } else if (_aggregation && _aggregation_delay > boost::posix_time::time_duration() && queued_bytes < _fragmenter.getDatagramSize()) {
+        _is_flush_pending = true;
+        _flush_timer.expires_from_now(_aggregation_delay);
+        _flush_timer.async_wait(_strand.wrap(boost::bind(&UdpFace::flushHandler, shared_from_this(), _1)));
+    } else {
+        write();
+    }
+}
+
+void UdpFace::flushHandler(const boost::system::error_code &err) {
+    _is_flush_pending = false;
+    if (!_is_writing && !_queue.empty()) {
         write();
     }
 }
 
 void UdpFace::write() {
-    const auto &block = _queue.front();
-    _socket.async_send_to(boost::asio::buffer(block.wire(), block.size()), _endpoint,
+    size_t datagram_size = _fragmenter.getDatagramSize();
+    size_t bytes = 0;
+    _write_buffers.clear();
+    _queue.forEach(_aggregation ? MAX_AGGREGATED_PACKETS : 1, [this, datagram_size, &bytes](const ndn::Block &block) {
+        bool can_aggregate = LpFragmenter::canAggregate((const char *)block.wire(), block.size());
+        if (!_write_buffers.empty() && (!can_aggregate || bytes + block.size() > datagram_size)) {
+            return false;
+        }
+        _write_buffers.emplace_back(block.wire(), block.size());
+        // a packet that can't be aggregated fills the datagram on its own
+        bytes += can_aggregate ? block.size() : datagram_size;
+        return true;
+    });
+    _is_writing = true;
+    _queue.markInFlight(_write_buffers.size());
+    _socket.async_send_to(_write_buffers, _endpoint,
                           _strand.wrap(boost::bind(&UdpFace::writeHandler, shared_from_this(), _1, _2)));
 }
 
 void UdpFace::writeHandler(const boost::system::error_code &err, size_t bytesTransferred) {
     if(!err) {
-        _queue.pop_front();
+        for (size_t i = 0; i < _write_buffers.size(); ++i) {
+            _queue.pop();
+        }
+        updateCongestion(shared_from_this(), _queue.isCongested());
         if (!_queue.empty()) {
             write();
+        } else {
+            _is_writing = false;
         }
     }
 }